@@ -38,6 +38,7 @@
 #include <numeric>
 #include <utility>
 #include <iterator>
+#include <typeinfo>
 #include <exception>
 #include <stdexcept>
 #include <algorithm>
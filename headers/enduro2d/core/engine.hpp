@@ -22,6 +22,7 @@ namespace e2d
         class debug_parameters;
         class window_parameters;
         class timer_parameters;
+        class vfs_parameters;
         class parameters;
     public:
         engine(int argc, char *argv[], const parameters& params);
@@ -116,6 +117,20 @@ namespace e2d
         u32 maximal_framerate_{1000u};
     };
 
+    //
+    // engine::vfs_parameters
+    //
+
+    class engine::vfs_parameters {
+    public:
+        // zero means a half of the hardware threads
+        vfs_parameters& io_threads(u32 value) noexcept;
+
+        u32 io_threads() const noexcept;
+    private:
+        u32 io_threads_{0u};
+    };
+
     //
     // engine::parameters
     //
@@ -132,6 +147,7 @@ namespace e2d
         parameters& debug_params(debug_parameters value) noexcept;
         parameters& window_params(window_parameters value) noexcept;
         parameters& timer_params(timer_parameters value) noexcept;
+        parameters& vfs_params(vfs_parameters value) noexcept;
 
         str& game_name() noexcept;
         str& company_name() noexcept;
@@ -140,6 +156,7 @@ namespace e2d
         debug_parameters& debug_params() noexcept;
         window_parameters& window_params() noexcept;
         timer_parameters& timer_params() noexcept;
+        vfs_parameters& vfs_params() noexcept;
 
         const str& game_name() const noexcept;
         const str& company_name() const noexcept;
@@ -148,6 +165,7 @@ namespace e2d
         const debug_parameters& debug_params() const noexcept;
         const window_parameters& window_params() const noexcept;
         const timer_parameters& timer_params() const noexcept;
+        const vfs_parameters& vfs_params() const noexcept;
     private:
         str game_name_{"noname"};
         str company_name_{"noname"};
@@ -156,6 +174,7 @@ namespace e2d
         debug_parameters debug_params_;
         window_parameters window_params_;
         timer_parameters timer_params_;
+        vfs_parameters vfs_params_;
     };
 }
 
@@ -911,6 +911,11 @@ namespace e2d
             bool pvrtc_compression_supported = false;
             bool pvrtc2_compression_supported = false;
         };
+
+        struct statistics {
+            u64 draw_calls = 0;
+            u64 drawn_indices = 0;
+        };
     public:
         render(debug& d, window& w);
         ~render() noexcept final;
@@ -976,6 +981,7 @@ namespace e2d
             const b2u& region);
 
         const device_caps& device_capabilities() const noexcept;
+        const statistics& render_statistics() const noexcept;
         bool is_pixel_supported(const pixel_declaration& decl) const noexcept;
         bool is_index_supported(const index_declaration& decl) const noexcept;
         bool is_vertex_supported(const vertex_declaration& decl) const noexcept;
@@ -23,6 +23,37 @@ namespace e2d
         }
     };
 
+    class vfs_load_cancelled_exception final : public exception {
+        const char* what() const noexcept final {
+            return "vfs load cancelled exception";
+        }
+    };
+
+    //
+    // file_view
+    //
+    // Reference-counted read-only file content. It is a region of
+    // a memory-mapped file or an owned buffer for sources that cannot map.
+    //
+
+    class file_view final {
+    public:
+        file_view() = default;
+        explicit file_view(buffer content);
+        explicit file_view(std::shared_ptr<const mapped_file> file) noexcept;
+        file_view(std::shared_ptr<const mapped_file> file, buffer_view content) noexcept;
+
+        const buffer_view& content() const noexcept;
+        const void* data() const noexcept;
+        std::size_t size() const noexcept;
+        bool empty() const noexcept;
+        bool mapped() const noexcept;
+    private:
+        std::shared_ptr<const void> owner_;
+        buffer_view content_;
+        bool mapped_{false};
+    };
+
     class vfs final : public module<vfs> {
     public:
         class file_source : private e2d::noncopyable {
@@ -33,20 +64,61 @@ namespace e2d
             virtual input_stream_uptr read(str_view path) const = 0;
             virtual output_stream_uptr write(str_view path, bool append) const = 0;
             virtual bool trace(str_view path, filesystem::trace_func func) const = 0;
+
+            // sources that cannot map return nothing and are read into a buffer
+            virtual std::optional<file_view> view(str_view path) const;
         };
         using file_source_uptr = std::unique_ptr<file_source>;
+
+        enum class priority : u8 {
+            critical,
+            normal,
+            prefetch
+        };
+
+        // requests are rejected with vfs_load_cancelled_exception
+        // if they are cancelled before an io thread picks them up
+        class cancellation final {
+        public:
+            cancellation();
+            void cancel() noexcept;
+            bool cancelled() const noexcept;
+        private:
+            friend class vfs;
+            explicit cancellation(std::nullptr_t) noexcept;
+        private:
+            std::shared_ptr<std::atomic<bool>> cancelled_;
+        };
+
+        struct io_statistics {
+            std::size_t threads{0u};
+            std::size_t queued{0u};
+            std::size_t active{0u};
+            std::size_t peak_queued{0u};
+            u64 completed{0u};
+            u64 failed{0u};
+            u64 cancelled{0u};
+            u64 bytes{0u};
+            f32 elapsed{0.f}; // seconds since the last reset
+            f32 throughput{0.f}; // bytes per second since the last reset
+        };
     public:
         vfs();
+        explicit vfs(std::size_t io_threads);
         ~vfs() noexcept final;
 
         stdex::jobber& worker() noexcept;
         const stdex::jobber& worker() const noexcept;
 
+        io_statistics io_stats() const noexcept;
+        void reset_io_stats() noexcept;
+
         template < typename T, typename... Args >
         bool register_scheme(str_view scheme, Args&&... args);
         bool register_scheme(str_view scheme, file_source_uptr source);
         bool unregister_scheme(str_view scheme) noexcept;
 
+        // fails if the alias makes a cycle or a chain deeper than 32 levels
         bool register_scheme_alias(str_view scheme, url alias);
         bool unregister_scheme_alias(str_view scheme) noexcept;
 
@@ -56,10 +128,31 @@ namespace e2d
         output_stream_uptr write(const url& url, bool append) const;
 
         std::optional<buffer> load(const url& url) const;
-        stdex::promise<buffer> load_async(const url& url) const;
+        stdex::promise<buffer> load_async(
+            const url& url,
+            priority priority = priority::normal) const;
+        stdex::promise<buffer> load_async(
+            const url& url,
+            priority priority,
+            const cancellation& token) const;
 
         std::optional<str> load_as_string(const url& url) const;
-        stdex::promise<str> load_as_string_async(const url& url) const;
+        stdex::promise<str> load_as_string_async(
+            const url& url,
+            priority priority = priority::normal) const;
+        stdex::promise<str> load_as_string_async(
+            const url& url,
+            priority priority,
+            const cancellation& token) const;
+
+        std::optional<file_view> load_view(const url& url) const;
+        stdex::promise<file_view> load_view_async(
+            const url& url,
+            priority priority = priority::normal) const;
+        stdex::promise<file_view> load_view_async(
+            const url& url,
+            priority priority,
+            const cancellation& token) const;
 
         template < typename Iter >
         bool extract(const url& url, Iter result_iter) const;
@@ -71,20 +164,94 @@ namespace e2d
         std::unique_ptr<state> state_;
     };
 
+    //
+    // archive_file_source
+    //
+    // Stored entries are seekable and read right from the archive stream.
+    // Deflated entries up to the cache capacity are inflated at once and kept
+    // in a LRU cache, bigger ones are inflated on the fly and cannot seek.
+    //
+
     class archive_file_source final : public vfs::file_source {
+    public:
+        struct cache_statistics {
+            std::size_t capacity{0u};
+            std::size_t size{0u};
+            std::size_t entries{0u};
+            u64 hits{0u};
+            u64 misses{0u};
+        };
     public:
         archive_file_source(input_stream_uptr stream);
+        archive_file_source(input_stream_uptr stream, std::size_t cache_capacity);
         ~archive_file_source() noexcept final;
         bool valid() const noexcept final;
         bool exists(str_view path) const final;
         input_stream_uptr read(str_view path) const final;
         output_stream_uptr write(str_view path, bool append) const final;
         bool trace(str_view path, filesystem::trace_func func) const final;
+
+        cache_statistics cache_stats() const noexcept;
     private:
         class state;
         std::unique_ptr<state> state_;
     };
 
+    //
+    // bundle_file_source
+    //
+    // Read-only source over a memory-mapped bundle written by bundle_builder.
+    // Stored entries are read and viewed right from the mapping,
+    // compressed entries are inflated into a new buffer on every read.
+    //
+
+    class bundle_file_source final : public vfs::file_source {
+    public:
+        bundle_file_source(mapped_file_uptr file);
+        ~bundle_file_source() noexcept final;
+        bool valid() const noexcept final;
+        bool exists(str_view path) const final;
+        input_stream_uptr read(str_view path) const final;
+        output_stream_uptr write(str_view path, bool append) const final;
+        bool trace(str_view path, filesystem::trace_func func) const final;
+
+        // only stored entries can be viewed, views keep the bundle mapped
+        std::optional<file_view> view(str_view path) const final;
+    private:
+        class state;
+        std::unique_ptr<state> state_;
+    };
+
+    //
+    // bundle_builder
+    //
+
+    class bundle_builder final {
+    public:
+        bundle_builder() = default;
+        ~bundle_builder() noexcept = default;
+
+        // replaces a file with the same path, compressed files
+        // are stored as is if compression does not make them smaller
+        bundle_builder& add_file(str path, buffer content, bool compress);
+
+        // adds all files of the directory by their relative paths
+        bool add_directory(str_view directory, bool compress);
+
+        bool write(output_stream& stream) const;
+        bool write(str_view path) const;
+
+        [[nodiscard]] bool empty() const noexcept;
+        [[nodiscard]] std::size_t size() const noexcept;
+    private:
+        struct file final {
+            str path;
+            buffer content;
+            bool compress{false};
+        };
+        vector<file> files_;
+    };
+
     class filesystem_file_source final : public vfs::file_source {
     public:
         filesystem_file_source();
@@ -94,6 +261,7 @@ namespace e2d
         input_stream_uptr read(str_view path) const final;
         output_stream_uptr write(str_view path, bool append) const final;
         bool trace(str_view path, filesystem::trace_func func) const final;
+        std::optional<file_view> view(str_view path) const final;
     };
 }
 
@@ -57,11 +57,13 @@
 #include "systems/layout_system.hpp"
 #include "systems/render_system.hpp"
 #include "systems/touch_system.hpp"
+#include "systems/widget_system.hpp"
 #include "systems/world_system.hpp"
 
 #include "address.hpp"
 #include "asset.hpp"
 #include "asset.inl"
+#include "asset_manifest.hpp"
 #include "editor.hpp"
 #include "factory.hpp"
 #include "factory.inl"
@@ -72,5 +74,8 @@
 #include "library.inl"
 #include "node.hpp"
 #include "node.inl"
+#include "prefab_pool.hpp"
 #include "starter.hpp"
+#include "system_scheduler.hpp"
+#include "transform_hierarchy.hpp"
 #include "world.hpp"
@@ -85,13 +85,16 @@ namespace e2d
     class asset_store;
     class asset_group;
     class asset_dependencies;
+    class asset_manifest;
 
     class editor;
     class inspector;
+    class prefab_pool;
     class starter;
     class world;
 
     class node;
+    class transform_hierarchy;
     class gobject;
     template < typename T >
     class gcomponent;
@@ -99,6 +102,100 @@ namespace e2d
     class const_gcomponent;
 }
 
+namespace e2d::ecsex
+{
+    //
+    // command_buffer
+    //
+    // Records structural changes while components are iterated and
+    // applies them in the recording order at a later sync point.
+    // Recording is thread-safe. Commands recorded during a playback,
+    // e.g. by disposers, are applied by the next playback.
+    //
+
+    class command_buffer final : private noncopyable {
+    public:
+        class deferred_entity final {
+        public:
+            deferred_entity() = default;
+            [[nodiscard]] bool valid() const noexcept;
+        private:
+            friend class command_buffer;
+            static constexpr u32 invalid_index = ~u32(0);
+            explicit deferred_entity(u32 index) noexcept;
+        private:
+            u32 index_{invalid_index};
+        };
+    public:
+        command_buffer();
+        ~command_buffer() noexcept;
+
+        deferred_entity create_entity();
+        deferred_entity create_entity(const ecs::prototype& proto);
+
+        void destroy_entity(const ecs::const_entity& e);
+        void destroy_entity(deferred_entity e);
+
+        template < typename T, typename... Args >
+        void assign_component(const ecs::const_entity& e, Args&&... args);
+        template < typename T, typename... Args >
+        void assign_component(deferred_entity e, Args&&... args);
+
+        template < typename T, typename... Args >
+        void ensure_component(const ecs::const_entity& e, Args&&... args);
+        template < typename T, typename... Args >
+        void ensure_component(deferred_entity e, Args&&... args);
+
+        template < typename T >
+        void remove_component(const ecs::const_entity& e);
+        template < typename T >
+        void remove_component(deferred_entity e);
+
+        // applies and forgets recorded commands, commands for
+        // destroyed entities are skipped
+        std::size_t playback(ecs::registry& owner);
+        void clear() noexcept;
+
+        [[nodiscard]] bool empty() const noexcept;
+        [[nodiscard]] std::size_t size() const noexcept;
+    private:
+        class command {
+        public:
+            virtual ~command() noexcept = default;
+            virtual void apply(ecs::entity& e) = 0;
+        };
+
+        template < typename T >
+        class assign_command;
+        template < typename T >
+        class ensure_command;
+        template < typename T >
+        class remove_command;
+        class create_command;
+        class destroy_command;
+
+        struct record final {
+            ecs::entity_id id{};
+            u32 created{deferred_entity::invalid_index};
+            command* cmd{nullptr};
+            create_command* create{nullptr};
+        };
+    private:
+        using arena_uptr = std::unique_ptr<linear_arena>;
+
+        // returns the index of a created entity for create_command
+        template < typename Command, typename... Args >
+        u32 record_(ecs::entity_id id, u32 created, Args&&... args);
+        static void destroy_commands_(vector<record>& records) noexcept;
+    private:
+        arena_uptr arena_;
+        arena_uptr spare_arena_;
+        vector<record> records_;
+        u32 created_count_{0u};
+        mutable std::mutex mutex_;
+    };
+}
+
 namespace e2d::ecsex
 {
     template < typename T, typename Disposer, typename... Opts >
@@ -107,10 +204,11 @@ namespace e2d::ecsex
         Disposer&& disposer,
         Opts&&... opts)
     {
-        static thread_local vector<ecs::entity> to_remove_components;
-        DEFER([](){ to_remove_components.clear(); });
+        frame_allocator::scope frame_scope;
+        linear_vector<ecs::entity> to_remove_components(
+            frame_scope.allocator<ecs::entity>());
 
-        owner.for_each_component<T>([](const ecs::entity& e, const T&){
+        owner.for_each_component<T>([&to_remove_components](const ecs::entity& e, const T&){
             to_remove_components.push_back(e);
         }, std::forward<Opts>(opts)...);
 
@@ -129,6 +227,514 @@ namespace e2d::ecsex
     }
 }
 
+namespace e2d::ecsex
+{
+    class change_set final {
+    public:
+        change_set() = default;
+
+        bool mark(ecs::entity_id id);
+        bool unmark(ecs::entity_id id) noexcept;
+        [[nodiscard]] bool is_marked(ecs::entity_id id) const noexcept;
+
+        [[nodiscard]] bool empty() const noexcept;
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        void clear() noexcept;
+
+        template < typename F >
+        void for_each(ecs::registry& owner, F&& f) const;
+    private:
+        struct slot final {
+            u32 generation{0u};
+            u32 position{0u};
+        };
+    private:
+        vector<ecs::entity_id> entities_;
+        vector<slot> slots_;
+        u32 generation_{1u};
+    };
+
+    template < typename... Ts, typename F >
+    void for_joined_changed_components(
+        const change_set& changes,
+        ecs::registry& owner,
+        F&& f)
+    {
+        changes.for_each(owner, [&f](ecs::entity& e){
+            if ( (... && e.exists_component<Ts>()) ) {
+                std::invoke(f, e, e.get_component<Ts>()...);
+            }
+        });
+    }
+}
+
+namespace e2d::ecsex
+{
+    //
+    // depth_sorted_entities
+    //
+    // Caches entities with a T component ordered by T::depth().
+    // The order is rebuilt only when a T component is added or removed
+    // or its depth changes, checking that is one pass without copies.
+    //
+
+    template < typename T >
+    class depth_sorted_entities final {
+    public:
+        depth_sorted_entities() = default;
+
+        // returns true if the order was rebuilt
+        bool update(const ecs::registry& owner);
+        void invalidate() noexcept;
+
+        template < typename... Ts, typename F, typename... Opts >
+        void for_each(ecs::registry& owner, F&& f, Opts&&... opts) const;
+        template < typename... Ts, typename F, typename... Opts >
+        void for_each(const ecs::registry& owner, F&& f, Opts&&... opts) const;
+
+        [[nodiscard]] bool empty() const noexcept;
+        [[nodiscard]] std::size_t size() const noexcept;
+    private:
+        struct entry final {
+            ecs::entity_id id{};
+            i32 depth{0};
+        };
+    private:
+        bool is_valid_(const ecs::registry& owner) const;
+    private:
+        vector<entry> entries_;
+        bool valid_{false};
+    };
+}
+
+namespace e2d::ecsex
+{
+    inline bool change_set::mark(ecs::entity_id id) {
+        const std::size_t index = ecs::detail::entity_id_index(id);
+
+        if ( index >= slots_.size() ) {
+            slots_.resize(math::max(index + 1u, slots_.size() * 2u));
+        }
+
+        slot& s = slots_[index];
+        if ( s.generation == generation_ ) {
+            if ( entities_[s.position] == id ) {
+                return false;
+            }
+            entities_[s.position] = id;
+            return true;
+        }
+
+        entities_.push_back(id);
+        s.generation = generation_;
+        s.position = math::numeric_cast<u32>(entities_.size() - 1u);
+        return true;
+    }
+
+    inline bool change_set::unmark(ecs::entity_id id) noexcept {
+        if ( !is_marked(id) ) {
+            return false;
+        }
+
+        slot& s = slots_[ecs::detail::entity_id_index(id)];
+        if ( s.position + 1u < entities_.size() ) {
+            entities_[s.position] = entities_.back();
+            slots_[ecs::detail::entity_id_index(entities_.back())].position = s.position;
+        }
+
+        entities_.pop_back();
+        s.generation = 0u;
+        return true;
+    }
+
+    inline bool change_set::is_marked(ecs::entity_id id) const noexcept {
+        const std::size_t index = ecs::detail::entity_id_index(id);
+        return index < slots_.size()
+            && slots_[index].generation == generation_
+            && entities_[slots_[index].position] == id;
+    }
+
+    inline bool change_set::empty() const noexcept {
+        return entities_.empty();
+    }
+
+    inline std::size_t change_set::size() const noexcept {
+        return entities_.size();
+    }
+
+    inline void change_set::clear() noexcept {
+        entities_.clear();
+        if ( ++generation_ == 0u ) {
+            std::fill(slots_.begin(), slots_.end(), slot());
+            generation_ = 1u;
+        }
+    }
+
+    template < typename F >
+    void change_set::for_each(ecs::registry& owner, F&& f) const {
+        for ( std::size_t i = 0; i < entities_.size(); ++i ) {
+            if ( ecs::entity e{owner, entities_[i]}; e.valid() ) {
+                std::invoke(f, e);
+            }
+        }
+    }
+}
+
+namespace e2d::ecsex
+{
+    template < typename T >
+    bool depth_sorted_entities<T>::update(const ecs::registry& owner) {
+        if ( valid_ && is_valid_(owner) ) {
+            return false;
+        }
+
+        valid_ = false;
+        entries_.clear();
+        owner.for_each_component<T>([this](const ecs::const_entity& e, const T& c){
+            entries_.push_back({e.id(), c.depth()});
+        });
+
+        std::stable_sort(entries_.begin(), entries_.end(), [](const entry& l, const entry& r) noexcept {
+            return l.depth < r.depth;
+        });
+
+        valid_ = true;
+        return true;
+    }
+
+    template < typename T >
+    void depth_sorted_entities<T>::invalidate() noexcept {
+        valid_ = false;
+    }
+
+    template < typename T >
+    template < typename... Ts, typename F, typename... Opts >
+    void depth_sorted_entities<T>::for_each(ecs::registry& owner, F&& f, Opts&&... opts) const {
+        for ( std::size_t i = 0, e = entries_.size(); i < e; ++i ) {
+            ecs::entity ent{owner, entries_[i].id};
+            if ( !ent.valid() ) {
+                continue;
+            }
+            if ( !ent.exists_component<T>() || !(... && ent.exists_component<Ts>()) ) {
+                continue;
+            }
+            if ( !(... && std::invoke(opts, ecs::const_entity(ent))) ) {
+                continue;
+            }
+            std::invoke(f, ent, ent.get_component<T>(), ent.get_component<Ts>()...);
+        }
+    }
+
+    template < typename T >
+    template < typename... Ts, typename F, typename... Opts >
+    void depth_sorted_entities<T>::for_each(const ecs::registry& owner, F&& f, Opts&&... opts) const {
+        for ( std::size_t i = 0, e = entries_.size(); i < e; ++i ) {
+            ecs::const_entity ent{owner, entries_[i].id};
+            if ( !ent.valid() ) {
+                continue;
+            }
+            if ( !ent.exists_component<T>() || !(... && ent.exists_component<Ts>()) ) {
+                continue;
+            }
+            if ( !(... && std::invoke(opts, ent)) ) {
+                continue;
+            }
+            std::invoke(f, ent, ent.get_component<T>(), ent.get_component<Ts>()...);
+        }
+    }
+
+    template < typename T >
+    bool depth_sorted_entities<T>::empty() const noexcept {
+        return entries_.empty();
+    }
+
+    template < typename T >
+    std::size_t depth_sorted_entities<T>::size() const noexcept {
+        return entries_.size();
+    }
+
+    template < typename T >
+    bool depth_sorted_entities<T>::is_valid_(const ecs::registry& owner) const {
+        // the same number of components and all cached entities
+        // still have them means the same set of entities
+        std::size_t count{0u};
+        owner.for_each_component<T>([&count](const ecs::const_entity&, const T&){
+            ++count;
+        });
+
+        if ( count != entries_.size() ) {
+            return false;
+        }
+
+        for ( const entry& en : entries_ ) {
+            const ecs::const_entity ent{owner, en.id};
+            const T* c = ent.valid()
+                ? ent.find_component<T>()
+                : nullptr;
+            if ( !c || c->depth() != en.depth ) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+namespace e2d::ecsex
+{
+    template < typename T >
+    class command_buffer::assign_command final : public command {
+    public:
+        template < typename... Args >
+        assign_command(Args&&... args)
+        : component_(std::forward<Args>(args)...) {}
+
+        void apply(ecs::entity& e) final {
+            e.assign_component<T>(std::move(component_));
+        }
+    private:
+        T component_;
+    };
+
+    template < typename T >
+    class command_buffer::ensure_command final : public command {
+    public:
+        template < typename... Args >
+        ensure_command(Args&&... args)
+        : component_(std::forward<Args>(args)...) {}
+
+        void apply(ecs::entity& e) final {
+            if ( !e.exists_component<T>() ) {
+                e.assign_component<T>(std::move(component_));
+            }
+        }
+    private:
+        T component_;
+    };
+
+    template < typename T >
+    class command_buffer::remove_command final : public command {
+    public:
+        void apply(ecs::entity& e) final {
+            e.remove_component<T>();
+        }
+    };
+
+    class command_buffer::create_command final : public command {
+    public:
+        create_command() = default;
+
+        create_command(const ecs::prototype& proto)
+        : proto_(proto) {}
+
+        void apply(ecs::entity& e) final {
+            E2D_UNUSED(e);
+        }
+
+        ecs::entity create(ecs::registry& owner) {
+            return proto_
+                ? owner.create_entity(*proto_)
+                : owner.create_entity();
+        }
+    private:
+        std::optional<ecs::prototype> proto_;
+    };
+
+    class command_buffer::destroy_command final : public command {
+    public:
+        void apply(ecs::entity& e) final {
+            e.destroy();
+        }
+    };
+
+    inline bool command_buffer::deferred_entity::valid() const noexcept {
+        return index_ != invalid_index;
+    }
+
+    inline command_buffer::deferred_entity::deferred_entity(u32 index) noexcept
+    : index_(index) {}
+
+    inline command_buffer::command_buffer()
+    : arena_(std::make_unique<linear_arena>(4u * 1024u)) {}
+
+    inline command_buffer::~command_buffer() noexcept {
+        destroy_commands_(records_);
+    }
+
+    inline command_buffer::deferred_entity command_buffer::create_entity() {
+        return deferred_entity(record_<create_command>(
+            ecs::entity_id{},
+            deferred_entity::invalid_index));
+    }
+
+    inline command_buffer::deferred_entity command_buffer::create_entity(const ecs::prototype& proto) {
+        return deferred_entity(record_<create_command>(
+            ecs::entity_id{},
+            deferred_entity::invalid_index,
+            proto));
+    }
+
+    inline void command_buffer::destroy_entity(const ecs::const_entity& e) {
+        record_<destroy_command>(e.id(), deferred_entity::invalid_index);
+    }
+
+    inline void command_buffer::destroy_entity(deferred_entity e) {
+        E2D_ASSERT(e.valid());
+        record_<destroy_command>(ecs::entity_id{}, e.index_);
+    }
+
+    template < typename T, typename... Args >
+    void command_buffer::assign_component(const ecs::const_entity& e, Args&&... args) {
+        record_<assign_command<T>>(e.id(), deferred_entity::invalid_index, std::forward<Args>(args)...);
+    }
+
+    template < typename T, typename... Args >
+    void command_buffer::assign_component(deferred_entity e, Args&&... args) {
+        E2D_ASSERT(e.valid());
+        record_<assign_command<T>>(ecs::entity_id{}, e.index_, std::forward<Args>(args)...);
+    }
+
+    template < typename T, typename... Args >
+    void command_buffer::ensure_component(const ecs::const_entity& e, Args&&... args) {
+        record_<ensure_command<T>>(e.id(), deferred_entity::invalid_index, std::forward<Args>(args)...);
+    }
+
+    template < typename T, typename... Args >
+    void command_buffer::ensure_component(deferred_entity e, Args&&... args) {
+        E2D_ASSERT(e.valid());
+        record_<ensure_command<T>>(ecs::entity_id{}, e.index_, std::forward<Args>(args)...);
+    }
+
+    template < typename T >
+    void command_buffer::remove_component(const ecs::const_entity& e) {
+        record_<remove_command<T>>(e.id(), deferred_entity::invalid_index);
+    }
+
+    template < typename T >
+    void command_buffer::remove_component(deferred_entity e) {
+        E2D_ASSERT(e.valid());
+        record_<remove_command<T>>(ecs::entity_id{}, e.index_);
+    }
+
+    inline std::size_t command_buffer::playback(ecs::registry& owner) {
+        // the records are applied unlocked, so commands can record new ones
+        vector<record> records;
+        arena_uptr arena;
+        u32 created_count{0u};
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            arena_uptr next_arena = spare_arena_
+                ? std::move(spare_arena_)
+                : std::make_unique<linear_arena>(4u * 1024u);
+            arena = std::move(arena_);
+            arena_ = std::move(next_arena);
+            records.swap(records_);
+            created_count = created_count_;
+            created_count_ = 0u;
+        }
+        DEFER([this, &records, &arena](){
+            destroy_commands_(records);
+            arena->rewind(linear_arena::marker());
+            std::lock_guard<std::mutex> guard(mutex_);
+            if ( !spare_arena_ ) {
+                spare_arena_ = std::move(arena);
+            }
+        });
+
+        frame_allocator::scope frame_scope;
+        linear_vector<ecs::entity_id> created(
+            frame_scope.allocator<ecs::entity_id>());
+        created.reserve(created_count);
+
+        for ( record& r : records ) {
+            if ( r.create ) {
+                created.push_back(r.create->create(owner).id());
+                continue;
+            }
+
+            if ( r.created != deferred_entity::invalid_index && r.created >= created.size() ) {
+                continue;
+            }
+
+            ecs::entity e{owner, r.created != deferred_entity::invalid_index
+                ? created[r.created]
+                : r.id};
+
+            if ( e.valid() ) {
+                r.cmd->apply(e);
+            }
+        }
+
+        return records.size();
+    }
+
+    inline void command_buffer::clear() noexcept {
+        vector<record> records;
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            records.swap(records_);
+            created_count_ = 0u;
+        }
+
+        // component destructors run unlocked and can record new commands
+        destroy_commands_(records);
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        if ( records_.empty() ) {
+            arena_->rewind(linear_arena::marker());
+        }
+    }
+
+    inline bool command_buffer::empty() const noexcept {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return records_.empty();
+    }
+
+    inline std::size_t command_buffer::size() const noexcept {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return records_.size();
+    }
+
+    template < typename Command, typename... Args >
+    u32 command_buffer::record_(ecs::entity_id id, u32 created, Args&&... args) {
+        std::lock_guard<std::mutex> guard(mutex_);
+
+        // grows geometrically, push_back below must not throw
+        if ( records_.size() == records_.capacity() ) {
+            records_.reserve(math::max(std::size_t(16u), records_.capacity() * 2u));
+        }
+
+        void* memory = arena_->allocate(sizeof(Command), alignof(Command));
+        ERROR_DEFER([this, memory](){
+            arena_->deallocate(memory, sizeof(Command));
+        });
+
+        record r;
+        r.id = id;
+        r.created = created;
+        r.cmd = new(memory) Command(std::forward<Args>(args)...);
+
+        if constexpr ( std::is_same_v<Command, create_command> ) {
+            r.create = static_cast<create_command*>(r.cmd);
+            records_.push_back(r);
+            return created_count_++;
+        } else {
+            records_.push_back(r);
+            return deferred_entity::invalid_index;
+        }
+    }
+
+    inline void command_buffer::destroy_commands_(vector<record>& records) noexcept {
+        for ( record& r : records ) {
+            if ( r.cmd ) {
+                r.cmd->~command();
+            }
+        }
+        records.clear();
+    }
+}
+
 namespace e2d::ecsex
 {
     template < typename... Ts, typename Iter, typename... Opts >
@@ -158,48 +764,34 @@ namespace e2d::ecsex
 {
     template < typename... Ts, typename F, typename... Opts >
     void for_extracted_components(ecs::registry& owner, F&& f, Opts&&... opts) {
-        //TODO(BlackMat): replace it to frame allocator
-        static thread_local vector<
-            std::tuple<ecs::entity, Ts...>> components;
-
-        const std::size_t begin_index = components.size();
-        DEFER([begin_index](){
-            components.erase(
-                components.begin() + begin_index,
-                components.end());
-        });
+        using component_tuple = std::tuple<ecs::entity, Ts...>;
+        frame_allocator::scope frame_scope;
+        linear_vector<component_tuple> components(
+            frame_scope.allocator<component_tuple>());
 
         extract_components<Ts...>(
             owner,
             std::back_inserter(components),
             std::forward<Opts>(opts)...);
 
-        const std::size_t end_index = components.size();
-        for ( std::size_t i = begin_index; i < end_index; ++i ) {
+        for ( std::size_t i = 0, e = components.size(); i < e; ++i ) {
             std::apply(f, components[i]);
         }
     }
 
     template < typename... Ts, typename F, typename... Opts >
     void for_extracted_components(const ecs::registry& owner, F&& f, Opts&&... opts) {
-        //TODO(BlackMat): replace it to frame allocator
-        static thread_local vector<
-            std::tuple<ecs::const_entity, Ts...>> components;
-
-        const std::size_t begin_index = components.size();
-        DEFER([begin_index](){
-            components.erase(
-                components.begin() + begin_index,
-                components.end());
-        });
+        using component_tuple = std::tuple<ecs::const_entity, Ts...>;
+        frame_allocator::scope frame_scope;
+        linear_vector<component_tuple> components(
+            frame_scope.allocator<component_tuple>());
 
         extract_components<Ts...>(
             owner,
             std::back_inserter(components),
             std::forward<Opts>(opts)...);
 
-        const std::size_t end_index = components.size();
-        for ( std::size_t i = begin_index; i < end_index; ++i ) {
+        for ( std::size_t i = 0, e = components.size(); i < e; ++i ) {
             std::apply(f, components[i]);
         }
     }
@@ -209,16 +801,10 @@ namespace e2d::ecsex
 {
     template < typename... Ts, typename Comp, typename F, typename... Opts >
     void for_extracted_sorted_components(ecs::registry& owner, Comp&& comp, F&& f, Opts&&... opts) {
-        //TODO(BlackMat): replace it to frame allocator
-        static thread_local vector<
-            std::tuple<ecs::entity, Ts...>> components;
-
-        const std::size_t begin_index = components.size();
-        DEFER([begin_index](){
-            components.erase(
-                components.begin() + begin_index,
-                components.end());
-        });
+        using component_tuple = std::tuple<ecs::entity, Ts...>;
+        frame_allocator::scope frame_scope;
+        linear_vector<component_tuple> components(
+            frame_scope.allocator<component_tuple>());
 
         extract_components<Ts...>(
             owner,
@@ -226,28 +812,21 @@ namespace e2d::ecsex
             std::forward<Opts>(opts)...);
 
         std::sort(
-            components.begin() + begin_index,
+            components.begin(),
             components.end(),
             comp);
 
-        const std::size_t end_index = components.size();
-        for ( std::size_t i = begin_index; i < end_index; ++i ) {
+        for ( std::size_t i = 0, e = components.size(); i < e; ++i ) {
             std::apply(f, components[i]);
         }
     }
 
     template < typename... Ts, typename Comp, typename F, typename... Opts >
     void for_extracted_sorted_components(const ecs::registry& owner, Comp&& comp, F&& f, Opts&&... opts) {
-        //TODO(BlackMat): replace it to frame allocator
-        static thread_local vector<
-            std::tuple<ecs::const_entity, Ts...>> components;
-
-        const std::size_t begin_index = components.size();
-        DEFER([begin_index](){
-            components.erase(
-                components.begin() + begin_index,
-                components.end());
-        });
+        using component_tuple = std::tuple<ecs::const_entity, Ts...>;
+        frame_allocator::scope frame_scope;
+        linear_vector<component_tuple> components(
+            frame_scope.allocator<component_tuple>());
 
         extract_components<Ts...>(
             owner,
@@ -255,12 +834,11 @@ namespace e2d::ecsex
             std::forward<Opts>(opts)...);
 
         std::sort(
-            components.begin() + begin_index,
+            components.begin(),
             components.end(),
             comp);
 
-        const std::size_t end_index = components.size();
-        for ( std::size_t i = begin_index; i < end_index; ++i ) {
+        for ( std::size_t i = 0, e = components.size(); i < e; ++i ) {
             std::apply(f, components[i]);
         }
     }
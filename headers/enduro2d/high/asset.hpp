@@ -22,6 +22,17 @@ namespace e2d
         }
     };
 
+    //
+    // asset_size
+    //
+
+    struct asset_size {
+        std::size_t cpu_bytes{0u};
+        std::size_t gpu_bytes{0u};
+
+        [[nodiscard]] std::size_t total_bytes() const noexcept;
+    };
+
     //
     // asset
     //
@@ -37,6 +48,9 @@ namespace e2d
         asset() = default;
         virtual ~asset() noexcept = default;
         virtual asset_ptr find_nested_asset(str_view nested_address) const noexcept = 0;
+
+        // memory held by the asset itself, without nested and dependent assets
+        virtual asset_size estimated_size() const noexcept = 0;
     };
 
     //
@@ -65,6 +79,9 @@ namespace e2d
         template < typename NestedAsset >
         typename NestedAsset::ptr find_nested_asset(str_view nested_address) const noexcept;
         asset_ptr find_nested_asset(str_view nested_address) const noexcept override;
+
+        // the asset object only, assets with large contents override it
+        asset_size estimated_size() const noexcept override;
     private:
         Content content_;
         nested_content nested_content_;
@@ -79,15 +96,38 @@ namespace e2d
         class asset_cache;
         using asset_cache_iptr = intrusive_ptr<asset_cache>;
 
+        struct unused_asset {
+            asset_cache* cache{nullptr};
+            str_hash address;
+            u64 last_use{0u};
+        };
+
         class asset_cache
             : private noncopyable
             , public ref_counter<asset_cache> {
+        public:
+            struct statistics {
+                str type_name;
+                std::size_t assets{0u};
+                std::size_t unused_assets{0u};
+                std::size_t cpu_bytes{0u};
+                std::size_t gpu_bytes{0u};
+                std::size_t hits{0u};
+                std::size_t misses{0u};
+                std::size_t evictions{0u};
+            };
         public:
             asset_cache() = default;
             virtual ~asset_cache() noexcept = default;
 
             virtual std::size_t asset_count() const noexcept = 0;
             virtual std::size_t unload_unused_assets() noexcept = 0;
+
+            virtual const asset_size& total_size() const noexcept = 0;
+            virtual statistics stats() const = 0;
+
+            virtual void collect_unused_assets(vector<unused_asset>& dst) const = 0;
+            virtual std::size_t evict_unused_asset(str_hash address) noexcept = 0;
         };
 
         template < typename Asset >
@@ -98,21 +138,54 @@ namespace e2d
             typed_asset_cache() = default;
             ~typed_asset_cache() noexcept final = default;
 
-            asset_ptr find(str_hash address) const noexcept;
-            void store(str_hash address, const asset_ptr& asset);
+            asset_ptr find(str_hash address, u64 use) const noexcept;
+            void store(str_hash address, const asset_ptr& asset, u64 use);
 
             std::size_t asset_count() const noexcept override;
             std::size_t unload_unused_assets() noexcept override;
+
+            const asset_size& total_size() const noexcept override;
+            statistics stats() const override;
+
+            void collect_unused_assets(vector<unused_asset>& dst) const override;
+            std::size_t evict_unused_asset(str_hash address) noexcept override;
+        private:
+            struct entry {
+                asset_ptr asset;
+                asset_size size;
+                mutable u64 last_use{0u};
+            };
+            void add_size_(const asset_size& size) noexcept;
+            void remove_size_(const asset_size& size) noexcept;
         private:
-            hash_map<str_hash, asset_ptr> assets_;
+            hash_map<str_hash, entry> assets_;
+            asset_size total_size_;
+            mutable std::size_t hits_{0u};
+            mutable std::size_t misses_{0u};
+            std::size_t evictions_{0u};
         };
     }
 
     //
     // asset_store
     //
+    // Without a memory budget unused assets stay until unload_unused_assets.
+    // With a budget, trim_to_memory_budget evicts the least recently used
+    // assets that nobody else references. Storing never evicts, because
+    // assets are stored from worker threads and evicted ones may release
+    // gpu resources. The store is not thread-safe, the library guards it
+    // with its own mutex.
+    //
 
     class asset_store final {
+    public:
+        struct statistics {
+            std::size_t budget{0u};
+            std::size_t cpu_bytes{0u};
+            std::size_t gpu_bytes{0u};
+            std::size_t evictions{0u};
+            vector<impl::asset_cache::statistics> caches;
+        };
     public:
         asset_store() = default;
         ~asset_store() noexcept = default;
@@ -128,7 +201,21 @@ namespace e2d
         std::size_t asset_count() const noexcept;
 
         std::size_t unload_unused_assets() noexcept;
+
+        // zero bytes means no budget, also trims to the new budget
+        asset_store& memory_budget(std::size_t bytes);
+        [[nodiscard]] std::size_t memory_budget() const noexcept;
+        [[nodiscard]] std::size_t memory_usage() const noexcept;
+
+        // returns the number of evicted assets,
+        // call it from the main thread only
+        std::size_t trim_to_memory_budget();
+
+        [[nodiscard]] statistics stats() const;
     private:
+        std::size_t budget_{0u};
+        std::size_t evictions_{0u};
+        mutable u64 last_use_{0u};
         hash_map<utils::type_family_id, impl::asset_cache_iptr> caches_;
     };
 }
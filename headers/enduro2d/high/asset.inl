@@ -10,6 +10,14 @@
 
 namespace e2d
 {
+    //
+    // asset_size
+    //
+
+    inline std::size_t asset_size::total_bytes() const noexcept {
+        return cpu_bytes + gpu_bytes;
+    }
+
     //
     // content_asset
     //
@@ -70,6 +78,11 @@ namespace e2d
             : iter->second->find_nested_asset(nested_asset);
     }
 
+    template < typename Asset, typename Content >
+    asset_size content_asset<Asset, Content>::estimated_size() const noexcept {
+        return {sizeof(Asset), 0u};
+    }
+
     //
     // typed_asset_cache
     //
@@ -77,16 +90,25 @@ namespace e2d
     namespace impl
     {
         template < typename T >
-        typename typed_asset_cache<T>::asset_ptr typed_asset_cache<T>::find(str_hash address) const noexcept {
+        typename typed_asset_cache<T>::asset_ptr typed_asset_cache<T>::find(str_hash address, u64 use) const noexcept {
             const auto iter = assets_.find(address);
-            return iter != assets_.end()
-                ? iter->second
-                : nullptr;
+            if ( iter == assets_.end() ) {
+                ++misses_;
+                return nullptr;
+            }
+            ++hits_;
+            iter->second.last_use = use;
+            return iter->second.asset;
         }
 
         template < typename T >
-        void typed_asset_cache<T>::store(str_hash address, const asset_ptr& asset) {
-            assets_[address] = asset;
+        void typed_asset_cache<T>::store(str_hash address, const asset_ptr& asset, u64 use) {
+            entry& e = assets_[address];
+            remove_size_(e.size);
+            e.asset = asset;
+            e.size = asset ? asset->estimated_size() : asset_size();
+            e.last_use = use;
+            add_size_(e.size);
         }
 
         template < typename T >
@@ -98,7 +120,8 @@ namespace e2d
         std::size_t typed_asset_cache<T>::unload_unused_assets() noexcept {
             std::size_t result = 0u;
             for ( auto iter = assets_.begin(); iter != assets_.end(); ) {
-                if ( !iter->second || 1 == iter->second->use_count() ) {
+                if ( !iter->second.asset || 1 == iter->second.asset->use_count() ) {
+                    remove_size_(iter->second.size);
                     iter = assets_.erase(iter);
                     ++result;
                 } else {
@@ -107,6 +130,68 @@ namespace e2d
             }
             return result;
         }
+
+        template < typename T >
+        const asset_size& typed_asset_cache<T>::total_size() const noexcept {
+            return total_size_;
+        }
+
+        template < typename T >
+        typename typed_asset_cache<T>::statistics typed_asset_cache<T>::stats() const {
+            statistics result;
+            result.type_name = T::type_name();
+            result.assets = assets_.size();
+            result.unused_assets = static_cast<std::size_t>(std::count_if(
+                assets_.begin(), assets_.end(),
+                [](const auto& p) noexcept {
+                    return !p.second.asset || 1 == p.second.asset->use_count();
+                }));
+            result.cpu_bytes = total_size_.cpu_bytes;
+            result.gpu_bytes = total_size_.gpu_bytes;
+            result.hits = hits_;
+            result.misses = misses_;
+            result.evictions = evictions_;
+            return result;
+        }
+
+        template < typename T >
+        void typed_asset_cache<T>::collect_unused_assets(vector<unused_asset>& dst) const {
+            for ( const auto& [address, e] : assets_ ) {
+                if ( !e.asset || 1 == e.asset->use_count() ) {
+                    dst.push_back({const_cast<typed_asset_cache<T>*>(this), address, e.last_use});
+                }
+            }
+        }
+
+        template < typename T >
+        std::size_t typed_asset_cache<T>::evict_unused_asset(str_hash address) noexcept {
+            const auto iter = assets_.find(address);
+            if ( iter == assets_.end() ) {
+                return 0u;
+            }
+            if ( iter->second.asset && 1 != iter->second.asset->use_count() ) {
+                return 0u;
+            }
+            const std::size_t result = iter->second.size.total_bytes();
+            remove_size_(iter->second.size);
+            assets_.erase(iter);
+            ++evictions_;
+            return result;
+        }
+
+        template < typename T >
+        void typed_asset_cache<T>::add_size_(const asset_size& size) noexcept {
+            total_size_.cpu_bytes += size.cpu_bytes;
+            total_size_.gpu_bytes += size.gpu_bytes;
+        }
+
+        template < typename T >
+        void typed_asset_cache<T>::remove_size_(const asset_size& size) noexcept {
+            E2D_ASSERT(total_size_.cpu_bytes >= size.cpu_bytes);
+            E2D_ASSERT(total_size_.gpu_bytes >= size.gpu_bytes);
+            total_size_.cpu_bytes -= size.cpu_bytes;
+            total_size_.gpu_bytes -= size.gpu_bytes;
+        }
     }
 
     //
@@ -125,7 +210,7 @@ namespace e2d
                 family,
                 make_intrusive<impl::typed_asset_cache<Asset>>()).first->second.get());
         }
-        cache->store(address, asset);
+        cache->store(address, asset, ++last_use_);
     }
 
     template < typename Asset >
@@ -135,7 +220,7 @@ namespace e2d
             ? static_cast<const impl::typed_asset_cache<Asset>*>(iter->second.get())
             : nullptr;
         return cache
-            ? cache->find(address)
+            ? cache->find(address, ++last_use_)
             : nullptr;
     }
 
@@ -166,4 +251,86 @@ namespace e2d
                     : acc;
             });
     }
+
+    inline asset_store& asset_store::memory_budget(std::size_t bytes) {
+        budget_ = bytes;
+        trim_to_memory_budget();
+        return *this;
+    }
+
+    inline std::size_t asset_store::memory_budget() const noexcept {
+        return budget_;
+    }
+
+    inline std::size_t asset_store::memory_usage() const noexcept {
+        return std::accumulate(
+            caches_.begin(), caches_.end(), std::size_t(0),
+            [](std::size_t acc, const auto& p){
+                return p.second
+                    ? acc + p.second->total_size().total_bytes()
+                    : acc;
+            });
+    }
+
+    inline std::size_t asset_store::trim_to_memory_budget() {
+        if ( !budget_ ) {
+            return 0u;
+        }
+
+        std::size_t usage = memory_usage();
+        std::size_t result = 0u;
+
+        // evicted owners can release their dependencies, so repeat until
+        // the budget is met or nothing else can be evicted
+        vector<impl::unused_asset> unused;
+        while ( usage > budget_ ) {
+            unused.clear();
+            for ( const auto& p : caches_ ) {
+                if ( p.second ) {
+                    p.second->collect_unused_assets(unused);
+                }
+            }
+
+            std::sort(unused.begin(), unused.end(), [](const auto& l, const auto& r) noexcept {
+                return l.last_use < r.last_use;
+            });
+
+            std::size_t evicted = 0u;
+            for ( const impl::unused_asset& u : unused ) {
+                if ( usage <= budget_ ) {
+                    break;
+                }
+                const std::size_t bytes = u.cache->evict_unused_asset(u.address);
+                usage -= math::min(usage, bytes);
+                ++evicted;
+            }
+
+            if ( !evicted ) {
+                break;
+            }
+
+            result += evicted;
+        }
+
+        evictions_ += result;
+        return result;
+    }
+
+    inline asset_store::statistics asset_store::stats() const {
+        statistics result;
+        result.budget = budget_;
+        result.evictions = evictions_;
+        result.caches.reserve(caches_.size());
+        for ( const auto& p : caches_ ) {
+            if ( p.second ) {
+                result.caches.push_back(p.second->stats());
+                result.cpu_bytes += result.caches.back().cpu_bytes;
+                result.gpu_bytes += result.caches.back().gpu_bytes;
+            }
+        }
+        std::sort(result.caches.begin(), result.caches.end(), [](const auto& l, const auto& r){
+            return l.type_name < r.type_name;
+        });
+        return result;
+    }
 }
@@ -0,0 +1,86 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include "_high.hpp"
+
+#include "asset.hpp"
+
+namespace e2d
+{
+    //
+    // asset_manifest
+    //
+    // Main assets with their types, file sizes and dependencies. Preloading
+    // starts all of them at once, so nested assets are already loading when
+    // their owners are parsed instead of being discovered one by one.
+    //
+
+    class asset_manifest final {
+    public:
+        struct entry {
+            str type;
+            str address;
+            u64 size{0u};
+            vfs::priority priority{vfs::priority::normal};
+            vector<str> dependencies;
+        };
+
+        struct progress {
+            u64 finished_bytes{0u}; // failed assets are finished too
+            u64 total_bytes{0u};
+            std::size_t loaded_assets{0u};
+            std::size_t failed_assets{0u};
+            std::size_t total_assets{0u};
+        };
+
+        // can be called from any loading thread
+        using progress_callback = std::function<void(const progress&)>;
+    public:
+        asset_manifest() = default;
+        ~asset_manifest() noexcept = default;
+
+        asset_manifest(asset_manifest&& other) noexcept = default;
+        asset_manifest& operator=(asset_manifest&& other) noexcept = default;
+
+        asset_manifest(const asset_manifest& other) = default;
+        asset_manifest& operator=(const asset_manifest& other) = default;
+
+        // replaces an entry with the same type and address
+        asset_manifest& add_entry(entry e);
+        asset_manifest& clear() noexcept;
+
+        [[nodiscard]] bool empty() const noexcept;
+        [[nodiscard]] std::size_t size() const noexcept;
+        [[nodiscard]] u64 total_size() const noexcept;
+        [[nodiscard]] const vector<entry>& entries() const noexcept;
+
+        // dependencies go first and inherit the most urgent priority of their
+        // owners, prefetch entries start when all the others are finished,
+        // the priority goes to the vfs reads of every entry source file,
+        // the group contains all successfully loaded assets
+        stdex::promise<asset_group> preload_async(
+            const library& library,
+            progress_callback callback = nullptr) const;
+
+        // types of the built-in assets, like "texture_asset"
+        static bool is_known_type(str_view type) noexcept;
+    private:
+        vector<entry> entries_;
+    };
+}
+
+namespace e2d::asset_manifests
+{
+    bool try_load_manifest(
+        asset_manifest& dst,
+        buffer_view src) noexcept;
+
+    bool try_save_manifest(
+        const asset_manifest& src,
+        buffer& dst) noexcept;
+}
@@ -15,6 +15,8 @@ namespace e2d
     class image_asset final : public content_asset<image_asset, image> {
     public:
         static const char* type_name() noexcept { return "image_asset"; }
-        static load_async_result load_async(const library& library, str_view address);
+        static load_async_result load_async(
+            const library& library, str_view address, vfs::priority priority);
+        asset_size estimated_size() const noexcept final;
     };
 }
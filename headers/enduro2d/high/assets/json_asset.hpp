@@ -16,6 +16,14 @@ namespace e2d
     class json_asset final : public content_asset<json_asset, json_uptr> {
     public:
         static const char* type_name() noexcept { return "json_asset"; }
-        static load_async_result load_async(const library& library, str_view address);
+        static load_async_result load_async(
+            const library& library, str_view address, vfs::priority priority);
+
+        // the asset type that e2d_cook validated the document for,
+        // loaders of this type may skip their schema validation
+        [[nodiscard]] const str& validated_for() const noexcept;
+        json_asset& validated_for(str asset_type) noexcept;
+    private:
+        str validated_for_;
     };
 }
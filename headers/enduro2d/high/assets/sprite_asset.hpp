@@ -16,6 +16,8 @@ namespace e2d
     class sprite_asset final : public content_asset<sprite_asset, sprite> {
     public:
         static const char* type_name() noexcept { return "sprite_asset"; }
-        static load_async_result load_async(const library& library, str_view address);
+        static const rapidjson::SchemaDocument& json_schema();
+        static load_async_result load_async(
+            const library& library, str_view address, vfs::priority priority);
     };
 }
@@ -17,8 +17,14 @@ namespace e2d::impl
 
         Collider& offset(const v2f& value) noexcept;
         [[nodiscard]] const v2f& offset() const noexcept;
+
+        // see versions::next()
+        [[nodiscard]] u32 version() const noexcept;
+    protected:
+        void mark_changed_() noexcept;
     private:
         v2f offset_ = v2f::zero();
+        u32 version_ = versions::next();
     };
 }
 
@@ -36,7 +42,7 @@ namespace e2d
     };
 
     class circle_collider final
-        : public impl::collider_base<rect_collider> {
+        : public impl::collider_base<circle_collider> {
     public:
         circle_collider() = default;
 
@@ -47,13 +53,14 @@ namespace e2d
     };
 
     class polygon_collider final
-        : public impl::collider_base<rect_collider> {
+        : public impl::collider_base<polygon_collider> {
     public:
         polygon_collider() = default;
 
         polygon_collider& points(vector<v2f> value) noexcept;
-        [[nodiscard]] vector<v2f>& points() noexcept;
         [[nodiscard]] const vector<v2f>& points() const noexcept;
+
+        polygon_collider& point(std::size_t index, const v2f& value) noexcept;
     private:
         vector<v2f> points_ = {
             {-0.5f, -0.5f},
@@ -143,6 +150,7 @@ namespace e2d::impl
     template < typename Collider >
     Collider& collider_base<Collider>::offset(const v2f& value) noexcept {
         offset_ = value;
+        mark_changed_();
         return static_cast<Collider&>(*this);
     }
 
@@ -150,12 +158,23 @@ namespace e2d::impl
     const v2f& collider_base<Collider>::offset() const noexcept {
         return offset_;
     }
+
+    template < typename Collider >
+    u32 collider_base<Collider>::version() const noexcept {
+        return version_;
+    }
+
+    template < typename Collider >
+    void collider_base<Collider>::mark_changed_() noexcept {
+        version_ = versions::next();
+    }
 }
 
 namespace e2d
 {
     inline rect_collider& rect_collider::size(const v2f& value) noexcept {
         size_ = math::maximized(v2f::unit(), value);
+        mark_changed_();
         return *this;
     }
 
@@ -168,6 +187,7 @@ namespace e2d
 {
     inline circle_collider& circle_collider::radius(f32 value) noexcept {
         radius_ = math::max(1.f, value);
+        mark_changed_();
         return *this;
     }
 
@@ -180,14 +200,18 @@ namespace e2d
 {
     inline polygon_collider& polygon_collider::points(vector<v2f> value) noexcept {
         points_ = std::move(value);
+        mark_changed_();
         return *this;
     }
 
-    inline vector<v2f>& polygon_collider::points() noexcept {
+    inline const vector<v2f>& polygon_collider::points() const noexcept {
         return points_;
     }
 
-    inline const vector<v2f>& polygon_collider::points() const noexcept {
-        return points_;
+    inline polygon_collider& polygon_collider::point(std::size_t index, const v2f& value) noexcept {
+        E2D_ASSERT(index < points_.size());
+        points_[index] = value;
+        mark_changed_();
+        return *this;
     }
 }
@@ -12,11 +12,27 @@
 
 namespace e2d
 {
+    //
+    // flipbook_player
+    //
+    // A player bound to a flipbook_system computes its time from the system
+    // clock, so time() is current every tick while the system touches the
+    // player only at its frame boundaries. Every setter bumps the player
+    // version and the gcomponent<flipbook_player> version, which tells the
+    // system to reschedule the player on its next update.
+    //
+
     class flipbook_player final {
     public:
-        flipbook_player() = default;
+        flipbook_player();
         flipbook_player(const flipbook_asset::ptr& flipbook);
 
+        flipbook_player(flipbook_player&& other) noexcept;
+        flipbook_player& operator=(flipbook_player&& other) noexcept;
+
+        flipbook_player(const flipbook_player& other);
+        flipbook_player& operator=(const flipbook_player& other);
+
         // data access
 
         flipbook_player& time(f32 value) noexcept;
@@ -40,6 +56,9 @@ namespace e2d
         flipbook_player& flipbook(const flipbook_asset::ptr& value) noexcept;
         [[nodiscard]] const flipbook_asset::ptr& flipbook() const noexcept;
 
+        // bumped by every setter, see versions::next()
+        [[nodiscard]] u32 version() const noexcept;
+
         // helpers
 
         flipbook_player& stop(f32 ntime) noexcept;
@@ -47,6 +66,14 @@ namespace e2d
 
         flipbook_player& play(f32 ntime) noexcept;
         flipbook_player& play(str_hash nsequence) noexcept;
+
+        // used by flipbook_system, the version is not bumped
+        flipbook_player& bind_clock(std::shared_ptr<const f64> clock, f32 loop_time) noexcept;
+        flipbook_player& finish(f32 loop_time) noexcept;
+    private:
+        f64 clock_time_() const noexcept;
+        void rebase_() noexcept;
+        void mark_changed_() noexcept;
     private:
         f32 time_{0.f};
         f32 speed_{1.f};
@@ -54,6 +81,10 @@ namespace e2d
         bool playing_{false};
         str_hash sequence_;
         flipbook_asset::ptr flipbook_;
+        std::shared_ptr<const f64> clock_;
+        f64 clock_base_{0.0};
+        f32 loop_time_{0.f};
+        u32 version_ = versions::next();
     };
 }
 
@@ -87,20 +118,96 @@ namespace e2d
 
 namespace e2d
 {
+    inline flipbook_player::flipbook_player() {
+        gcomponent<flipbook_player>::mark_changed();
+    }
+
     inline flipbook_player::flipbook_player(const flipbook_asset::ptr& flipbook)
-    : flipbook_(flipbook) {}
+    : flipbook_(flipbook) {
+        gcomponent<flipbook_player>::mark_changed();
+    }
+
+    // copies and moves are new or replaced components for the system,
+    // they keep the player version, so moves inside the registry
+    // storage do not restart the player
+
+    inline flipbook_player::flipbook_player(flipbook_player&& other) noexcept
+    : time_(other.time_)
+    , speed_(other.speed_)
+    , looped_(other.looped_)
+    , playing_(other.playing_)
+    , sequence_(other.sequence_)
+    , flipbook_(std::move(other.flipbook_))
+    , clock_(std::move(other.clock_))
+    , clock_base_(other.clock_base_)
+    , loop_time_(other.loop_time_)
+    , version_(other.version_) {
+        gcomponent<flipbook_player>::mark_changed();
+    }
+
+    inline flipbook_player& flipbook_player::operator=(flipbook_player&& other) noexcept {
+        if ( this != &other ) {
+            time_ = other.time_;
+            speed_ = other.speed_;
+            looped_ = other.looped_;
+            playing_ = other.playing_;
+            sequence_ = other.sequence_;
+            flipbook_ = std::move(other.flipbook_);
+            clock_ = std::move(other.clock_);
+            clock_base_ = other.clock_base_;
+            loop_time_ = other.loop_time_;
+            version_ = other.version_;
+            gcomponent<flipbook_player>::mark_changed();
+        }
+        return *this;
+    }
+
+    inline flipbook_player::flipbook_player(const flipbook_player& other)
+    : time_(other.time_)
+    , speed_(other.speed_)
+    , looped_(other.looped_)
+    , playing_(other.playing_)
+    , sequence_(other.sequence_)
+    , flipbook_(other.flipbook_)
+    , clock_(other.clock_)
+    , clock_base_(other.clock_base_)
+    , loop_time_(other.loop_time_)
+    , version_(other.version_) {
+        gcomponent<flipbook_player>::mark_changed();
+    }
+
+    inline flipbook_player& flipbook_player::operator=(const flipbook_player& other) {
+        if ( this != &other ) {
+            flipbook_player copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
 
     inline flipbook_player& flipbook_player::time(f32 value) noexcept {
         time_ = value;
+        clock_base_ = clock_time_();
+        mark_changed_();
         return *this;
     }
 
     inline f32 flipbook_player::time() const noexcept {
-        return time_;
+        if ( !playing_ || speed_ <= 0.f || !clock_ ) {
+            return time_;
+        }
+        const f32 time = time_ + math::numeric_cast<f32>(*clock_ - clock_base_) * speed_;
+        if ( loop_time_ > 0.f && time >= loop_time_ ) {
+            return looped_
+                ? math::mod(time, loop_time_)
+                : loop_time_;
+        }
+        return time;
     }
 
     inline flipbook_player& flipbook_player::speed(f32 value) noexcept {
+        rebase_();
         speed_ = value;
+        mark_changed_();
         return *this;
     }
 
@@ -109,7 +216,9 @@ namespace e2d
     }
 
     inline flipbook_player& flipbook_player::looped(bool value) noexcept {
+        rebase_();
         looped_ = value;
+        mark_changed_();
         return *this;
     }
 
@@ -118,8 +227,7 @@ namespace e2d
     }
 
     inline flipbook_player& flipbook_player::stopped(bool value) noexcept {
-        playing_ = !value;
-        return *this;
+        return playing(!value);
     }
 
     inline bool flipbook_player::stopped() const noexcept {
@@ -127,7 +235,9 @@ namespace e2d
     }
 
     inline flipbook_player& flipbook_player::playing(bool value) noexcept {
+        rebase_();
         playing_ = value;
+        mark_changed_();
         return *this;
     }
 
@@ -136,7 +246,9 @@ namespace e2d
     }
 
     inline flipbook_player& flipbook_player::sequence(str_hash value) noexcept {
+        rebase_();
         sequence_ = value;
+        mark_changed_();
         return *this;
     }
 
@@ -145,7 +257,9 @@ namespace e2d
     }
 
     inline flipbook_player& flipbook_player::flipbook(const flipbook_asset::ptr& value) noexcept {
+        rebase_();
         flipbook_ = value;
+        mark_changed_();
         return *this;
     }
 
@@ -153,6 +267,10 @@ namespace e2d
         return flipbook_;
     }
 
+    inline u32 flipbook_player::version() const noexcept {
+        return version_;
+    }
+
     inline flipbook_player& flipbook_player::stop(f32 ntime) noexcept {
         return time(ntime).stopped(true);
     }
@@ -168,4 +286,36 @@ namespace e2d
     inline flipbook_player& flipbook_player::play(str_hash nsequence) noexcept {
         return sequence(nsequence).play(0.f);
     }
+
+    inline flipbook_player& flipbook_player::bind_clock(
+        std::shared_ptr<const f64> clock,
+        f32 loop_time) noexcept
+    {
+        rebase_();
+        clock_ = std::move(clock);
+        clock_base_ = clock_time_();
+        loop_time_ = loop_time;
+        return *this;
+    }
+
+    inline flipbook_player& flipbook_player::finish(f32 loop_time) noexcept {
+        time_ = loop_time;
+        playing_ = false;
+        clock_base_ = clock_time_();
+        return *this;
+    }
+
+    inline f64 flipbook_player::clock_time_() const noexcept {
+        return clock_ ? *clock_ : 0.0;
+    }
+
+    inline void flipbook_player::rebase_() noexcept {
+        time_ = time();
+        clock_base_ = clock_time_();
+    }
+
+    inline void flipbook_player::mark_changed_() noexcept {
+        version_ = versions::next();
+        gcomponent<flipbook_player>::mark_changed();
+    }
 }
@@ -14,7 +14,14 @@ namespace e2d
 {
     class label final {
     public:
+        // the key of the world change set of dirty labels, new instances
+        // are always marked, so the prefab tag is kept only to load old prefabs
         class dirty final {};
+
+        struct glyph_quad {
+            b2f rect;
+            b2f texrect;
+        };
     public:
         ENUM_HPP_CLASS_DECL(haligns, u8,
             (left)
@@ -62,6 +69,10 @@ namespace e2d
 
         label& outline_color(const color32& value) noexcept;
         [[nodiscard]] const color32& outline_color() const noexcept;
+
+        label& glyph_quads(vector<glyph_quad> value) noexcept;
+        [[nodiscard]] vector<glyph_quad>& glyph_quads() noexcept;
+        [[nodiscard]] const vector<glyph_quad>& glyph_quads() const noexcept;
     private:
         str text_;
         font_asset::ptr font_;
@@ -74,6 +85,7 @@ namespace e2d
         f32 glyph_dilate_ = 0.f;
         f32 outline_width_ = 0.f;
         color32 outline_color_ = color32::white();
+        vector<glyph_quad> glyph_quads_;
     };
 
     ENUM_HPP_REGISTER_TRAITS(label::haligns)
@@ -226,10 +238,24 @@ namespace e2d
     inline const color32& label::outline_color() const noexcept {
         return outline_color_;
     }
+
+    inline label& label::glyph_quads(vector<glyph_quad> value) noexcept {
+        glyph_quads_ = std::move(value);
+        return *this;
+    }
+
+    inline vector<label::glyph_quad>& label::glyph_quads() noexcept {
+        return glyph_quads_;
+    }
+
+    inline const vector<label::glyph_quad>& label::glyph_quads() const noexcept {
+        return glyph_quads_;
+    }
 }
 
 namespace e2d::labels
 {
+    // marks the owner in the change set of its world
     gcomponent<label> mark_dirty(gcomponent<label> self);
     gcomponent<label> unmark_dirty(gcomponent<label> self);
     bool is_dirty(const const_gcomponent<label>& self) noexcept;
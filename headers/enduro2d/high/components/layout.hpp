@@ -12,6 +12,8 @@ namespace e2d
 {
     class layout final {
     public:
+        // the key of the world change set of dirty layouts, new instances
+        // are always marked, so the prefab tag is kept only to load old prefabs
         class dirty final {};
     public:
         ENUM_HPP_CLASS_DECL(directions, u8,
@@ -180,6 +182,7 @@ namespace e2d
 
 namespace e2d::layouts
 {
+    // marks the owner in the change set of its world
     gcomponent<layout> mark_dirty(gcomponent<layout> self);
     gcomponent<layout> unmark_dirty(gcomponent<layout> self);
     bool is_dirty(const const_gcomponent<layout>& self) noexcept;
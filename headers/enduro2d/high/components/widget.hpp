@@ -12,6 +12,8 @@ namespace e2d
 {
     class widget final {
     public:
+        // the key of the world change set of dirty widgets, new instances
+        // are always marked, so the prefab tag is kept only to load old prefabs
         class dirty final {};
     public:
         widget() = default;
@@ -106,6 +108,7 @@ namespace e2d
 
 namespace e2d::widgets
 {
+    // marks the owner in the change set of its world
     gcomponent<widget> mark_dirty(gcomponent<widget> self);
     gcomponent<widget> unmark_dirty(gcomponent<widget> self);
     bool is_dirty(const const_gcomponent<widget>& self) noexcept;
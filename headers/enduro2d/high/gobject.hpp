@@ -8,6 +8,20 @@
 
 #include "_high.hpp"
 
+namespace e2d::versions
+{
+    //
+    // change versions are stamped from one global counter shared
+    // by nodes and components, so a cache can remember `current()`
+    // after a pass and later ask anything whether it changed since.
+    // comparison is wrap-around safe, so 32 bits are enough.
+    //
+
+    u32 next() noexcept;
+    u32 current() noexcept;
+    bool changed_since(u32 version, u32 since) noexcept;
+}
+
 namespace e2d
 {
     class gobject final {
@@ -29,6 +43,8 @@ namespace e2d
             virtual bool invalided() const noexcept = 0;
             virtual ecs::entity raw_entity() noexcept = 0;
             virtual ecs::const_entity raw_entity() const noexcept = 0;
+            virtual world& owner_world() noexcept = 0;
+            virtual const world& owner_world() const noexcept = 0;
         };
         using state_iptr = intrusive_ptr<state>;
         const state_iptr& internal_state() const noexcept;
@@ -51,6 +67,9 @@ namespace e2d
         ecs::entity raw_entity() noexcept;
         ecs::const_entity raw_entity() const noexcept;
 
+        world& owner_world() noexcept;
+        const world& owner_world() const noexcept;
+
         template < typename T >
         ecs::component<T> raw_component() noexcept;
         template < typename T >
@@ -63,6 +82,17 @@ namespace e2d
     bool operator==(const gobject& l, const gobject& r) noexcept;
     bool operator!=(const gobject& l, const gobject& r) noexcept;
 
+    //
+    // gcomponent
+    //
+    // The per-type version is a cheap "something of this type changed"
+    // signal. assign, ensure and remove bump it, in-place edits through
+    // the mutable accessors or raw ecs access do not, so code that edits
+    // a component in place calls mark_changed() once after its edits.
+    // The change helpers like labels::change_text and the engine systems
+    // that write components follow this rule.
+    //
+
     template < typename T >
     class gcomponent final {
     public:
@@ -100,6 +130,11 @@ namespace e2d
 
         template < typename U >
         const_gcomponent<U> component() const noexcept;
+    public:
+        // see the contract above
+        static u32 version() noexcept;
+        static bool changed_since(u32 version) noexcept;
+        static void mark_changed() noexcept;
     private:
         gobject owner_;
     };
@@ -125,11 +160,37 @@ namespace e2d
 
         template < typename U >
         const_gcomponent<U> component() const noexcept;
+    public:
+        static u32 version() noexcept;
+        static bool changed_since(u32 version) noexcept;
     private:
         gobject owner_;
     };
 }
 
+namespace e2d::detail
+{
+    template < typename T >
+    inline std::atomic<u32> gcomponent_version{0u};
+
+    // installed by system_scheduler while a system runs with access checks
+    using component_access_hook_t = void(*)(
+        utils::type_family_id type_id,
+        const char* type_name,
+        bool write) noexcept;
+    extern thread_local component_access_hook_t component_access_hook;
+
+    template < typename T >
+    void check_component_access(bool write) noexcept {
+        if ( component_access_hook ) {
+            component_access_hook(
+                utils::type_family<T>::id(),
+                typeid(T).name(),
+                write);
+        }
+    }
+}
+
 namespace e2d
 {
     template < typename T >
@@ -176,6 +237,7 @@ namespace e2d
     template < typename... Args >
     T& gcomponent<T>::assign(Args&&... args) {
         E2D_ASSERT(owner_.valid());
+        mark_changed();
         return owner_.raw_component<T>().assign(std::forward<Args>(args)...);
     }
 
@@ -183,30 +245,36 @@ namespace e2d
     template < typename... Args >
     T& gcomponent<T>::ensure(Args&&... args) {
         E2D_ASSERT(owner_.valid());
+        mark_changed();
         return owner_.raw_component<T>().ensure(std::forward<Args>(args)...);
     }
 
     template < typename T >
     bool gcomponent<T>::remove() noexcept {
-        return owner_.valid()
-            ? owner_.raw_component<T>().remove()
-            : false;
+        if ( !owner_.valid() || !owner_.raw_component<T>().remove() ) {
+            return false;
+        }
+        mark_changed();
+        return true;
     }
 
     template < typename T >
     T& gcomponent<T>::get() {
         E2D_ASSERT(owner_.valid());
+        detail::check_component_access<T>(true);
         return owner_.raw_component<T>().get();
     }
 
     template < typename T >
     const T& gcomponent<T>::get() const {
         E2D_ASSERT(owner_.valid());
+        detail::check_component_access<T>(false);
         return owner_.raw_component<T>().get();
     }
 
     template < typename T >
     T* gcomponent<T>::find() noexcept {
+        detail::check_component_access<T>(true);
         return owner_.valid()
             ? owner_.raw_component<T>().find()
             : nullptr;
@@ -214,6 +282,7 @@ namespace e2d
 
     template < typename T >
     const T* gcomponent<T>::find() const noexcept {
+        detail::check_component_access<T>(false);
         return owner_.valid()
             ? owner_.raw_component<T>().find()
             : nullptr;
@@ -260,6 +329,22 @@ namespace e2d
     const_gcomponent<U> gcomponent<T>::component() const noexcept {
         return owner_.component<U>();
     }
+
+    template < typename T >
+    u32 gcomponent<T>::version() noexcept {
+        return detail::gcomponent_version<T>.load(std::memory_order_relaxed);
+    }
+
+    template < typename T >
+    bool gcomponent<T>::changed_since(u32 version) noexcept {
+        return versions::changed_since(gcomponent<T>::version(), version);
+    }
+
+    template < typename T >
+    void gcomponent<T>::mark_changed() noexcept {
+        detail::check_component_access<T>(true);
+        detail::gcomponent_version<T>.store(versions::next(), std::memory_order_relaxed);
+    }
 }
 
 namespace e2d
@@ -286,11 +371,13 @@ namespace e2d
     template < typename T >
     const T& const_gcomponent<T>::get() const {
         E2D_ASSERT(owner_.valid());
+        detail::check_component_access<T>(false);
         return owner_.raw_component<T>().get();
     }
 
     template < typename T >
     const T* const_gcomponent<T>::find() const noexcept {
+        detail::check_component_access<T>(false);
         return owner_.valid()
             ? owner_.raw_component<T>().find()
             : nullptr;
@@ -321,4 +408,14 @@ namespace e2d
     const_gcomponent<U> const_gcomponent<T>::component() const noexcept {
         return owner_.component<U>();
     }
+
+    template < typename T >
+    u32 const_gcomponent<T>::version() noexcept {
+        return gcomponent<T>::version();
+    }
+
+    template < typename T >
+    bool const_gcomponent<T>::changed_since(u32 version) noexcept {
+        return gcomponent<T>::changed_since(version);
+    }
 }
@@ -9,6 +9,7 @@
 #include "_high.hpp"
 
 #include "asset.hpp"
+#include "asset_manifest.hpp"
 #include "starter.hpp"
 
 namespace e2d
@@ -79,18 +80,46 @@ namespace e2d
         std::size_t unload_unused_assets() noexcept;
         std::size_t loading_asset_count() const noexcept;
 
+        // zero bytes means no budget, see asset_store,
+        // the starter trims the store at the end of every frame
+        library& memory_budget(std::size_t bytes);
+        [[nodiscard]] std::size_t memory_budget() const noexcept;
+        std::size_t trim_to_memory_budget();
+        [[nodiscard]] asset_store::statistics store_stats() const;
+
         template < typename Asset >
         typename Asset::load_result load_main_asset(str_view address) const;
 
+        // the priority goes to the vfs reads of the asset source file,
+        // an asset that is already loading keeps the priority of the first request
         template < typename Asset >
-        typename Asset::load_async_result load_main_asset_async(str_view address) const;
+        typename Asset::load_async_result load_main_asset_async(
+            str_view address,
+            vfs::priority priority = vfs::priority::normal) const;
 
         template < typename Asset, typename Nested = Asset >
         typename Nested::load_result load_asset(str_view address) const;
 
         template < typename Asset, typename Nested = Asset >
-        typename Nested::load_async_result load_asset_async(str_view address) const;
+        typename Nested::load_async_result load_asset_async(
+            str_view address,
+            vfs::priority priority = vfs::priority::normal) const;
+
+        // records requested main assets until the capture is stopped,
+        // new assets are added when they are loaded, after their dependencies,
+        // captured entries have no dependency edges and the normal priority:
+        // the library does not know which asset requested another one,
+        // e2d_cook manifests list the dependencies of typed json assets
+        void start_manifest_capture();
+        asset_manifest stop_manifest_capture();
+
+        // called by the loaders that read an asset source file, the size
+        // goes to the captured entries without opening the file again
+        void register_source_size(str_view address, std::size_t size) const;
     private:
+        template < typename Asset >
+        void capture_manifest_entry_(const str& main_address) const;
+
         template < typename Asset >
         vector<impl::loading_asset_iptr>::iterator
         find_loading_asset_iter_(str_hash address) const noexcept;
@@ -110,6 +139,10 @@ namespace e2d
         mutable asset_store store_;
         mutable std::recursive_mutex mutex_;
         mutable vector<impl::loading_asset_iptr> loading_assets_;
+    private:
+        bool capturing_{false};
+        mutable vector<asset_manifest::entry> captured_;
+        mutable hash_map<str_hash, u64> source_sizes_;
     };
 
     //
@@ -48,7 +48,9 @@ namespace e2d
     //
 
     inline library::library(starter::library_parameters params)
-    : params_(std::move(params)) {}
+    : params_(std::move(params)) {
+        store_.memory_budget(params_.memory_budget());
+    }
 
     inline library::~library() noexcept {
         cancelled_.store(true);
@@ -64,6 +66,7 @@ namespace e2d
     }
 
     inline std::size_t library::unload_unused_assets() noexcept {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
         return store_.unload_unused_assets();
     }
 
@@ -72,6 +75,27 @@ namespace e2d
         return loading_assets_.size();
     }
 
+    inline library& library::memory_budget(std::size_t bytes) {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
+        store_.memory_budget(bytes);
+        return *this;
+    }
+
+    inline std::size_t library::memory_budget() const noexcept {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
+        return store_.memory_budget();
+    }
+
+    inline std::size_t library::trim_to_memory_budget() {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
+        return store_.trim_to_memory_budget();
+    }
+
+    inline asset_store::statistics library::store_stats() const {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
+        return store_.stats();
+    }
+
     template < typename Asset >
     typename Asset::load_result library::load_main_asset(str_view address) const {
         auto p = load_main_asset_async<Asset>(address);
@@ -80,7 +104,10 @@ namespace e2d
     }
 
     template < typename Asset >
-    typename Asset::load_async_result library::load_main_asset_async(str_view address) const {
+    typename Asset::load_async_result library::load_main_asset_async(
+        str_view address,
+        vfs::priority priority) const
+    {
         const str main_address = address::parent(address);
         const str_hash main_address_hash = make_hash(main_address);
 
@@ -91,6 +118,7 @@ namespace e2d
         }
 
         if ( auto stored_asset = store_.find<Asset>(main_address_hash) ) {
+            capture_manifest_entry_<Asset>(main_address);
             return stdex::make_resolved_promise(std::move(stored_asset));
         }
 
@@ -98,14 +126,16 @@ namespace e2d
             return asset->promise();
         }
 
-        auto p = Asset::load_async(*this, main_address)
+        auto p = Asset::load_async(*this, main_address, priority)
         .then([
             this,
+            main_address,
             main_address_hash
         ](const typename Asset::load_result& new_asset){
             std::lock_guard<std::recursive_mutex> guard(mutex_);
             store_.store<Asset>(main_address_hash, new_asset);
             remove_loading_asset_<Asset>(main_address_hash);
+            capture_manifest_entry_<Asset>(main_address);
             return new_asset;
         }).except([
             this,
@@ -153,8 +183,11 @@ namespace e2d
     }
 
     template < typename Asset, typename Nested >
-    typename Nested::load_async_result library::load_asset_async(str_view address) const {
-        return load_main_asset_async<Asset>(address)
+    typename Nested::load_async_result library::load_asset_async(
+        str_view address,
+        vfs::priority priority) const
+    {
+        return load_main_asset_async<Asset>(address, priority)
         .then([
             address = str(address),
             nested_address = address::nested(address)
@@ -204,6 +237,52 @@ namespace e2d
         }
     }
 
+    inline void library::start_manifest_capture() {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
+        capturing_ = true;
+        captured_.clear();
+        source_sizes_.clear();
+    }
+
+    inline asset_manifest library::stop_manifest_capture() {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
+        capturing_ = false;
+
+        // the same file can be the source of several asset types,
+        // its size is counted once, by the first entry that captured it
+        asset_manifest manifest;
+        flat_set<str_hash> sized_addresses;
+        for ( asset_manifest::entry& e : captured_ ) {
+            const str_hash address_hash = make_hash(e.address);
+            if ( const auto iter = source_sizes_.find(address_hash);
+                iter != source_sizes_.end() && sized_addresses.insert(address_hash).second )
+            {
+                e.size = iter->second;
+            }
+            manifest.add_entry(std::move(e));
+        }
+        captured_.clear();
+        source_sizes_.clear();
+        return manifest;
+    }
+
+    inline void library::register_source_size(str_view address, std::size_t size) const {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
+        if ( capturing_ ) {
+            source_sizes_[make_hash(address)] = size;
+        }
+    }
+
+    template < typename Asset >
+    void library::capture_manifest_entry_(const str& main_address) const {
+        if ( capturing_ ) {
+            asset_manifest::entry e;
+            e.type = Asset::type_name();
+            e.address = main_address;
+            captured_.push_back(std::move(e));
+        }
+    }
+
     inline void library::wait_all_loading_assets_() noexcept {
         while ( true ) {
             std::unique_lock<std::recursive_mutex> lock(mutex_);
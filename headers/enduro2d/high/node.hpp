@@ -9,6 +9,7 @@
 #include "_high.hpp"
 
 #include "gobject.hpp"
+#include "transform_hierarchy.hpp"
 
 namespace e2d
 {
@@ -41,9 +42,34 @@ namespace e2d
         static node_iptr create(gobject owner, const node_iptr& parent);
         static node_iptr create(gobject owner, const node_iptr& parent, const t2f& transform);
 
+        // worlds create their nodes from their own pool, see world::node_allocator
+        static node_iptr create(
+            const std::shared_ptr<pool_allocator>& allocator,
+            gobject owner);
+
+        // a node bound to a transform storage keeps its world matrix there,
+        // children follow the storage of their parent, see world::flat_transforms
+        static node_iptr create(
+            const std::shared_ptr<pool_allocator>& allocator,
+            const std::shared_ptr<transform_hierarchy>& transforms,
+            gobject owner);
+
+        // every pooled node shares the ownership of its pool, other nodes
+        // come from a default pool, derived classes of another size use the heap
+        static std::shared_ptr<pool_allocator> create_allocator(std::size_t blocks_per_chunk);
+        static void* operator new(std::size_t size);
+        static void* operator new(std::size_t size, const std::shared_ptr<pool_allocator>& allocator);
+        static void operator delete(void* ptr, std::size_t size) noexcept;
+        static void operator delete(void* ptr, const std::shared_ptr<pool_allocator>& allocator) noexcept;
+
+        // statistics of the default pool
+        static pool_allocator::statistics allocation_stats() noexcept;
+
         void owner(gobject owner) noexcept;
         gobject owner() const noexcept;
 
+        const std::shared_ptr<transform_hierarchy>& transforms() const noexcept;
+
         void transform(const t2f& transform) noexcept;
         const t2f& transform() const noexcept;
 
@@ -56,8 +82,20 @@ namespace e2d
         void scale(const v2f& scale) noexcept;
         const v2f& scale() const noexcept;
 
-        const m4f& local_matrix() const noexcept;
-        const m4f& world_matrix() const noexcept;
+        const m3x2f& local_matrix() const noexcept;
+        const m3x2f& world_matrix() const noexcept;
+
+        // see versions::next()
+        u32 local_version() const noexcept;
+        u32 world_version() const noexcept;
+        u32 hierarchy_version() const noexcept;
+
+        bool local_changed_since(u32 version) const noexcept;
+        bool world_changed_since(u32 version) const noexcept;
+        bool hierarchy_changed_since(u32 version) const noexcept;
+
+        v2f local_to_world(const v2f& local) const noexcept;
+        v2f world_to_local(const v2f& world) const noexcept;
 
         v4f local_to_world(const v4f& local) const noexcept;
         v4f world_to_local(const v4f& world) const noexcept;
@@ -156,6 +194,9 @@ namespace e2d
         };
         void mark_dirty_local_matrix_() noexcept;
         void mark_dirty_world_matrix_() noexcept;
+        void mark_dirty_hierarchy_() noexcept;
+        void mark_dirty_parent_() noexcept;
+        void bind_transforms_(const std::shared_ptr<transform_hierarchy>& transforms) noexcept;
         void update_local_matrix_() const noexcept;
         void update_world_matrix_() const noexcept;
     private:
@@ -163,10 +204,15 @@ namespace e2d
         gobject owner_;
         node* parent_{nullptr};
         node_children children_;
+        std::shared_ptr<transform_hierarchy> transforms_;
+        transform_hierarchy::handle transforms_handle_{transform_hierarchy::invalid_handle};
     private:
         mutable u32 flags_{0u};
-        mutable m4f local_matrix_;
-        mutable m4f world_matrix_;
+        mutable m3x2f local_matrix_;
+        mutable m3x2f world_matrix_;
+        u32 local_version_{0u};
+        mutable u32 world_version_{0u};
+        u32 hierarchy_version_{0u};
     };
 }
 
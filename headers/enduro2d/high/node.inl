@@ -149,23 +149,16 @@ namespace e2d::nodes
         F&& f,
         const options& opts)
     {
-        //TODO(BlackMat): replace it to frame allocator
-        static thread_local vector<intrusive_ptr<Node>> parents;
-
-        const std::size_t begin_index = parents.size();
-        DEFER([begin_index](){
-            parents.erase(
-                parents.begin() + begin_index,
-                parents.end());
-        });
+        frame_allocator::scope frame_scope;
+        linear_vector<intrusive_ptr<Node>> parents(
+            frame_scope.allocator<intrusive_ptr<Node>>());
 
         extract_parents(
             root,
             std::back_inserter(parents),
             opts);
 
-        const std::size_t end_index = parents.size();
-        for ( std::size_t i = begin_index; i < end_index; ++i ) {
+        for ( std::size_t i = 0, e = parents.size(); i < e; ++i ) {
             if ( !impl::invoke_with_force_bool(f, parents[i]) ) {
                 return false;
             }
@@ -180,23 +173,16 @@ namespace e2d::nodes
         F&& f,
         const options& opts)
     {
-        //TODO(BlackMat): replace it to frame allocator
-        static thread_local vector<intrusive_ptr<Node>> children;
-
-        const std::size_t begin_index = children.size();
-        DEFER([begin_index](){
-            children.erase(
-                children.begin() + begin_index,
-                children.end());
-        });
+        frame_allocator::scope frame_scope;
+        linear_vector<intrusive_ptr<Node>> children(
+            frame_scope.allocator<intrusive_ptr<Node>>());
 
         extract_children(
             root,
             std::back_inserter(children),
             opts);
 
-        const std::size_t end_index = children.size();
-        for ( std::size_t i = begin_index; i < end_index; ++i ) {
+        for ( std::size_t i = 0, e = children.size(); i < e; ++i ) {
             if ( !impl::invoke_with_force_bool(f, children[i]) ) {
                 return false;
             }
@@ -249,23 +235,16 @@ namespace e2d::nodes
         F&& f,
         const options& opts)
     {
-        //TODO(BlackMat): replace it to frame allocator
-        static thread_local vector<gcomponent<Component>> components;
-
-        const std::size_t begin_index = components.size();
-        DEFER([begin_index](){
-            components.erase(
-                components.begin() + begin_index,
-                components.end());
-        });
+        frame_allocator::scope frame_scope;
+        linear_vector<gcomponent<Component>> components(
+            frame_scope.allocator<gcomponent<Component>>());
 
         extract_components_from_parents<Component>(
             root,
             std::back_inserter(components),
             opts);
 
-        const std::size_t end_index = components.size();
-        for ( std::size_t i = begin_index; i < end_index; ++i ) {
+        for ( std::size_t i = 0, e = components.size(); i < e; ++i ) {
             if ( !impl::invoke_with_force_bool(f, components[i]) ) {
                 return false;
             }
@@ -280,23 +259,16 @@ namespace e2d::nodes
         F&& f,
         const options& opts)
     {
-        //TODO(BlackMat): replace it to frame allocator
-        static thread_local vector<gcomponent<Component>> components;
-
-        const std::size_t begin_index = components.size();
-        DEFER([begin_index](){
-            components.erase(
-                components.begin() + begin_index,
-                components.end());
-        });
+        frame_allocator::scope frame_scope;
+        linear_vector<gcomponent<Component>> components(
+            frame_scope.allocator<gcomponent<Component>>());
 
         extract_components_from_children<Component>(
             root,
             std::back_inserter(components),
             opts);
 
-        const std::size_t end_index = components.size();
-        for ( std::size_t i = begin_index; i < end_index; ++i ) {
+        for ( std::size_t i = 0, e = components.size(); i < e; ++i ) {
             if ( !impl::invoke_with_force_bool(f, components[i]) ) {
                 return false;
             }
@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include "_high.hpp"
+
+#include "node.hpp"
+#include "gobject.hpp"
+
+#include "resources/prefab.hpp"
+
+namespace e2d
+{
+    //
+    // prefab_pool
+    //
+    // Keeps released instances of one prefab detached and disabled,
+    // acquire resets them to the prototype values and reuses their
+    // entities, components and nodes instead of instantiating again.
+    //
+
+    class prefab_pool final : private noncopyable {
+    public:
+        struct statistics {
+            std::size_t idle{0u};
+            std::size_t active{0u};
+            std::size_t created{0u};
+            std::size_t discarded{0u};
+            std::size_t acquires{0u};
+            std::size_t misses{0u};
+        };
+    public:
+        // the prefab must have a compiled plan
+        prefab_pool(world& world, const prefab& prefab);
+        ~prefab_pool() noexcept;
+
+        prefab_pool& warmup(std::size_t count);
+        prefab_pool& shrink(std::size_t max_idle) noexcept;
+
+        gobject acquire();
+        gobject acquire(const t2f& transform);
+
+        gobject acquire(const node_iptr& parent);
+        gobject acquire(const node_iptr& parent, const t2f& transform);
+
+        // instances with a changed hierarchy or not from this pool
+        // can't be reset and are destroyed instead
+        void release(gobject inst) noexcept;
+
+        [[nodiscard]] bool owns(const gobject& inst) const noexcept;
+        [[nodiscard]] const prefab& source() const noexcept;
+        [[nodiscard]] const statistics& stats() const noexcept;
+    private:
+        gobject create_();
+        bool collect_nodes_(const gobject& root, linear_vector<node_iptr>& nodes) const;
+        bool park_(gobject& root) noexcept;
+        void unpark_(gobject& root);
+    private:
+        world& world_;
+        prefab prefab_;
+        vector<u32> child_counts_;
+        vector<u8> disabled_by_prototype_;
+        vector<gobject> idle_;
+        hash_set<const gobject::state*> active_;
+        statistics stats_;
+    };
+}
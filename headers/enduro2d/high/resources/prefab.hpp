@@ -10,6 +10,9 @@
 
 namespace e2d
 {
+    class prefab_plan;
+    using prefab_plan_ptr = std::shared_ptr<const prefab_plan>;
+
     class prefab final {
     public:
         prefab() = default;
@@ -44,13 +47,42 @@ namespace e2d
 
         ecs::prototype& prototype() noexcept;
         const ecs::prototype& prototype() const noexcept;
+
+        // any mutable access to children or prototype drops the plan
+        prefab& compile_plan();
+        const prefab_plan_ptr& plan() const noexcept;
     private:
         str uuid_;
         vector<prefab> children_;
         ecs::prototype prototype_;
+        prefab_plan_ptr plan_;
     };
 
     void swap(prefab& l, prefab& r) noexcept;
     bool operator==(const prefab& l, const prefab& r) = delete;
     bool operator!=(const prefab& l, const prefab& r) = delete;
 }
+
+namespace e2d
+{
+    //
+    // prefab_plan
+    //
+    // Flat pre-order copy of a prefab hierarchy, parents always
+    // precede their children, so instantiation is one linear pass.
+    //
+
+    class prefab_plan final {
+    public:
+        static constexpr u32 no_parent = ~u32(0);
+    public:
+        explicit prefab_plan(const prefab& root);
+
+        [[nodiscard]] std::size_t size() const noexcept;
+        [[nodiscard]] const ecs::prototype& prototype(std::size_t index) const noexcept;
+        [[nodiscard]] u32 parent(std::size_t index) const noexcept;
+    private:
+        vector<ecs::prototype> prototypes_;
+        vector<u32> parents_;
+    };
+}
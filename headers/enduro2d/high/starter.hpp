@@ -49,9 +49,13 @@ namespace e2d
     class starter::library_parameters {
     public:
         library_parameters& root(url value) noexcept;
+        library_parameters& memory_budget(std::size_t value) noexcept;
+
         const url& root() const noexcept;
+        std::size_t memory_budget() const noexcept;
     private:
         url root_{"resources://bin/library"};
+        std::size_t memory_budget_{0u};
     };
 
     //
@@ -0,0 +1,223 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include "_high.hpp"
+
+namespace e2d
+{
+    //
+    // system_access
+    //
+
+    class system_access final {
+    public:
+        system_access() = default;
+
+        template < typename... Ts >
+        system_access& reads();
+
+        template < typename... Ts >
+        system_access& writes();
+
+        // systems of a lower phase finish before a higher phase starts
+        system_access& phase(i32 value) noexcept;
+
+        // pinned to the thread that processes the event
+        system_access& main_thread(bool value) noexcept;
+
+        // creates or destroys entities or adds or removes components,
+        // runs alone, world change sets are declared by their Tag type
+        system_access& exclusive(bool value) noexcept;
+
+        [[nodiscard]] i32 phase() const noexcept;
+        [[nodiscard]] bool main_thread() const noexcept;
+        [[nodiscard]] bool exclusive() const noexcept;
+
+        [[nodiscard]] bool can_read(utils::type_family_id type_id) const noexcept;
+        [[nodiscard]] bool can_write(utils::type_family_id type_id) const noexcept;
+        [[nodiscard]] bool conflicts_with(const system_access& other) const noexcept;
+    private:
+        void add_read_(utils::type_family_id type_id);
+        void add_write_(utils::type_family_id type_id);
+    private:
+        vector<utils::type_family_id> reads_;
+        vector<utils::type_family_id> writes_;
+        i32 phase_{0};
+        bool main_thread_{false};
+        bool exclusive_{false};
+    };
+}
+
+namespace e2d
+{
+    //
+    // system_scheduler
+    //
+    // Runs the systems of one event as a dependency graph: two systems
+    // are ordered only if they are in different phases or their declared
+    // accesses conflict, the rest run concurrently on the scheduler's own
+    // worker threads, so long deferrer jobs like asset loading never delay
+    // a frame. The processing thread runs only `main_thread` systems meanwhile.
+    //
+
+    class system_scheduler final : private noncopyable {
+    public:
+        struct system_timing {
+            str name;
+            u64 runs{0u};
+            f32 last_ms{0.f};
+            f32 average_ms{0.f};
+            f32 max_ms{0.f};
+        };
+    public:
+        system_scheduler();
+        ~system_scheduler() noexcept;
+
+        // System must have `process(ecs::registry&, const Event&)`
+        template < typename Event, typename System, typename... Args >
+        system_scheduler& add_system(str name, system_access access, Args&&... args);
+
+        template < typename Event >
+        void process_event(ecs::registry& owner, const Event& event);
+
+        // run every system serially in dependency order
+        system_scheduler& parallel(bool value) noexcept;
+        [[nodiscard]] bool parallel() const noexcept;
+
+        // the worker threads are started by the first parallel event,
+        // zero means one less than the hardware threads
+        system_scheduler& worker_threads(std::size_t value);
+        [[nodiscard]] std::size_t worker_threads() const noexcept;
+
+        // the worker threads for batched work between events, started on demand
+        stdex::jobber& worker();
+
+        // report gcomponent accesses missing from system_access,
+        // enabled by default in debug builds
+        system_scheduler& check_access(bool value) noexcept;
+        [[nodiscard]] bool check_access() const noexcept;
+        [[nodiscard]] std::size_t access_violations() const noexcept;
+
+        [[nodiscard]] vector<system_timing> timings() const;
+        [[nodiscard]] str timing_report() const;
+    private:
+        class system_base {
+        public:
+            system_base(str name, system_access access);
+            virtual ~system_base() noexcept;
+            virtual void process(ecs::registry& owner, const void* event) = 0;
+        public:
+            str name;
+            system_access access;
+            system_timing timing;
+        };
+
+        template < typename Event, typename System >
+        class system_impl final : public system_base {
+        public:
+            template < typename... Args >
+            system_impl(str name, system_access access, Args&&... args);
+            void process(ecs::registry& owner, const void* event) final;
+        private:
+            System system_;
+        };
+
+        class event_group;
+        using event_group_uptr = std::unique_ptr<event_group>;
+    private:
+        void add_system_(
+            utils::type_family_id event_id,
+            std::unique_ptr<system_base> system);
+
+        void process_event_(
+            utils::type_family_id event_id,
+            ecs::registry& owner,
+            const void* event);
+    private:
+        vector<event_group_uptr> groups_;
+        std::unique_ptr<stdex::jobber> worker_;
+        std::size_t worker_threads_{0u};
+        std::atomic<std::size_t> access_violations_{0u};
+        bool parallel_{true};
+        bool check_access_{E2D_BUILD_MODE == E2D_BUILD_MODE_DEBUG};
+    };
+}
+
+namespace e2d
+{
+    //
+    // scheduled_systems
+    //
+    // ecs system that hands its event over to the scheduler
+    //
+
+    template < typename Event >
+    class scheduled_systems final : public ecs::system<Event> {
+    public:
+        scheduled_systems(system_scheduler& scheduler)
+        : scheduler_(scheduler) {}
+
+        void process(ecs::registry& owner, const Event& event) override {
+            scheduler_.process_event(owner, event);
+        }
+    private:
+        system_scheduler& scheduler_;
+    };
+}
+
+namespace e2d
+{
+    template < typename... Ts >
+    system_access& system_access::reads() {
+        (add_read_(utils::type_family<Ts>::id()), ...);
+        return *this;
+    }
+
+    template < typename... Ts >
+    system_access& system_access::writes() {
+        (add_write_(utils::type_family<Ts>::id()), ...);
+        return *this;
+    }
+
+    template < typename Event, typename System >
+    template < typename... Args >
+    system_scheduler::system_impl<Event, System>::system_impl(
+        str name,
+        system_access access,
+        Args&&... args)
+    : system_base(std::move(name), std::move(access))
+    , system_(std::forward<Args>(args)...) {}
+
+    template < typename Event, typename System >
+    void system_scheduler::system_impl<Event, System>::process(
+        ecs::registry& owner,
+        const void* event)
+    {
+        system_.process(owner, *static_cast<const Event*>(event));
+    }
+
+    template < typename Event, typename System, typename... Args >
+    system_scheduler& system_scheduler::add_system(
+        str name,
+        system_access access,
+        Args&&... args)
+    {
+        add_system_(
+            utils::type_family<Event>::id(),
+            std::make_unique<system_impl<Event, System>>(
+                std::move(name),
+                std::move(access),
+                std::forward<Args>(args)...));
+        return *this;
+    }
+
+    template < typename Event >
+    void system_scheduler::process_event(ecs::registry& owner, const Event& event) {
+        process_event_(utils::type_family<Event>::id(), owner, &event);
+    }
+}
@@ -12,6 +12,9 @@ namespace e2d
 {
     class layout_system final
         : public ecs::system<ecs::after<systems::update_event>> {
+    public:
+        // the yoga state of widgets, declared for the scheduler access
+        struct yogo_node;
     public:
         layout_system();
         ~layout_system() noexcept final;
@@ -11,11 +11,17 @@
 namespace e2d
 {
     class world_system final
-        : public ecs::system<ecs::after<systems::frame_finalize_event>> {
+        : public ecs::system<
+            ecs::before<systems::frame_render_event>,
+            ecs::after<systems::frame_finalize_event>> {
     public:
         world_system();
         ~world_system() noexcept;
 
+        void process(
+            ecs::registry& owner,
+            const ecs::before<systems::frame_render_event>& trigger) override;
+
         void process(
             ecs::registry& owner,
             const ecs::after<systems::frame_finalize_event>& trigger) override;
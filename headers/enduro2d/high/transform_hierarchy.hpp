@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include "_high.hpp"
+
+namespace e2d
+{
+    //
+    // transform_hierarchy
+    //
+    // Flat transform storage of bound nodes: transforms, parent slots and
+    // world matrices live in contiguous arrays ordered by depth, so every
+    // parent precedes its children and each depth level is a contiguous
+    // range. Writes only mark their slot, the next read of a world matrix
+    // or `update` refreshes every dirty slot in one linear pass, which
+    // `update(jobber&)` can split across worker threads. Reading a matrix
+    // between writes refreshes the whole storage, so write first, read after.
+    //
+
+    class transform_hierarchy final : private noncopyable {
+    public:
+        using handle = u32;
+        static constexpr handle invalid_handle = ~handle(0);
+    public:
+        transform_hierarchy() = default;
+        ~transform_hierarchy() noexcept = default;
+
+        handle create(const t2f& transform = t2f::identity());
+        handle create(handle parent, const t2f& transform = t2f::identity());
+
+        void destroy(handle h) noexcept;
+        [[nodiscard]] bool valid(handle h) const noexcept;
+
+        // keeps the old parent if the new one is a child of the transform
+        void parent(handle h, handle parent) noexcept;
+        [[nodiscard]] handle parent(handle h) const noexcept;
+
+        void transform(handle h, const t2f& transform) noexcept;
+        [[nodiscard]] const t2f& transform(handle h) const noexcept;
+
+        // valid until the storage changes, see versions::next()
+        [[nodiscard]] const m3x2f& world_matrix(handle h);
+        [[nodiscard]] u32 world_version(handle h);
+
+        void update();
+        void update(stdex::jobber& worker, std::size_t min_chunk_size = 4096u);
+
+        [[nodiscard]] bool empty() const noexcept;
+        [[nodiscard]] std::size_t size() const noexcept;
+    private:
+        void mark_dirty_(u32 slot) noexcept;
+        void reorder_();
+        void update_range_(std::size_t begin, std::size_t end, u32 version) noexcept;
+    private:
+        static constexpr u32 invalid_slot = ~u32(0);
+
+        // per slot, ordered by depth
+        vector<u32> parents_;
+        vector<u32> depths_;
+        vector<t2f> transforms_;
+        vector<m3x2f> world_matrices_;
+        vector<u32> world_versions_;
+        vector<u8> dirty_;
+        vector<handle> handles_;
+
+        // per handle
+        vector<u32> slots_;
+        vector<handle> free_handles_;
+
+        // first slot of each depth level plus the end slot
+        vector<u32> levels_;
+
+        u32 first_dirty_slot_{invalid_slot};
+        bool order_dirty_{false};
+
+        // concurrent readers refresh the storage only once
+        std::mutex update_mutex_;
+        std::atomic<bool> needs_update_{false};
+    };
+}
@@ -10,14 +10,49 @@
 
 #include "node.hpp"
 #include "gobject.hpp"
+#include "prefab_pool.hpp"
+#include "system_scheduler.hpp"
 
 #include "resources/prefab.hpp"
 
 namespace e2d
 {
+    //
+    // bad_world_operation
+    //
+
+    class bad_world_operation final : public exception {
+    public:
+        const char* what() const noexcept final {
+            return "bad world operation";
+        }
+    };
+
+    //
+    // instantiate_cancelled_exception
+    //
+
+    class instantiate_cancelled_exception : public exception {
+        const char* what() const noexcept override {
+            return "instantiate cancelled exception";
+        }
+    };
+
+    //
+    // world
+    //
+
     class world final : public module<world> {
     public:
-        world() = default;
+        struct async_statistics {
+            std::size_t pending_instances{0u};
+            std::size_t pending_nodes{0u};
+            std::size_t finished_instances{0u};
+            std::size_t last_step_nodes{0u};
+            u64 last_step_us{0u};
+        };
+    public:
+        world();
         ~world() noexcept final;
 
         ecs::registry& registry() noexcept;
@@ -37,8 +72,98 @@ namespace e2d
 
         void destroy_instance(gobject inst) noexcept;
         void finalize_instances() noexcept;
+
+        // builds the instance a few nodes per frame, keeping them disabled,
+        // and resolves the promise after attaching the root to the parent
+        stdex::promise<gobject> instantiate_async(const prefab& prefab);
+        stdex::promise<gobject> instantiate_async(const prefab& prefab, const node_iptr& parent);
+        stdex::promise<gobject> instantiate_async(const prefab& prefab, const node_iptr& parent, u64 budget_us);
+
+        // shared pool of the prefab plan, throws bad_world_operation
+        // if the prefab has no compiled plan
+        prefab_pool& pool(const prefab& prefab);
+        void clear_pools() noexcept;
+
+        // one frame of asynchronous instantiation, called by world_system
+        void process_async_instances();
+
+        // default microseconds per frame for instantiate_async
+        world& async_budget_us(u64 value) noexcept;
+        [[nodiscard]] u64 async_budget_us() const noexcept;
+        [[nodiscard]] async_statistics async_stats() const noexcept;
+
+        system_scheduler& scheduler() noexcept;
+        const system_scheduler& scheduler() const noexcept;
+
+        // played back by world_system at the end of the frame
+        ecsex::command_buffer& commands() noexcept;
+        const ecsex::command_buffer& commands() const noexcept;
+
+        // arena of gobject states, the states share its ownership,
+        // so gobjects held past the world are still released safely
+        const std::shared_ptr<pool_allocator>& state_allocator() const noexcept;
+
+        // arena of instance nodes, shared the same way
+        const std::shared_ptr<pool_allocator>& node_allocator() const noexcept;
+
+        // new instance nodes keep their transforms in one flat storage,
+        // refreshed by world_system before rendering, see transform_hierarchy,
+        // nodes created before keep their storage, null when disabled
+        world& flat_transforms(bool value);
+        [[nodiscard]] bool flat_transforms() const noexcept;
+        const std::shared_ptr<transform_hierarchy>& transforms() const noexcept;
+
+        // entities marked by the change helpers and systems, cleared by
+        // the system that owns the Tag, a set is created by the first call,
+        // so systems create theirs before the scheduler runs them
+        // and declare the Tag in their system_access
+        template < typename Tag >
+        ecsex::change_set& changes();
+
+        template < typename Tag >
+        const ecsex::change_set* find_changes() const noexcept;
+
+        // marks the labels, layouts and widgets of a new or reset
+        // instance node for the systems that build them
+        void mark_instance_changes(const gobject& inst);
     private:
+        class async_instance;
+        using async_instance_uptr = std::unique_ptr<async_instance>;
+    private:
+        std::shared_ptr<pool_allocator> state_allocator_;
+        std::shared_ptr<pool_allocator> node_allocator_;
+        std::shared_ptr<transform_hierarchy> transforms_;
         ecs::registry registry_;
+        system_scheduler scheduler_;
+        ecsex::command_buffer commands_;
         gobject::destroying_states destroying_states_;
+        vector<std::unique_ptr<ecsex::change_set>> change_sets_;
+        flat_map<const prefab_plan*, std::unique_ptr<prefab_pool>> pools_;
+        vector<async_instance_uptr> async_instances_;
+        async_statistics async_stats_;
+        u64 async_budget_us_{1'000u};
     };
 }
+
+namespace e2d
+{
+    template < typename Tag >
+    ecsex::change_set& world::changes() {
+        const std::size_t index = utils::type_family<Tag>::id();
+        if ( index >= change_sets_.size() ) {
+            change_sets_.resize(index + 1u);
+        }
+        if ( !change_sets_[index] ) {
+            change_sets_[index] = std::make_unique<ecsex::change_set>();
+        }
+        return *change_sets_[index];
+    }
+
+    template < typename Tag >
+    const ecsex::change_set* world::find_changes() const noexcept {
+        const std::size_t index = utils::type_family<Tag>::id();
+        return index < change_sets_.size()
+            ? change_sets_[index].get()
+            : nullptr;
+    }
+}
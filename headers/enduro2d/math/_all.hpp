@@ -11,6 +11,7 @@
 #include "aabb.hpp"
 #include "mat2.hpp"
 #include "mat3.hpp"
+#include "mat3x2.hpp"
 #include "mat4.hpp"
 #include "rect.hpp"
 #include "trig.hpp"
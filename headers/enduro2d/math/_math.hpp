@@ -28,6 +28,9 @@ namespace e2d
     template < typename T >
     class mat4;
 
+    template < typename T >
+    class mat3x2;
+
     template < typename T >
     class rect;
 
@@ -91,6 +94,13 @@ namespace e2d
     using m4hi = mat4<i16>;
     using m4hu = mat4<u16>;
 
+    using m3x2d = mat3x2<f64>;
+    using m3x2f = mat3x2<f32>;
+    using m3x2i = mat3x2<i32>;
+    using m3x2u = mat3x2<u32>;
+    using m3x2hi = mat3x2<i16>;
+    using m3x2hu = mat3x2<u16>;
+
     using b2d = rect<f64>;
     using b2f = rect<f32>;
     using b2i = rect<i32>;
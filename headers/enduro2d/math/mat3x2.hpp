@@ -0,0 +1,390 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include "_math.hpp"
+#include "mat4.hpp"
+#include "trig.hpp"
+#include "trs2.hpp"
+#include "unit.hpp"
+#include "vec2.hpp"
+#include "vec4.hpp"
+
+namespace e2d
+{
+    //
+    // 2D affine transform for row vectors:
+    // p' = p.x * rows[0] + p.y * rows[1] + rows[2]
+    //
+
+    template < typename T >
+    class mat3x2 final {
+        static_assert(
+            std::is_arithmetic_v<T>,
+            "type of 'mat3x2' must be arithmetic");
+    public:
+        using self_type = mat3x2;
+        using value_type = T;
+    public:
+        vec2<T> rows[3] = {
+            {1, 0},
+            {0, 1},
+            {0, 0}};
+    public:
+        static constexpr mat3x2 zero() noexcept;
+        static constexpr mat3x2 identity() noexcept;
+    public:
+        constexpr mat3x2() noexcept = default;
+        constexpr mat3x2(const mat3x2& other) noexcept = default;
+        constexpr mat3x2& operator=(const mat3x2& other) noexcept = default;
+
+        constexpr mat3x2(
+            const vec2<T>& row0,
+            const vec2<T>& row1,
+            const vec2<T>& row2) noexcept;
+
+        constexpr mat3x2(
+            T m11, T m12,
+            T m21, T m22,
+            T m31, T m32) noexcept;
+
+        template < typename To >
+        mat3x2<To> cast_to() const noexcept;
+
+        T* data() noexcept;
+        const T* data() const noexcept;
+
+        vec2<T>& operator[](std::size_t row) noexcept;
+        const vec2<T>& operator[](std::size_t row) const noexcept;
+
+        mat3x2& operator*=(const mat3x2& other) noexcept;
+    };
+}
+
+namespace e2d
+{
+    template < typename T >
+    constexpr mat3x2<T> mat3x2<T>::zero() noexcept {
+        return {
+            0, 0,
+            0, 0,
+            0, 0};
+    }
+
+    template < typename T >
+    constexpr mat3x2<T> mat3x2<T>::identity() noexcept {
+        return {
+            1, 0,
+            0, 1,
+            0, 0};
+    }
+
+    template < typename T >
+    constexpr mat3x2<T>::mat3x2(
+        const vec2<T>& row0,
+        const vec2<T>& row1,
+        const vec2<T>& row2) noexcept
+    : rows{row0, row1, row2} {}
+
+    template < typename T >
+    constexpr mat3x2<T>::mat3x2(
+        T m11, T m12,
+        T m21, T m22,
+        T m31, T m32) noexcept
+    : rows{{m11, m12},
+           {m21, m22},
+           {m31, m32}} {}
+
+    template < typename T >
+    template < typename To >
+    mat3x2<To> mat3x2<T>::cast_to() const noexcept {
+        return {
+            rows[0].template cast_to<To>(),
+            rows[1].template cast_to<To>(),
+            rows[2].template cast_to<To>()};
+    }
+
+    template < typename T >
+    T* mat3x2<T>::data() noexcept {
+        return rows[0].data();
+    }
+
+    template < typename T >
+    const T* mat3x2<T>::data() const noexcept {
+        return rows[0].data();
+    }
+
+    template < typename T >
+    vec2<T>& mat3x2<T>::operator[](std::size_t row) noexcept {
+        E2D_ASSERT(row < 3);
+        return rows[row];
+    }
+
+    template < typename T >
+    const vec2<T>& mat3x2<T>::operator[](std::size_t row) const noexcept {
+        E2D_ASSERT(row < 3);
+        return rows[row];
+    }
+
+    template < typename T >
+    mat3x2<T>& mat3x2<T>::operator*=(const mat3x2& other) noexcept {
+        return *this = *this * other;
+    }
+}
+
+namespace e2d
+{
+    //
+    // make_mat3x2
+    //
+
+    template < typename T >
+    constexpr mat3x2<T> make_mat3x2(
+        const vec2<T>& row0,
+        const vec2<T>& row1,
+        const vec2<T>& row2) noexcept
+    {
+        return mat3x2<T>(row0, row1, row2);
+    }
+
+    template < typename T >
+    constexpr mat3x2<T> make_mat3x2(
+        T m11, T m12,
+        T m21, T m22,
+        T m31, T m32) noexcept
+    {
+        return mat3x2<T>(
+            m11, m12,
+            m21, m22,
+            m31, m32);
+    }
+
+    //
+    // mat3x2 (==,!=) mat3x2
+    //
+
+    template < typename T >
+    bool operator==(const mat3x2<T>& l, const mat3x2<T>& r) noexcept {
+        return
+            l.rows[0] == r.rows[0] &&
+            l.rows[1] == r.rows[1] &&
+            l.rows[2] == r.rows[2];
+    }
+
+    template < typename T >
+    bool operator!=(const mat3x2<T>& l, const mat3x2<T>& r) noexcept {
+        return !(l == r);
+    }
+
+    //
+    // mat3x2 (*) mat3x2
+    //
+
+    template < typename T >
+    mat3x2<T> operator*(const mat3x2<T>& l, const mat3x2<T>& r) noexcept {
+        const T* const lm = l.data();
+        const T* const rm = r.data();
+        return {
+            lm[0] * rm[0] + lm[1] * rm[2],
+            lm[0] * rm[1] + lm[1] * rm[3],
+
+            lm[2] * rm[0] + lm[3] * rm[2],
+            lm[2] * rm[1] + lm[3] * rm[3],
+
+            lm[4] * rm[0] + lm[5] * rm[2] + rm[4],
+            lm[4] * rm[1] + lm[5] * rm[3] + rm[5]};
+    }
+
+    //
+    // vec2 (*) mat3x2
+    //
+
+    template < typename T >
+    vec2<T> operator*(const vec2<T>& l, const mat3x2<T>& r) noexcept {
+        const T* const rm = r.data();
+        return {
+            l.x * rm[0] + l.y * rm[2] + rm[4],
+            l.x * rm[1] + l.y * rm[3] + rm[5]};
+    }
+
+    //
+    // vec4 (*) mat3x2
+    //
+
+    template < typename T >
+    vec4<T> operator*(const vec4<T>& l, const mat3x2<T>& r) noexcept {
+        const T* const rm = r.data();
+        return {
+            l.x * rm[0] + l.y * rm[2] + l.w * rm[4],
+            l.x * rm[1] + l.y * rm[3] + l.w * rm[5],
+            l.z,
+            l.w};
+    }
+}
+
+namespace e2d::math
+{
+    //
+    // make_scale_matrix
+    //
+
+    template < typename T >
+    mat3x2<T> make_scale_matrix3x2(T x, T y) noexcept {
+        return {
+            x, 0,
+            0, y,
+            0, 0};
+    }
+
+    template < typename T >
+    mat3x2<T> make_scale_matrix3x2(const vec2<T>& xy) noexcept {
+        return make_scale_matrix3x2(
+            xy.x,
+            xy.y);
+    }
+
+    //
+    // make_translation_matrix
+    //
+
+    template < typename T >
+    mat3x2<T> make_translation_matrix3x2(T x, T y) noexcept {
+        return {
+            1, 0,
+            0, 1,
+            x, y};
+    }
+
+    template < typename T >
+    mat3x2<T> make_translation_matrix3x2(const vec2<T>& xy) noexcept {
+        return make_translation_matrix3x2(
+            xy.x,
+            xy.y);
+    }
+
+    //
+    // make_rotation_matrix
+    //
+
+    template < typename T, typename AngleTag >
+    std::enable_if_t<std::is_floating_point_v<T>, mat3x2<T>>
+    make_rotation_matrix3x2(const unit<T, AngleTag>& angle) noexcept {
+        const T cs = math::cos(angle);
+        const T sn = math::sin(angle);
+        return {
+            cs, sn,
+            -sn, cs,
+            0, 0};
+    }
+
+    //
+    // make_trs_matrix
+    //
+
+    template < typename T >
+    std::enable_if_t<std::is_floating_point_v<T>, mat3x2<T>>
+    make_trs_matrix3x2(const trs2<T>& trs) noexcept {
+        const T cs = math::cos(make_rad(trs.rotation));
+        const T sn = math::sin(make_rad(trs.rotation));
+        return {
+            trs.scale.x * cs, trs.scale.x * sn,
+            -trs.scale.y * sn, trs.scale.y * cs,
+            trs.translation.x, trs.translation.y};
+    }
+
+    //
+    // make_matrix4
+    //
+
+    template < typename T >
+    mat4<T> make_matrix4(const mat3x2<T>& m) noexcept {
+        const T* const mm = m.data();
+        return {
+            mm[0], mm[1], 0, 0,
+            mm[2], mm[3], 0, 0,
+            0,     0,     1, 0,
+            mm[4], mm[5], 0, 1};
+    }
+
+    //
+    // transform_point/transform_vector
+    //
+
+    template < typename T >
+    vec2<T> transform_point(const mat3x2<T>& m, const vec2<T>& p) noexcept {
+        return p * m;
+    }
+
+    template < typename T >
+    vec2<T> transform_vector(const mat3x2<T>& m, const vec2<T>& v) noexcept {
+        const T* const mm = m.data();
+        return {
+            v.x * mm[0] + v.y * mm[2],
+            v.x * mm[1] + v.y * mm[3]};
+    }
+
+    template < typename T >
+    void transform_points(
+        const mat3x2<T>& m,
+        const vec2<T>* src,
+        vec2<T>* dst,
+        std::size_t count) noexcept
+    {
+        const T m0 = m.rows[0].x, m1 = m.rows[0].y;
+        const T m2 = m.rows[1].x, m3 = m.rows[1].y;
+        const T m4 = m.rows[2].x, m5 = m.rows[2].y;
+        for ( std::size_t i = 0; i < count; ++i ) {
+            const T x = src[i].x;
+            const T y = src[i].y;
+            dst[i].x = x * m0 + y * m2 + m4;
+            dst[i].y = x * m1 + y * m3 + m5;
+        }
+    }
+
+    //
+    // approximately
+    //
+
+    template < typename T >
+    bool approximately(
+        const mat3x2<T>& l,
+        const mat3x2<T>& r,
+        T precision = math::default_precision<T>()) noexcept
+    {
+        return
+            math::approximately(l.rows[0], r.rows[0], precision) &&
+            math::approximately(l.rows[1], r.rows[1], precision) &&
+            math::approximately(l.rows[2], r.rows[2], precision);
+    }
+
+    //
+    // inversed
+    //
+
+    template < typename T >
+    std::enable_if_t<std::is_floating_point_v<T>, std::pair<mat3x2<T>, bool>>
+    inversed(
+        const mat3x2<T>& m,
+        T precision = math::default_precision<T>()) noexcept
+    {
+        const T* const mm = m.data();
+        const T det = mm[0] * mm[3] - mm[1] * mm[2];
+        if ( math::is_near_zero(det, precision) ) {
+            return std::make_pair(mat3x2<T>::identity(), false);
+        }
+        const T inv_det = T(1) / det;
+        const T a = mm[3] * inv_det;
+        const T b = -mm[1] * inv_det;
+        const T c = -mm[2] * inv_det;
+        const T d = mm[0] * inv_det;
+        return std::make_pair(mat3x2<T>(
+            a, b,
+            c, d,
+            -(mm[4] * a + mm[5] * c),
+            -(mm[4] * b + mm[5] * d)), true);
+    }
+}
@@ -14,6 +14,7 @@
 #include "color32.hpp"
 #include "filesystem.hpp"
 #include "filesystem.inl"
+#include "frame_allocator.hpp"
 #include "font.hpp"
 #include "image.hpp"
 #include "imgui_utils.hpp"
@@ -23,6 +24,7 @@
 #include "mesh.hpp"
 #include "module.hpp"
 #include "path.hpp"
+#include "pool_allocator.hpp"
 #include "shape.hpp"
 #include "streams.hpp"
 #include "streams.inl"
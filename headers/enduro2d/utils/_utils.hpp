@@ -21,6 +21,8 @@ namespace e2d
     class read_file;
     class write_file;
     class font;
+    class frame_allocator;
+    class linear_arena;
     class image;
     class mesh;
     class shape;
@@ -28,6 +30,7 @@ namespace e2d
     class output_stream;
     class input_sequence;
     class output_sequence;
+    class pool_allocator;
     class url;
 
     template < typename T >
@@ -36,6 +39,9 @@ namespace e2d
     template < typename T >
     class intrusive_ptr;
 
+    template < typename T >
+    class linear_allocator;
+
     template < typename T, typename Tag >
     class intrusive_list;
 
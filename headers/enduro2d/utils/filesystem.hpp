@@ -29,12 +29,27 @@ namespace e2d
     public:
         virtual const str& path() const noexcept = 0;
     };
+
+    class mapped_file;
+    using mapped_file_uptr = std::unique_ptr<mapped_file>;
+
+    class mapped_file : private noncopyable {
+    public:
+        virtual ~mapped_file() noexcept = default;
+        virtual const void* data() const noexcept = 0;
+        virtual std::size_t size() const noexcept = 0;
+        virtual const str& path() const noexcept = 0;
+    };
 }
 
 namespace e2d
 {
     read_file_uptr make_read_file(str_view path) noexcept;
     write_file_uptr make_write_file(str_view path, bool append) noexcept;
+
+    // read-only mapping of the whole file,
+    // the file must not be changed while it is mapped
+    mapped_file_uptr make_mapped_file(str_view path) noexcept;
 }
 
 namespace e2d::filesystem
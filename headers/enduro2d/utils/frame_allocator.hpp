@@ -0,0 +1,181 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include "_utils.hpp"
+
+namespace e2d
+{
+    //
+    // linear_arena
+    //
+    // Bump allocator over a list of chunks, not thread-safe.
+    // Memory is released by rewinding to a marker, only the last
+    // allocation can be given back by deallocate.
+    //
+
+    class linear_arena final : private noncopyable {
+    public:
+        struct marker {
+            std::size_t chunk{0u};
+            std::size_t offset{0u};
+            std::size_t used{0u};
+        };
+
+        struct statistics {
+            std::size_t used{0u};
+            std::size_t capacity{0u};
+            std::size_t chunks{0u};
+            std::size_t high_water{0u};
+            std::size_t peak_high_water{0u};
+        };
+    public:
+        explicit linear_arena(std::size_t chunk_size = 64u * 1024u);
+        ~linear_arena() noexcept;
+
+        void* allocate(std::size_t size, std::size_t alignment);
+        void deallocate(void* ptr, std::size_t size) noexcept;
+
+        marker mark() const noexcept;
+        void rewind(const marker& m) noexcept;
+
+        // forgets all allocations and merges chunks into one
+        // big enough for the current high water mark
+        void reset() noexcept;
+
+        const statistics& stats() const noexcept;
+    private:
+        struct chunk {
+            std::unique_ptr<u8[]> data;
+            std::size_t size{0u};
+        };
+    private:
+        vector<chunk> chunks_;
+        std::size_t chunk_size_{0u};
+        std::size_t chunk_index_{0u};
+        std::size_t offset_{0u};
+        statistics stats_;
+    };
+
+    //
+    // linear_allocator
+    //
+
+    template < typename T >
+    class linear_allocator {
+    public:
+        using value_type = T;
+    public:
+        linear_allocator(linear_arena& arena) noexcept;
+
+        template < typename U >
+        linear_allocator(const linear_allocator<U>& other) noexcept;
+
+        T* allocate(std::size_t n);
+        void deallocate(T* p, std::size_t n) noexcept;
+
+        linear_arena& arena() const noexcept;
+    private:
+        linear_arena* arena_{nullptr};
+    };
+
+    template < typename T, typename U >
+    bool operator==(const linear_allocator<T>& l, const linear_allocator<U>& r) noexcept;
+    template < typename T, typename U >
+    bool operator!=(const linear_allocator<T>& l, const linear_allocator<U>& r) noexcept;
+
+    template < typename T >
+    using linear_vector = std::vector<T, linear_allocator<T>>;
+
+    //
+    // frame_allocator
+    //
+    // Every thread gets its own linear arena. The engine starts a new
+    // frame after frame_finalize and an arena is reset by the first use
+    // of its thread in the new frame if nothing is allocated from it.
+    //
+
+    class frame_allocator final {
+    public:
+        class scope;
+
+        struct statistics {
+            u32 frame{0u};
+            std::size_t arenas{0u};
+            std::size_t capacity{0u};
+            std::size_t frame_high_water{0u};
+            std::size_t peak_high_water{0u};
+        };
+    public:
+        static linear_arena& thread_arena();
+        static void next_frame() noexcept;
+        static statistics stats() noexcept;
+    };
+
+    //
+    // frame_allocator::scope
+    //
+    // Rewinds the thread arena on exit, so everything allocated
+    // from the scope must be destroyed before the scope itself.
+    //
+
+    class frame_allocator::scope final : private noncopyable {
+    public:
+        scope();
+        ~scope() noexcept;
+
+        linear_arena& arena() const noexcept;
+
+        template < typename T >
+        linear_allocator<T> allocator() const noexcept;
+    private:
+        linear_arena& arena_;
+        linear_arena::marker marker_;
+    };
+}
+
+namespace e2d
+{
+    template < typename T >
+    linear_allocator<T>::linear_allocator(linear_arena& arena) noexcept
+    : arena_(&arena) {}
+
+    template < typename T >
+    template < typename U >
+    linear_allocator<T>::linear_allocator(const linear_allocator<U>& other) noexcept
+    : arena_(&other.arena()) {}
+
+    template < typename T >
+    T* linear_allocator<T>::allocate(std::size_t n) {
+        return static_cast<T*>(arena_->allocate(sizeof(T) * n, alignof(T)));
+    }
+
+    template < typename T >
+    void linear_allocator<T>::deallocate(T* p, std::size_t n) noexcept {
+        arena_->deallocate(p, sizeof(T) * n);
+    }
+
+    template < typename T >
+    linear_arena& linear_allocator<T>::arena() const noexcept {
+        return *arena_;
+    }
+
+    template < typename T, typename U >
+    bool operator==(const linear_allocator<T>& l, const linear_allocator<U>& r) noexcept {
+        return &l.arena() == &r.arena();
+    }
+
+    template < typename T, typename U >
+    bool operator!=(const linear_allocator<T>& l, const linear_allocator<U>& r) noexcept {
+        return !(l == r);
+    }
+
+    template < typename T >
+    linear_allocator<T> frame_allocator::scope::allocator() const noexcept {
+        return linear_allocator<T>(arena_);
+    }
+}
@@ -8,6 +8,9 @@
 
 #include "_utils.hpp"
 
+#include "buffer.hpp"
+#include "buffer_view.hpp"
+
 #include <3rdparty/rapidjson/schema.h>
 #include <3rdparty/rapidjson/document.h>
 
@@ -16,6 +19,18 @@ namespace e2d::json_utils
     void add_common_schema_definitions(rapidjson::Document& schema);
 }
 
+namespace e2d::json_utils
+{
+    // tagged binary form of json documents, it is loaded without
+    // text parsing and written by the offline asset cooker,
+    // the schema tag names the asset type the document was validated for
+    bool is_binary_json(buffer_view src) noexcept;
+    bool try_load_binary_json(rapidjson::Document& dst, buffer_view src) noexcept;
+    bool try_load_binary_json(rapidjson::Document& dst, str& schema_tag, buffer_view src) noexcept;
+    bool try_save_binary_json(const rapidjson::Value& src, buffer& dst) noexcept;
+    bool try_save_binary_json(const rapidjson::Value& src, str_view schema_tag, buffer& dst) noexcept;
+}
+
 namespace e2d::json_utils
 {
     bool try_parse_value(const rapidjson::Value& root, v2i& v) noexcept;
@@ -0,0 +1,53 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include "_utils.hpp"
+
+namespace e2d
+{
+    //
+    // pool_allocator
+    //
+    // Thread-safe pool of fixed-size blocks carved from big chunks.
+    // Freed blocks go to a free list, chunks are released wholesale
+    // by the destructor, so all blocks must be returned before that.
+    //
+
+    class pool_allocator final : private noncopyable {
+    public:
+        struct statistics {
+            std::size_t allocations{0u};
+            std::size_t deallocations{0u};
+            std::size_t live_blocks{0u};
+            std::size_t peak_blocks{0u};
+            std::size_t chunks{0u};
+        };
+    public:
+        explicit pool_allocator(
+            std::size_t block_size,
+            std::size_t blocks_per_chunk = 256u);
+        ~pool_allocator() noexcept;
+
+        void* allocate();
+        void deallocate(void* block) noexcept;
+
+        std::size_t block_size() const noexcept;
+        statistics stats() const noexcept;
+    private:
+        struct free_block {
+            free_block* next{nullptr};
+        };
+    private:
+        const std::size_t block_size_;
+        const std::size_t blocks_per_chunk_;
+        vector<std::unique_ptr<u8[]>> chunks_;
+        free_block* free_list_{nullptr};
+        statistics stats_;
+        mutable std::mutex mutex_;
+    };
+}
@@ -0,0 +1,128 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "../common.hpp"
+using namespace e2d;
+
+namespace
+{
+    class game_system final : public systems::update_system {
+    public:
+        game_system(std::size_t label_count)
+        : label_count_(label_count) {}
+
+        void process(
+            ecs::registry& owner,
+            const systems::update_event& event) override
+        {
+            E2D_UNUSED(event);
+            const keyboard& k = the<input>().keyboard();
+
+            if ( k.is_key_just_released(keyboard_key::f12) ) {
+                the<dbgui>().toggle_visible(!the<dbgui>().visible());
+            }
+
+            if ( k.is_key_just_released(keyboard_key::escape) ) {
+                the<window>().set_should_close(true);
+            }
+
+            if ( k.is_key_pressed(keyboard_key::lsuper) && k.is_key_just_released(keyboard_key::enter) ) {
+                the<window>().toggle_fullscreen(!the<window>().fullscreen());
+            }
+
+            if ( k.is_key_just_released(keyboard_key::space) ) {
+                use_model_renderers_ = !use_model_renderers_;
+                owner.for_joined_components<label, actor>(
+                [this](const ecs::const_entity&, const label&, actor& act){
+                    gcomponent<label> lbl{act.node()->owner()};
+                    if ( use_model_renderers_ ) {
+                        lbl.component<model_renderer>().ensure();
+                    } else {
+                        lbl.component<model_renderer>().remove();
+                    }
+                    labels::mark_dirty(lbl);
+                });
+            }
+
+            const render::statistics& stats = the<render>().render_statistics();
+            const u64 frame_draw_calls = stats.draw_calls - last_draw_calls_;
+            last_draw_calls_ = stats.draw_calls;
+
+            the<window>().set_title(strings::rformat(
+                "sample_10 (%0 labels, %1 draw calls, %2, press space to switch)",
+                label_count_,
+                frame_draw_calls,
+                use_model_renderers_ ? "model_renderer" : "batcher"));
+        }
+    private:
+        bool use_model_renderers_ = false;
+        u64 last_draw_calls_ = 0u;
+        std::size_t label_count_ = 0u;
+    };
+
+    class game final : public starter::application {
+    public:
+        bool initialize() final {
+            return create_scene()
+                && create_systems();
+        }
+    private:
+        bool create_scene() {
+            auto scene_prefab_res = the<library>().load_asset<prefab_asset>("scenes/sample_10.json");
+            auto label_prefab_res = the<library>().load_asset<prefab_asset>("prefabs/label_sdf_prefab.json");
+
+            if ( !scene_prefab_res || !label_prefab_res ) {
+                return false;
+            }
+
+            auto scene_go = the<world>().instantiate(scene_prefab_res->content());
+            if ( !scene_go ) {
+                return false;
+            }
+
+            const node_iptr scene_n = scene_go.component<actor>()->node();
+            for ( std::size_t y = 0; y < label_rows; ++y )
+            for ( std::size_t x = 0; x < label_columns; ++x ) {
+                const v2f position = v2f{
+                    (x - label_columns * 0.5f) * 50.f,
+                    (y - label_rows * 0.5f) * 36.f};
+
+                gobject label_go = the<world>().instantiate(
+                    label_prefab_res->content(),
+                    scene_n,
+                    make_trs2(position, 0.f, v2f::unit() * 0.5f));
+
+                labels::change_text(
+                    label_go.component<label>(),
+                    strings::rformat("%0", y * label_columns + x));
+            }
+
+            return true;
+        }
+
+        bool create_systems() {
+            ecs::registry_filler(the<world>().registry())
+            .feature<struct game_feature>(ecs::feature()
+                .add_system<game_system>(label_rows * label_columns));
+            return true;
+        }
+    private:
+        static constexpr std::size_t label_rows = 20u;
+        static constexpr std::size_t label_columns = 15u;
+    };
+}
+
+int e2d_main(int argc, char *argv[]) {
+    const auto starter_params = starter::parameters(
+        engine::parameters("sample_10", "enduro2d")
+            .window_params(engine::window_parameters()
+                .size({1024, 768}))
+            .timer_params(engine::timer_parameters()
+                .maximal_framerate(100)));
+    modules::initialize<starter>(argc, argv, starter_params).start<game>();
+    modules::shutdown<starter>();
+    return 0;
+}
@@ -115,6 +115,19 @@ namespace e2d
         return maximal_framerate_;
     }
 
+    //
+    // engine::vfs_parameters
+    //
+
+    engine::vfs_parameters& engine::vfs_parameters::io_threads(u32 value) noexcept {
+        io_threads_ = value;
+        return *this;
+    }
+
+    u32 engine::vfs_parameters::io_threads() const noexcept {
+        return io_threads_;
+    }
+
     //
     // engine::window_parameters
     //
@@ -207,6 +220,11 @@ namespace e2d
         return *this;
     }
 
+    engine::parameters& engine::parameters::vfs_params(vfs_parameters value) noexcept {
+        vfs_params_ = std::move(value);
+        return *this;
+    }
+
     str& engine::parameters::game_name() noexcept {
         return game_name_;
     }
@@ -235,6 +253,10 @@ namespace e2d
         return timer_params_;
     }
 
+    engine::vfs_parameters& engine::parameters::vfs_params() noexcept {
+        return vfs_params_;
+    }
+
     const str& engine::parameters::game_name() const noexcept {
         return game_name_;
     }
@@ -263,6 +285,10 @@ namespace e2d
         return timer_params_;
     }
 
+    const engine::vfs_parameters& engine::parameters::vfs_params() const noexcept {
+        return vfs_params_;
+    }
+
     //
     // engine
     //
@@ -378,7 +404,10 @@ namespace e2d
 
         // setup vfs
 
-        safe_module_initialize<vfs>();
+        const u32 vfs_io_threads = params.vfs_params().io_threads()
+            ? params.vfs_params().io_threads()
+            : math::max(std::thread::hardware_concurrency() / 2u, 1u);
+        safe_module_initialize<vfs>(vfs_io_threads);
 
         the<vfs>().register_scheme<filesystem_file_source>("file");
         safe_register_predef_path(the<vfs>(), "home", filesystem::predef_path::home);
@@ -485,6 +514,7 @@ namespace e2d
                 }
 
                 app->frame_finalize();
+                frame_allocator::next_frame();
                 state_->calculate_end_frame_timers();
             } catch ( ... ) {
                 app->shutdown();
@@ -495,6 +525,15 @@ namespace e2d
             window::poll_events();
         }
 
+        const frame_allocator::statistics frame_stats = frame_allocator::stats();
+        the<debug>().trace("ENGINE: Frame allocator statistics:\n"
+            "--> Arenas: %0\n"
+            "--> Capacity: %1 bytes\n"
+            "--> Peak high water: %2 bytes",
+            frame_stats.arenas,
+            frame_stats.capacity,
+            frame_stats.peak_high_water);
+
         app->shutdown();
         return true;
     }
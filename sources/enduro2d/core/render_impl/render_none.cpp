@@ -287,6 +287,11 @@ namespace e2d
         return caps;
     }
 
+    const render::statistics& render::render_statistics() const noexcept {
+        static statistics stats;
+        return stats;
+    }
+
     bool render::is_pixel_supported(const pixel_declaration& decl) const noexcept {
         E2D_UNUSED(decl);
         return false;
@@ -931,6 +931,7 @@ namespace e2d
                             command.index_count());
                     });
                 });
+                state_->register_draw_call(command.index_count());
             } catch (...) {
                 main_property_cache().clear();
                 throw;
@@ -1139,6 +1140,11 @@ namespace e2d
         return state_->device_capabilities();
     }
 
+    const render::statistics& render::render_statistics() const noexcept {
+        E2D_ASSERT(is_in_main_thread());
+        return state_->render_statistics();
+    }
+
     bool render::is_pixel_supported(const pixel_declaration& decl) const noexcept {
         E2D_ASSERT(is_in_main_thread());
         const device_caps& caps = device_capabilities();
@@ -321,6 +321,16 @@ namespace e2d
         return render_target_;
     }
 
+    const render::statistics& render::internal_state::render_statistics() const noexcept {
+        return statistics_;
+    }
+
+    render::internal_state& render::internal_state::register_draw_call(std::size_t index_count) noexcept {
+        ++statistics_.draw_calls;
+        statistics_.drawn_indices += index_count;
+        return *this;
+    }
+
     render::internal_state& render::internal_state::reset_states() noexcept {
         set_depth_state_(state_block_.depth());
         set_stencil_state_(state_block_.stencil());
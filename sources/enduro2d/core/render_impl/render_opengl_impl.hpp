@@ -175,7 +175,10 @@ namespace e2d
         window& wnd() const noexcept;
         const device_caps& device_capabilities() const noexcept;
         const render_target_ptr& render_target() const noexcept;
+        const statistics& render_statistics() const noexcept;
     public:
+        internal_state& register_draw_call(std::size_t index_count) noexcept;
+
         internal_state& reset_states() noexcept;
         internal_state& set_states(const state_block& sb) noexcept;
 
@@ -194,6 +197,7 @@ namespace e2d
         debug& debug_;
         window& window_;
         device_caps device_caps_;
+        statistics statistics_;
         state_block state_block_;
         shader_ptr shader_program_;
         render_target_ptr render_target_;
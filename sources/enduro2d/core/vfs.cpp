@@ -68,118 +68,571 @@ namespace
             }
         }
     };
+
+    template < typename OwnedState >
+    class archive_stored_stream final : public input_stream {
+        OwnedState owned_state_;
+        mz_zip_archive* archive_ = nullptr;
+        u64 offset_ = 0;
+        std::size_t length_ = 0;
+        std::size_t pos_ = 0;
+    public:
+        archive_stored_stream(
+            const OwnedState& owned_state,
+            mz_zip_archive* archive,
+            u64 offset,
+            std::size_t length)
+        : owned_state_(owned_state)
+        , archive_(archive)
+        , offset_(offset)
+        , length_(length) {}
+
+        std::size_t read(void* dst, std::size_t size) final {
+            const std::size_t read_bytes = math::min(size, length_ - pos_);
+            if ( read_bytes == 0u || read_bytes != archive_->m_pRead(
+                archive_->m_pIO_opaque,
+                offset_ + pos_,
+                dst,
+                read_bytes) )
+            {
+                return 0u;
+            }
+            pos_ += read_bytes;
+            return read_bytes;
+        }
+
+        std::size_t seek(std::ptrdiff_t offset, bool relative) final {
+            const std::ptrdiff_t new_pos = relative
+                ? math::numeric_cast<std::ptrdiff_t>(pos_) + offset
+                : offset;
+            if ( new_pos < 0 || math::numeric_cast<std::size_t>(new_pos) > length_ ) {
+                throw bad_stream_operation();
+            }
+            pos_ = math::numeric_cast<std::size_t>(new_pos);
+            return pos_;
+        }
+
+        std::size_t tell() const final {
+            return pos_;
+        }
+
+        std::size_t length() const noexcept final {
+            return length_;
+        }
+    };
+
+    constexpr std::size_t archive_default_cache_capacity = 8u * 1024u * 1024u;
+
+    // offset of the data of a stored entry, it follows the local file header
+    std::optional<u64> find_stored_data_offset(
+        mz_zip_archive* archive,
+        const mz_zip_archive_file_stat& stat) noexcept
+    {
+        if ( stat.m_method != 0
+            || stat.m_is_directory
+            || stat.m_is_encrypted
+            || !stat.m_is_supported
+            || stat.m_comp_size != stat.m_uncomp_size )
+        {
+            return std::nullopt;
+        }
+
+        u8 header[30];
+        if ( sizeof(header) != archive->m_pRead(
+            archive->m_pIO_opaque,
+            stat.m_local_header_ofs,
+            header,
+            sizeof(header)) )
+        {
+            return std::nullopt;
+        }
+
+        const u32 signature =
+            u32(header[0]) | (u32(header[1]) << 8) | (u32(header[2]) << 16) | (u32(header[3]) << 24);
+        if ( signature != 0x04034b50u ) {
+            return std::nullopt;
+        }
+
+        const u64 filename_size = u64(header[26]) | (u64(header[27]) << 8);
+        const u64 extra_size = u64(header[28]) | (u64(header[29]) << 8);
+        const u64 offset = stat.m_local_header_ofs + sizeof(header) + filename_size + extra_size;
+        if ( offset + stat.m_comp_size > archive->m_archive_size ) {
+            return std::nullopt;
+        }
+
+        return offset;
+    }
+
+    // path::combine into a stack buffer, long paths fall back to the heap
+    class combined_path final : private noncopyable {
+    public:
+        combined_path(str_view lhs, str_view rhs) {
+            if ( lhs.empty() || path::is_absolute(rhs) ) {
+                view_ = rhs;
+                return;
+            }
+            if ( rhs.empty() ) {
+                view_ = lhs;
+                return;
+            }
+            const bool with_separator = lhs.back() != '/' && lhs.back() != '\\';
+            const std::size_t size = lhs.size() + rhs.size() + (with_separator ? 1u : 0u);
+            char* dst = buffer_;
+            if ( size > std::size(buffer_) ) {
+                heap_.resize(size);
+                dst = heap_.data();
+            }
+            std::copy(lhs.begin(), lhs.end(), dst);
+            if ( with_separator ) {
+                dst[lhs.size()] = '/';
+            }
+            std::copy(rhs.begin(), rhs.end(), dst + size - rhs.size());
+            view_ = str_view(dst, size);
+        }
+
+        str_view view() const noexcept {
+            return view_;
+        }
+    private:
+        char buffer_[256];
+        str heap_;
+        str_view view_;
+    };
+
+    //
+    // bundle layout, all numbers are little-endian:
+    //
+    // header      : bundle_header
+    // index       : bundle_entry[entry_count], sorted by (hash, name)
+    // names       : utf8 paths without terminators
+    // data        : entry contents, every one is 16-byte aligned
+    //
+
+    constexpr u32 bundle_magic = 0x42443245u; // E2DB
+    constexpr u32 bundle_version = 1u;
+    constexpr std::size_t bundle_alignment = 16u;
+
+    constexpr u32 bundle_entry_compressed = 1u << 0;
+
+    struct bundle_header final {
+        u32 magic{bundle_magic};
+        u32 version{bundle_version};
+        u32 entry_count{0u};
+        u32 names_size{0u};
+        u64 names_offset{0u};
+        u64 data_offset{0u};
+    };
+
+    struct bundle_entry final {
+        u32 hash{0u};
+        u32 flags{0u};
+        u32 name_offset{0u};
+        u32 name_size{0u};
+        u64 offset{0u};
+        u32 packed_size{0u};
+        u32 size{0u};
+    };
+
+    static_assert(sizeof(bundle_header) == 32u);
+    static_assert(sizeof(bundle_entry) == 32u);
+
+    std::size_t bundle_align(std::size_t offset) noexcept {
+        return (offset + bundle_alignment - 1u) & ~(bundle_alignment - 1u);
+    }
+
+    // seekable stream over memory kept alive by its owner
+    class shared_view_stream final : public input_stream {
+    public:
+        shared_view_stream(std::shared_ptr<const void> owner, buffer_view data) noexcept
+        : owner_(std::move(owner))
+        , data_(data) {}
+
+        std::size_t read(void* dst, std::size_t size) final {
+            const std::size_t read_bytes = math::min(size, data_.size() - pos_);
+            if ( read_bytes > 0u ) {
+                std::memcpy(dst, static_cast<const u8*>(data_.data()) + pos_, read_bytes);
+                pos_ += read_bytes;
+            }
+            return read_bytes;
+        }
+
+        std::size_t seek(std::ptrdiff_t offset, bool relative) final {
+            const std::ptrdiff_t new_pos = relative
+                ? math::numeric_cast<std::ptrdiff_t>(pos_) + offset
+                : offset;
+            if ( new_pos < 0 || math::numeric_cast<std::size_t>(new_pos) > data_.size() ) {
+                throw bad_stream_operation();
+            }
+            pos_ = math::numeric_cast<std::size_t>(new_pos);
+            return pos_;
+        }
+
+        std::size_t tell() const final {
+            return pos_;
+        }
+
+        std::size_t length() const noexcept final {
+            return data_.size();
+        }
+    private:
+        std::shared_ptr<const void> owner_;
+        buffer_view data_;
+        std::size_t pos_{0u};
+    };
 }
 
 namespace e2d
 {
+    //
+    // file_view
+    //
+
+    file_view::file_view(buffer content) {
+        auto owner = std::make_shared<buffer>(std::move(content));
+        content_ = buffer_view(*owner);
+        owner_ = std::move(owner);
+    }
+
+    file_view::file_view(std::shared_ptr<const mapped_file> file) noexcept
+    : content_(file ? buffer_view(file->data(), file->size()) : buffer_view())
+    , mapped_(!!file) {
+        owner_ = std::move(file);
+    }
+
+    file_view::file_view(std::shared_ptr<const mapped_file> file, buffer_view content) noexcept
+    : content_(file ? content : buffer_view())
+    , mapped_(!!file) {
+        owner_ = std::move(file);
+    }
+
+    const buffer_view& file_view::content() const noexcept {
+        return content_;
+    }
+
+    const void* file_view::data() const noexcept {
+        return content_.data();
+    }
+
+    std::size_t file_view::size() const noexcept {
+        return content_.size();
+    }
+
+    bool file_view::empty() const noexcept {
+        return content_.empty();
+    }
+
+    bool file_view::mapped() const noexcept {
+        return mapped_;
+    }
+
+    //
+    // vfs::file_source
+    //
+
+    std::optional<file_view> vfs::file_source::view(str_view path) const {
+        E2D_UNUSED(path);
+        return std::nullopt;
+    }
+
     //
     // vfs
     //
 
     class vfs::state final : private e2d::noncopyable {
+    public:
+        using file_source_ptr = std::shared_ptr<file_source>;
+
+        // immutable snapshot, writers copy it under the mutex and swap it atomically
+        struct tables final {
+            flat_map<str, url> aliases;
+            flat_map<str, url> resolved_aliases;
+            flat_map<str, file_source_ptr> schemes;
+        };
+        using tables_ptr = std::shared_ptr<const tables>;
     public:
         std::mutex mutex;
-        stdex::jobber worker{1};
-        flat_map<str, url> aliases;
-        flat_map<str, file_source_uptr> schemes;
+        tables_ptr tables_snapshot{std::make_shared<tables>()};
     public:
-        url resolve_url(const url& url, u8 level = 0) const {
-            if ( level > 32 ) {
-                throw bad_vfs_operation();
+        const std::size_t io_threads;
+        std::atomic<std::size_t> io_queued{0u};
+        std::atomic<std::size_t> io_active{0u};
+        std::atomic<std::size_t> io_peak_queued{0u};
+        std::atomic<u64> io_completed{0u};
+        std::atomic<u64> io_failed{0u};
+        std::atomic<u64> io_cancelled{0u};
+        std::atomic<u64> io_bytes{0u};
+        std::atomic<u64> io_reset_time_us{time::now_us<u64>().value};
+    public:
+        // the last one, io threads are joined before the rest is destroyed
+        stdex::jobber worker;
+    public:
+        state(std::size_t nio_threads)
+        : io_threads(math::max(nio_threads, std::size_t(1u)))
+        , worker(io_threads) {}
+
+        template < typename F >
+        auto enqueue(
+            vfs::priority priority,
+            std::shared_ptr<std::atomic<bool>> cancelled,
+            F&& f)
+        {
+            const std::size_t queued = io_queued.fetch_add(1u) + 1u;
+            std::size_t peak_queued = io_peak_queued.load();
+            while ( peak_queued < queued && !io_peak_queued.compare_exchange_weak(peak_queued, queued) ) {}
+
+            return worker.async(to_jobber_priority(priority), [
+                this,
+                cancelled = std::move(cancelled),
+                f = std::forward<F>(f)
+            ](){
+                io_queued.fetch_sub(1u);
+                if ( cancelled && cancelled->load() ) {
+                    io_cancelled.fetch_add(1u);
+                    throw vfs_load_cancelled_exception();
+                }
+
+                io_active.fetch_add(1u);
+                DEFER([this](){
+                    io_active.fetch_sub(1u);
+                });
+
+                try {
+                    auto content = f();
+                    io_bytes.fetch_add(content.size());
+                    io_completed.fetch_add(1u);
+                    return content;
+                } catch (...) {
+                    io_failed.fetch_add(1u);
+                    throw;
+                }
+            });
+        }
+        tables_ptr load_tables() const noexcept {
+            return std::atomic_load(&tables_snapshot);
+        }
+
+        // must be called under the mutex
+        template < typename F >
+        bool update_tables(F&& f) {
+            auto new_tables = std::make_shared<tables>(*tables_snapshot);
+            if ( !std::invoke(std::forward<F>(f), *new_tables) ) {
+                return false;
+            }
+            std::atomic_store(&tables_snapshot, tables_ptr(std::move(new_tables)));
+            return true;
+        }
+
+        // flattens alias chains, so any url is resolved by one lookup
+        static bool resolve_aliases(tables& t) {
+            flat_map<str, url> resolved_aliases;
+            for ( const auto& [scheme, alias] : t.aliases ) {
+                url resolved = alias;
+                for ( u8 level = 0; ; ++level ) {
+                    if ( level > 32 ) {
+                        return false;
+                    }
+                    const auto alias_iter = t.aliases.find(resolved.scheme());
+                    if ( alias_iter == t.aliases.cend() ) {
+                        break;
+                    }
+                    resolved = alias_iter->second / resolved.path();
+                }
+                resolved_aliases.emplace(scheme, std::move(resolved));
             }
-            const auto alias_iter = aliases.find(url.scheme());
-            return alias_iter != aliases.cend()
-                ? resolve_url(alias_iter->second / url.path(), level + 1)
-                : url;
+            t.resolved_aliases = std::move(resolved_aliases);
+            return true;
         }
 
         template < typename F, typename R >
         R with_file_source(const url& url, F&& f, R&& fallback_result) const {
-            const auto resolved_url = resolve_url(url);
-            const auto scheme_iter = schemes.find(resolved_url.scheme());
-            return (scheme_iter != schemes.cend() && scheme_iter->second)
+            const tables_ptr t = load_tables();
+            const auto alias_iter = t->resolved_aliases.find(url.scheme());
+            if ( alias_iter == t->resolved_aliases.cend() ) {
+                return with_file_source_(*t, url.scheme(), url.path(),
+                    std::forward<F>(f), std::forward<R>(fallback_result));
+            }
+            const combined_path path(alias_iter->second.path(), url.path());
+            return with_file_source_(*t, alias_iter->second.scheme(), path.view(),
+                std::forward<F>(f), std::forward<R>(fallback_result));
+        }
+    private:
+        template < typename F, typename R >
+        static R with_file_source_(const tables& t, str_view scheme, str_view path, F&& f, R&& fallback_result) {
+            const auto scheme_iter = t.schemes.find(scheme);
+            return (scheme_iter != t.schemes.cend() && scheme_iter->second)
                 ? std::invoke(
                     std::forward<F>(f),
                     scheme_iter->second,
-                    resolved_url.path())
+                    path)
                 : std::forward<R>(fallback_result);
         }
+
+        static stdex::jobber_priority to_jobber_priority(vfs::priority priority) noexcept {
+            switch ( priority ) {
+                case vfs::priority::critical: return stdex::jobber_priority::highest;
+                case vfs::priority::normal: return stdex::jobber_priority::normal;
+                case vfs::priority::prefetch: return stdex::jobber_priority::lowest;
+                default:
+                    E2D_ASSERT_MSG(false, "unexpected vfs priority");
+                    return stdex::jobber_priority::normal;
+            }
+        }
     };
 
+    //
+    // vfs::cancellation
+    //
+
+    vfs::cancellation::cancellation()
+    : cancelled_(std::make_shared<std::atomic<bool>>(false)) {}
+
+    vfs::cancellation::cancellation(std::nullptr_t) noexcept {}
+
+    void vfs::cancellation::cancel() noexcept {
+        if ( cancelled_ ) {
+            cancelled_->store(true);
+        }
+    }
+
+    bool vfs::cancellation::cancelled() const noexcept {
+        return cancelled_
+            && cancelled_->load();
+    }
+
+    //
+    // vfs
+    //
+
     vfs::vfs()
-    : state_(new state()){}
+    : vfs(1u) {}
+
+    vfs::vfs(std::size_t io_threads)
+    : state_(new state(io_threads)) {}
+
     vfs::~vfs() noexcept = default;
 
     stdex::jobber& vfs::worker() noexcept {
-        std::lock_guard<std::mutex> guard(state_->mutex);
         return state_->worker;
     }
 
     const stdex::jobber& vfs::worker() const noexcept {
-        std::lock_guard<std::mutex> guard(state_->mutex);
         return state_->worker;
     }
 
+    vfs::io_statistics vfs::io_stats() const noexcept {
+        io_statistics result;
+        result.threads = state_->io_threads;
+        result.queued = state_->io_queued.load();
+        result.active = state_->io_active.load();
+        result.peak_queued = state_->io_peak_queued.load();
+        result.completed = state_->io_completed.load();
+        result.failed = state_->io_failed.load();
+        result.cancelled = state_->io_cancelled.load();
+        result.bytes = state_->io_bytes.load();
+
+        const u64 now_us = time::now_us<u64>().value;
+        const u64 reset_us = state_->io_reset_time_us.load();
+        result.elapsed = now_us > reset_us
+            ? math::numeric_cast<f32>(now_us - reset_us) / 1'000'000.f
+            : 0.f;
+        result.throughput = result.elapsed > 0.f
+            ? math::numeric_cast<f32>(result.bytes) / result.elapsed
+            : 0.f;
+        return result;
+    }
+
+    void vfs::reset_io_stats() noexcept {
+        state_->io_peak_queued.store(state_->io_queued.load());
+        state_->io_completed.store(0u);
+        state_->io_failed.store(0u);
+        state_->io_cancelled.store(0u);
+        state_->io_bytes.store(0u);
+        state_->io_reset_time_us.store(time::now_us<u64>().value);
+    }
+
     bool vfs::register_scheme(str_view scheme, file_source_uptr source) {
+        if ( !source || !source->valid() ) {
+            return false;
+        }
         std::lock_guard<std::mutex> guard(state_->mutex);
-        return (source && source->valid())
-            ? state_->schemes.emplace(scheme, std::move(source)).second
-            : false;
+        return state_->update_tables([scheme, &source](state::tables& t){
+            return t.schemes.emplace(scheme, std::move(source)).second;
+        });
     }
 
     bool vfs::unregister_scheme(str_view scheme) noexcept {
-        std::lock_guard<std::mutex> guard(state_->mutex);
-        const auto iter = state_->schemes.find(scheme);
-        return iter != state_->schemes.end()
-            ? (state_->schemes.erase(iter), true)
-            : false;
+        try {
+            std::lock_guard<std::mutex> guard(state_->mutex);
+            return state_->update_tables([scheme](state::tables& t){
+                const auto iter = t.schemes.find(scheme);
+                return iter != t.schemes.end()
+                    ? (t.schemes.erase(iter), true)
+                    : false;
+            });
+        } catch (...) {
+            return false;
+        }
     }
 
     bool vfs::register_scheme_alias(str_view scheme, url alias) {
         std::lock_guard<std::mutex> guard(state_->mutex);
-        return state_->aliases.emplace(scheme, std::move(alias)).second;
+        return state_->update_tables([scheme, &alias](state::tables& t){
+            return t.aliases.emplace(scheme, std::move(alias)).second
+                && state::resolve_aliases(t);
+        });
     }
 
     bool vfs::unregister_scheme_alias(str_view scheme) noexcept {
-        std::lock_guard<std::mutex> guard(state_->mutex);
-        const auto iter = state_->aliases.find(scheme);
-        return iter != state_->aliases.end()
-            ? (state_->aliases.erase(iter), true)
-            : false;
+        try {
+            std::lock_guard<std::mutex> guard(state_->mutex);
+            return state_->update_tables([scheme](state::tables& t){
+                const auto iter = t.aliases.find(scheme);
+                return iter != t.aliases.end()
+                    ? (t.aliases.erase(iter), state::resolve_aliases(t))
+                    : false;
+            });
+        } catch (...) {
+            return false;
+        }
     }
 
     bool vfs::exists(const url& url) const {
-        std::lock_guard<std::mutex> guard(state_->mutex);
         return state_->with_file_source(url,
-            [](const file_source_uptr& source, const str& path) {
+            [](const state::file_source_ptr& source, str_view path) {
                 return source->exists(path);
             }, false);
     }
 
     input_stream_uptr vfs::read(const url& url) const {
-        std::lock_guard<std::mutex> guard(state_->mutex);
         return state_->with_file_source(url,
-            [](const file_source_uptr& source, const str& path) {
+            [](const state::file_source_ptr& source, str_view path) {
                 return source->read(path);
             }, input_stream_uptr());
     }
 
     output_stream_uptr vfs::write(const url& url, bool append) const {
-        std::lock_guard<std::mutex> guard(state_->mutex);
         return state_->with_file_source(url,
-            [&append](const file_source_uptr& source, const str& path) {
+            [&append](const state::file_source_ptr& source, str_view path) {
                 return source->write(path, append);
             }, output_stream_uptr());
     }
 
     std::optional<buffer> vfs::load(const url& url) const {
-        return load_async(url).then([](auto&& src){
+        return load_async(url, priority::critical).then([](auto&& src){
             return std::optional<buffer>(std::forward<decltype(src)>(src));
         }).get_or_default(std::nullopt);
     }
 
-    stdex::promise<buffer> vfs::load_async(const url& url) const {
-        return state_->worker.async([this, url](){
+    stdex::promise<buffer> vfs::load_async(const url& url, priority priority) const {
+        return load_async(url, priority, cancellation(nullptr));
+    }
+
+    stdex::promise<buffer> vfs::load_async(
+        const url& url,
+        priority priority,
+        const cancellation& token) const
+    {
+        return state_->enqueue(priority, token.cancelled_, [this, url](){
             buffer content;
             const input_stream_uptr stream = read(url);
             if ( !stream || !streams::try_read_tail(content, stream) ) {
@@ -190,13 +643,21 @@ namespace e2d
     }
 
     std::optional<str> vfs::load_as_string(const url& url) const {
-        return load_as_string_async(url).then([](auto&& src){
+        return load_as_string_async(url, priority::critical).then([](auto&& src){
             return std::optional<str>(std::forward<decltype(src)>(src));
         }).get_or_default(std::nullopt);
     }
 
-    stdex::promise<str> vfs::load_as_string_async(const url& url) const {
-        return state_->worker.async([this, url](){
+    stdex::promise<str> vfs::load_as_string_async(const url& url, priority priority) const {
+        return load_as_string_async(url, priority, cancellation(nullptr));
+    }
+
+    stdex::promise<str> vfs::load_as_string_async(
+        const url& url,
+        priority priority,
+        const cancellation& token) const
+    {
+        return state_->enqueue(priority, token.cancelled_, [this, url](){
             str content;
             const input_stream_uptr stream = read(url);
             if ( !stream || !streams::try_read_tail(content, stream) ) {
@@ -206,17 +667,54 @@ namespace e2d
         });
     }
 
+    std::optional<file_view> vfs::load_view(const url& url) const {
+        std::optional<file_view> view = state_->with_file_source(url,
+            [](const state::file_source_ptr& source, str_view path) {
+                return source->view(path);
+            }, std::optional<file_view>());
+        if ( view ) {
+            return view;
+        }
+
+        buffer content;
+        const input_stream_uptr stream = read(url);
+        if ( !stream || !streams::try_read_tail(content, stream) ) {
+            return std::nullopt;
+        }
+        return file_view(std::move(content));
+    }
+
+    stdex::promise<file_view> vfs::load_view_async(const url& url, priority priority) const {
+        return load_view_async(url, priority, cancellation(nullptr));
+    }
+
+    stdex::promise<file_view> vfs::load_view_async(
+        const url& url,
+        priority priority,
+        const cancellation& token) const
+    {
+        return state_->enqueue(priority, token.cancelled_, [this, url](){
+            std::optional<file_view> view = load_view(url);
+            if ( !view ) {
+                throw vfs_load_async_exception();
+            }
+            return std::move(*view);
+        });
+    }
+
     bool vfs::trace(const url& url, filesystem::trace_func func) const {
-        std::lock_guard<std::mutex> guard(state_->mutex);
         return state_->with_file_source(url,
-            [&func](const file_source_uptr& source, const str& path) {
+            [&func](const state::file_source_ptr& source, str_view path) {
                 return source->trace(path, func);
             }, false);
     }
 
     url vfs::resolve_scheme_aliases(const url& url) const {
-        std::lock_guard<std::mutex> guard(state_->mutex);
-        return state_->resolve_url(url);
+        const state::tables_ptr t = state_->load_tables();
+        const auto alias_iter = t->resolved_aliases.find(url.scheme());
+        return alias_iter != t->resolved_aliases.cend()
+            ? alias_iter->second / url.path()
+            : url;
     }
 
     //
@@ -225,24 +723,93 @@ namespace e2d
 
     class archive_file_source::state final : private e2d::noncopyable {
     public:
+        // streams of different files can be read from several vfs threads
+        struct source final {
+            std::mutex mutex;
+            input_stream_uptr stream;
+        };
         using archive_ptr = std::shared_ptr<mz_zip_archive>;
-        using stream_ptr = std::shared_ptr<input_stream>;
-        archive_ptr archive;
+        using stream_ptr = std::shared_ptr<source>;
+        using content_ptr = std::shared_ptr<const buffer>;
         stream_ptr stream;
+        archive_ptr archive;
     public:
-        state(input_stream_uptr nstream)
-        : archive(open_archive_(nstream))
-        , stream(std::move(nstream)) {}
+        state(input_stream_uptr nstream, std::size_t ncache_capacity)
+        : stream(open_source_(std::move(nstream)))
+        , archive(open_archive_(stream))
+        , cache_capacity_(ncache_capacity) {}
         ~state() noexcept = default;
+
+        content_ptr find_cached(u32 index) noexcept {
+            std::lock_guard<std::mutex> guard(cache_mutex_);
+            const auto iter = cache_.find(index);
+            if ( iter == cache_.end() ) {
+                ++cache_stats_.misses;
+                return nullptr;
+            }
+            ++cache_stats_.hits;
+            iter->second.last_use = ++cache_tick_;
+            return iter->second.content;
+        }
+
+        void add_cached(u32 index, const content_ptr& content) {
+            std::lock_guard<std::mutex> guard(cache_mutex_);
+            if ( content->size() > cache_capacity_ || cache_.count(index) ) {
+                return;
+            }
+            while ( cache_size_ + content->size() > cache_capacity_ ) {
+                const auto lru = std::min_element(cache_.begin(), cache_.end(),
+                    [](const auto& l, const auto& r) noexcept {
+                        return l.second.last_use < r.second.last_use;
+                    });
+                cache_size_ -= lru->second.content->size();
+                cache_.erase(lru);
+            }
+            cache_.emplace(index, cache_entry{content, ++cache_tick_});
+            cache_size_ += content->size();
+        }
+
+        bool cacheable(u64 size) const noexcept {
+            return size <= cache_capacity_;
+        }
+
+        archive_file_source::cache_statistics cache_stats() const noexcept {
+            std::lock_guard<std::mutex> guard(cache_mutex_);
+            archive_file_source::cache_statistics result = cache_stats_;
+            result.capacity = cache_capacity_;
+            result.size = cache_size_;
+            result.entries = cache_.size();
+            return result;
+        }
     private:
-        static archive_ptr open_archive_(const input_stream_uptr& stream) noexcept {
+        struct cache_entry final {
+            content_ptr content;
+            u64 last_use{0u};
+        };
+        mutable std::mutex cache_mutex_;
+        hash_map<u32, cache_entry> cache_;
+        std::size_t cache_size_{0u};
+        std::size_t cache_capacity_{0u};
+        u64 cache_tick_{0u};
+        archive_file_source::cache_statistics cache_stats_;
+    private:
+        static stream_ptr open_source_(input_stream_uptr stream) {
+            if ( !stream ) {
+                return stream_ptr();
+            }
+            auto result = std::make_shared<source>();
+            result->stream = std::move(stream);
+            return result;
+        }
+
+        static archive_ptr open_archive_(const stream_ptr& stream) noexcept {
             if ( stream ) {
                 mz_zip_archive* archive = static_cast<mz_zip_archive*>(
                     std::calloc(1, sizeof(mz_zip_archive)));
                 if ( archive ) {
                     archive->m_pRead = archive_reader_;
                     archive->m_pIO_opaque = stream.get();
-                    if ( mz_zip_reader_init(archive, stream->length(), 0) ) {
+                    if ( mz_zip_reader_init(archive, stream->stream->length(), 0) ) {
                         return archive_ptr(archive, archive_deleter_);
                     }
                     std::free(archive);
@@ -259,8 +826,9 @@ namespace e2d
         }
 
         static size_t archive_reader_(void* opaque, mz_uint64 pos, void* dst, size_t size) noexcept {
-            input_stream* stream = static_cast<input_stream*>(opaque);
-            return input_sequence(*stream)
+            source* src = static_cast<source*>(opaque);
+            std::lock_guard<std::mutex> guard(src->mutex);
+            return input_sequence(*src->stream)
                 .seek(math::numeric_cast<std::ptrdiff_t>(pos), false)
                 .read(dst, size)
                 .success() ? size : 0;
@@ -268,7 +836,10 @@ namespace e2d
     };
 
     archive_file_source::archive_file_source(input_stream_uptr stream)
-    : state_(new state(std::move(stream))) {}
+    : archive_file_source(std::move(stream), archive_default_cache_capacity) {}
+
+    archive_file_source::archive_file_source(input_stream_uptr stream, std::size_t cache_capacity)
+    : state_(new state(std::move(stream), cache_capacity)) {}
     archive_file_source::~archive_file_source() noexcept = default;
 
     bool archive_file_source::valid() const noexcept {
@@ -289,15 +860,56 @@ namespace e2d
                 state::archive_ptr archive;
                 state::stream_ptr stream;
             } owned_state{state_->archive, state_->stream};
+
+            mz_zip_archive* archive = state_->archive.get();
+            const str filename = make_utf8(path);
+
+            mz_uint32 index = 0;
+            mz_zip_archive_file_stat stat;
+            if ( !mz_zip_reader_locate_file_v2(
+                    archive, filename.c_str(), nullptr, MZ_ZIP_FLAG_CASE_SENSITIVE, &index)
+                || !mz_zip_reader_file_stat(archive, index, &stat) )
+            {
+                return nullptr;
+            }
+
+            if ( const auto offset = find_stored_data_offset(archive, stat) ) {
+                return std::make_unique<archive_stored_stream<owned_state_t>>(
+                    std::move(owned_state),
+                    archive,
+                    *offset,
+                    math::numeric_cast<std::size_t>(stat.m_uncomp_size));
+            }
+
+            if ( !stat.m_is_directory && stat.m_uncomp_size > 0u && state_->cacheable(stat.m_uncomp_size) ) {
+                state::content_ptr content = state_->find_cached(index);
+                if ( !content ) {
+                    buffer decompressed(math::numeric_cast<std::size_t>(stat.m_uncomp_size));
+                    if ( !mz_zip_reader_extract_to_mem(
+                        archive, index, decompressed.data(), decompressed.size(), 0) )
+                    {
+                        return nullptr;
+                    }
+                    content = std::make_shared<buffer>(std::move(decompressed));
+                    state_->add_cached(index, content);
+                }
+                const buffer_view data(*content);
+                return std::make_unique<shared_view_stream>(std::move(content), data);
+            }
+
             return std::make_unique<archive_stream<owned_state_t>>(
                 std::move(owned_state),
-                state_->archive.get(),
-                make_utf8(path).c_str());
+                archive,
+                filename.c_str());
         } catch (...) {
             return nullptr;
         }
     }
 
+    archive_file_source::cache_statistics archive_file_source::cache_stats() const noexcept {
+        return state_->cache_stats();
+    }
+
     output_stream_uptr archive_file_source::write(str_view path, bool append) const {
         E2D_UNUSED(path, append);
         return nullptr;
@@ -343,6 +955,338 @@ namespace e2d
         return true;
     }
 
+    //
+    // bundle_file_source
+    //
+
+    class bundle_file_source::state final : private e2d::noncopyable {
+    public:
+        std::shared_ptr<mapped_file> file;
+        const bundle_entry* entries{nullptr};
+        std::size_t entry_count{0u};
+        const char* names{nullptr};
+    public:
+        state(mapped_file_uptr nfile)
+        : file(std::move(nfile)) {
+            if ( !file || !parse_() ) {
+                file.reset();
+            }
+        }
+        ~state() noexcept = default;
+
+        const bundle_entry* find(str_view path) const noexcept {
+            const u32 hash = utils::sdbm_hash(path);
+            const bundle_entry* const end = entries + entry_count;
+            const bundle_entry* iter = std::lower_bound(entries, end, hash,
+                [](const bundle_entry& l, u32 r) noexcept {
+                    return l.hash < r;
+                });
+            for ( ; iter != end && iter->hash == hash; ++iter ) {
+                if ( name(*iter) == path ) {
+                    return iter;
+                }
+            }
+            return nullptr;
+        }
+
+        str_view name(const bundle_entry& entry) const noexcept {
+            return str_view(names + entry.name_offset, entry.name_size);
+        }
+
+        buffer_view data(const bundle_entry& entry) const noexcept {
+            return buffer_view(
+                static_cast<const u8*>(file->data()) + entry.offset,
+                entry.packed_size);
+        }
+    private:
+        bool parse_() noexcept {
+            const u8* data = static_cast<const u8*>(file->data());
+            const std::size_t size = file->size();
+
+            if ( size < sizeof(bundle_header) ) {
+                return false;
+            }
+
+            const bundle_header* header = reinterpret_cast<const bundle_header*>(data);
+            if ( header->magic != bundle_magic || header->version != bundle_version ) {
+                return false;
+            }
+
+            const u64 index_end = sizeof(bundle_header)
+                + u64(header->entry_count) * sizeof(bundle_entry);
+            if ( index_end > size
+                || header->names_offset < index_end
+                || header->names_offset > size
+                || header->names_size > size - header->names_offset )
+            {
+                return false;
+            }
+
+            entries = reinterpret_cast<const bundle_entry*>(data + sizeof(bundle_header));
+            entry_count = header->entry_count;
+            names = reinterpret_cast<const char*>(data + header->names_offset);
+
+            for ( std::size_t i = 0; i < entry_count; ++i ) {
+                const bundle_entry& entry = entries[i];
+                if ( entry.name_offset > header->names_size
+                    || entry.name_size > header->names_size - entry.name_offset )
+                {
+                    return false;
+                }
+                if ( entry.offset % bundle_alignment != 0u
+                    || entry.offset > size
+                    || entry.packed_size > size - entry.offset )
+                {
+                    return false;
+                }
+                if ( !(entry.flags & bundle_entry_compressed) && entry.packed_size != entry.size ) {
+                    return false;
+                }
+                if ( i > 0u && entries[i - 1u].hash > entry.hash ) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    };
+
+    bundle_file_source::bundle_file_source(mapped_file_uptr file)
+    : state_(new state(std::move(file))) {}
+    bundle_file_source::~bundle_file_source() noexcept = default;
+
+    bool bundle_file_source::valid() const noexcept {
+        return !!state_->file;
+    }
+
+    bool bundle_file_source::exists(str_view path) const {
+        return valid()
+            && state_->find(path);
+    }
+
+    input_stream_uptr bundle_file_source::read(str_view path) const {
+        const bundle_entry* entry = valid()
+            ? state_->find(path)
+            : nullptr;
+
+        if ( !entry ) {
+            return nullptr;
+        }
+
+        if ( !(entry->flags & bundle_entry_compressed) ) {
+            return std::make_unique<shared_view_stream>(
+                state_->file,
+                state_->data(*entry));
+        }
+
+        try {
+            const buffer_view packed = state_->data(*entry);
+            buffer content(entry->size);
+            mz_ulong content_size = entry->size;
+            if ( MZ_OK != mz_uncompress(
+                content.data(),
+                &content_size,
+                static_cast<const unsigned char*>(packed.data()),
+                math::numeric_cast<mz_ulong>(packed.size())) )
+            {
+                return nullptr;
+            }
+            if ( content_size != entry->size ) {
+                return nullptr;
+            }
+            return make_memory_stream(std::move(content));
+        } catch (...) {
+            return nullptr;
+        }
+    }
+
+    output_stream_uptr bundle_file_source::write(str_view path, bool append) const {
+        E2D_UNUSED(path, append);
+        return nullptr;
+    }
+
+    bool bundle_file_source::trace(str_view path, filesystem::trace_func func) const {
+        if ( !valid() ) {
+            return false;
+        }
+
+        str parent = make_utf8(path);
+        if ( !parent.empty() && parent.back() != '/' ) {
+            parent += '/';
+        }
+
+        // bundles have no directory entries, only files are traced
+        bool found = parent.empty();
+        for ( std::size_t i = 0; i < state_->entry_count; ++i ) {
+            const str_view filename = state_->name(state_->entries[i]);
+            if ( filename.size() > parent.size() && strings::starts_with(filename, parent) ) {
+                found = true;
+                if ( !func(filename, false) ) {
+                    return false;
+                }
+            }
+        }
+
+        return found;
+    }
+
+    std::optional<file_view> bundle_file_source::view(str_view path) const {
+        const bundle_entry* entry = valid()
+            ? state_->find(path)
+            : nullptr;
+        if ( !entry || (entry->flags & bundle_entry_compressed) ) {
+            return std::nullopt;
+        }
+        return file_view(state_->file, state_->data(*entry));
+    }
+
+    //
+    // bundle_builder
+    //
+
+    bundle_builder& bundle_builder::add_file(str path, buffer content, bool compress) {
+        const auto iter = std::find_if(files_.begin(), files_.end(), [&path](const file& f){
+            return f.path == path;
+        });
+        if ( iter != files_.end() ) {
+            iter->content = std::move(content);
+            iter->compress = compress;
+        } else {
+            files_.push_back({std::move(path), std::move(content), compress});
+        }
+        return *this;
+    }
+
+    bool bundle_builder::add_directory(str_view directory, bool compress) {
+        vector<str> filenames;
+        const bool traced = filesystem::trace_directory_recursive(directory,
+            [&filenames](str_view relative, bool is_directory){
+                if ( !is_directory ) {
+                    filenames.emplace_back(relative);
+                }
+                return true;
+            });
+
+        if ( !traced ) {
+            return false;
+        }
+
+        for ( str& filename : filenames ) {
+            buffer content;
+            if ( !filesystem::try_read_all(content, path::combine(directory, filename)) ) {
+                return false;
+            }
+            std::replace(filename.begin(), filename.end(), '\\', '/');
+            add_file(std::move(filename), std::move(content), compress);
+        }
+
+        return true;
+    }
+
+    bool bundle_builder::write(output_stream& stream) const {
+        struct packed_file final {
+            const file* source{nullptr};
+            bundle_entry entry;
+            buffer packed;
+        };
+
+        vector<packed_file> packed_files;
+        packed_files.reserve(files_.size());
+
+        for ( const file& f : files_ ) {
+            packed_file pf;
+            pf.source = &f;
+            pf.entry.hash = utils::sdbm_hash(str_view(f.path));
+            pf.entry.name_size = math::numeric_cast<u32>(f.path.size());
+            pf.entry.size = math::numeric_cast<u32>(f.content.size());
+            pf.entry.packed_size = pf.entry.size;
+
+            if ( f.compress && !f.content.empty() ) {
+                mz_ulong packed_size = mz_compressBound(
+                    math::numeric_cast<mz_ulong>(f.content.size()));
+                buffer packed(packed_size);
+                if ( MZ_OK == mz_compress2(
+                    packed.data(),
+                    &packed_size,
+                    f.content.data(),
+                    math::numeric_cast<mz_ulong>(f.content.size()),
+                    MZ_BEST_COMPRESSION) && packed_size < f.content.size() )
+                {
+                    packed.resize(packed_size);
+                    pf.packed = std::move(packed);
+                    pf.entry.flags |= bundle_entry_compressed;
+                    pf.entry.packed_size = math::numeric_cast<u32>(packed_size);
+                }
+            }
+
+            packed_files.push_back(std::move(pf));
+        }
+
+        std::sort(packed_files.begin(), packed_files.end(),
+            [](const packed_file& l, const packed_file& r) noexcept {
+                return l.entry.hash != r.entry.hash
+                    ? l.entry.hash < r.entry.hash
+                    : l.source->path < r.source->path;
+            });
+
+        bundle_header header;
+        header.entry_count = math::numeric_cast<u32>(packed_files.size());
+        header.names_offset = sizeof(bundle_header) + packed_files.size() * sizeof(bundle_entry);
+
+        for ( packed_file& pf : packed_files ) {
+            pf.entry.name_offset = header.names_size;
+            header.names_size += pf.entry.name_size;
+        }
+
+        header.data_offset = bundle_align(header.names_offset + header.names_size);
+
+        u64 data_offset = header.data_offset;
+        for ( packed_file& pf : packed_files ) {
+            pf.entry.offset = data_offset;
+            data_offset = bundle_align(data_offset + pf.entry.packed_size);
+        }
+
+        static const u8 padding[bundle_alignment] = {0};
+        output_sequence seq(stream);
+
+        seq.write(&header, sizeof(header));
+        for ( const packed_file& pf : packed_files ) {
+            seq.write(&pf.entry, sizeof(pf.entry));
+        }
+        for ( const packed_file& pf : packed_files ) {
+            seq.write_all(pf.source->path);
+        }
+
+        u64 offset = header.names_offset + header.names_size;
+        for ( const packed_file& pf : packed_files ) {
+            seq.write(padding, math::numeric_cast<std::size_t>(pf.entry.offset - offset));
+            if ( pf.entry.flags & bundle_entry_compressed ) {
+                seq.write_all(pf.packed);
+            } else {
+                seq.write_all(pf.source->content);
+            }
+            offset = pf.entry.offset + pf.entry.packed_size;
+        }
+
+        return seq
+            .flush()
+            .success();
+    }
+
+    bool bundle_builder::write(str_view path) const {
+        const output_stream_uptr stream = make_write_file(path, false);
+        return stream
+            && write(*stream);
+    }
+
+    bool bundle_builder::empty() const noexcept {
+        return files_.empty();
+    }
+
+    std::size_t bundle_builder::size() const noexcept {
+        return files_.size();
+    }
+
     //
     // filesystem_file_source
     //
@@ -372,4 +1316,12 @@ namespace e2d
     bool filesystem_file_source::trace(str_view path, filesystem::trace_func func) const {
         return filesystem::trace_directory_recursive(path, func);
     }
+
+    std::optional<file_view> filesystem_file_source::view(str_view path) const {
+        mapped_file_uptr file = make_mapped_file(path);
+        if ( !file ) {
+            return std::nullopt;
+        }
+        return file_view(std::shared_ptr<const mapped_file>(std::move(file)));
+    }
 }
@@ -0,0 +1,470 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/high/asset_manifest.hpp>
+
+#include <enduro2d/high/library.hpp>
+
+#include <enduro2d/high/assets/atlas_asset.hpp>
+#include <enduro2d/high/assets/binary_asset.hpp>
+#include <enduro2d/high/assets/flipbook_asset.hpp>
+#include <enduro2d/high/assets/font_asset.hpp>
+#include <enduro2d/high/assets/image_asset.hpp>
+#include <enduro2d/high/assets/json_asset.hpp>
+#include <enduro2d/high/assets/material_asset.hpp>
+#include <enduro2d/high/assets/mesh_asset.hpp>
+#include <enduro2d/high/assets/model_asset.hpp>
+#include <enduro2d/high/assets/prefab_asset.hpp>
+#include <enduro2d/high/assets/shader_asset.hpp>
+#include <enduro2d/high/assets/shape_asset.hpp>
+#include <enduro2d/high/assets/sound_asset.hpp>
+#include <enduro2d/high/assets/sprite_asset.hpp>
+#include <enduro2d/high/assets/text_asset.hpp>
+#include <enduro2d/high/assets/texture_asset.hpp>
+#include <enduro2d/high/assets/xml_asset.hpp>
+
+#include <3rdparty/rapidjson/writer.h>
+#include <3rdparty/rapidjson/stringbuffer.h>
+
+namespace
+{
+    using namespace e2d;
+
+    using preload_result = std::pair<str, asset_ptr>;
+
+    template < typename Asset >
+    stdex::promise<asset_ptr> load_manifest_asset(
+        const library& library,
+        str_view address,
+        vfs::priority priority)
+    {
+        return library.load_main_asset_async<Asset>(address, priority)
+        .then([](const typename Asset::load_result& asset){
+            return asset_ptr(asset);
+        });
+    }
+
+    struct manifest_loader {
+        const char* type;
+        stdex::promise<asset_ptr>(*load)(const library&, str_view, vfs::priority);
+    };
+
+    const manifest_loader manifest_loaders[] = {
+        {atlas_asset::type_name(), &load_manifest_asset<atlas_asset>},
+        {binary_asset::type_name(), &load_manifest_asset<binary_asset>},
+        {flipbook_asset::type_name(), &load_manifest_asset<flipbook_asset>},
+        {font_asset::type_name(), &load_manifest_asset<font_asset>},
+        {image_asset::type_name(), &load_manifest_asset<image_asset>},
+        {json_asset::type_name(), &load_manifest_asset<json_asset>},
+        {material_asset::type_name(), &load_manifest_asset<material_asset>},
+        {mesh_asset::type_name(), &load_manifest_asset<mesh_asset>},
+        {model_asset::type_name(), &load_manifest_asset<model_asset>},
+        {prefab_asset::type_name(), &load_manifest_asset<prefab_asset>},
+        {shader_asset::type_name(), &load_manifest_asset<shader_asset>},
+        {shape_asset::type_name(), &load_manifest_asset<shape_asset>},
+        {sound_asset::type_name(), &load_manifest_asset<sound_asset>},
+        {sprite_asset::type_name(), &load_manifest_asset<sprite_asset>},
+        {text_asset::type_name(), &load_manifest_asset<text_asset>},
+        {texture_asset::type_name(), &load_manifest_asset<texture_asset>},
+        {xml_asset::type_name(), &load_manifest_asset<xml_asset>}};
+
+    const manifest_loader* find_manifest_loader(str_view type) noexcept {
+        const auto iter = std::find_if(
+            std::begin(manifest_loaders), std::end(manifest_loaders),
+            [type](const manifest_loader& l) noexcept {
+                return type == l.type;
+            });
+        return iter != std::end(manifest_loaders)
+            ? iter
+            : nullptr;
+    }
+
+    const char* priority_to_cstr(vfs::priority priority) noexcept {
+        switch ( priority ) {
+            case vfs::priority::critical: return "critical";
+            case vfs::priority::normal: return "normal";
+            case vfs::priority::prefetch: return "prefetch";
+            default:
+                E2D_ASSERT_MSG(false, "unexpected vfs priority");
+                return "normal";
+        }
+    }
+
+    bool try_parse_priority(str_view src, vfs::priority& dst) noexcept {
+        if ( src == "critical" ) {
+            dst = vfs::priority::critical;
+        } else if ( src == "normal" ) {
+            dst = vfs::priority::normal;
+        } else if ( src == "prefetch" ) {
+            dst = vfs::priority::prefetch;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    // dependencies before their owners, the manifest order for the rest
+    vector<std::size_t> sort_preload_order(
+        const vector<asset_manifest::entry>& entries,
+        vector<vfs::priority>& priorities)
+    {
+        hash_multimap<str_view, std::size_t> entries_by_address;
+        for ( std::size_t i = 0; i < entries.size(); ++i ) {
+            entries_by_address.emplace(entries[i].address, i);
+        }
+
+        vector<std::size_t> dependency_counts(entries.size(), 0u);
+        vector<vector<std::size_t>> owners(entries.size());
+        for ( std::size_t i = 0; i < entries.size(); ++i ) {
+            for ( const str& dependency : entries[i].dependencies ) {
+                const auto [first, last] = entries_by_address.equal_range(dependency);
+                for ( auto iter = first; iter != last; ++iter ) {
+                    if ( iter->second != i ) {
+                        owners[iter->second].push_back(i);
+                        ++dependency_counts[i];
+                    }
+                }
+            }
+        }
+
+        vector<std::size_t> order;
+        order.reserve(entries.size());
+
+        vector<bool> ordered(entries.size(), false);
+        while ( order.size() < entries.size() ) {
+            const std::size_t first_free = order.size();
+            for ( std::size_t i = 0; i < entries.size(); ++i ) {
+                if ( !ordered[i] && !dependency_counts[i] ) {
+                    ordered[i] = true;
+                    order.push_back(i);
+                }
+            }
+            if ( first_free == order.size() ) {
+                // dependency cycle, the rest keeps the manifest order
+                for ( std::size_t i = 0; i < entries.size(); ++i ) {
+                    if ( !ordered[i] ) {
+                        ordered[i] = true;
+                        order.push_back(i);
+                    }
+                }
+                break;
+            }
+            for ( std::size_t i = first_free; i < order.size(); ++i ) {
+                for ( std::size_t owner : owners[order[i]] ) {
+                    --dependency_counts[owner];
+                }
+            }
+        }
+
+        priorities.resize(entries.size());
+        for ( std::size_t i = 0; i < entries.size(); ++i ) {
+            priorities[i] = entries[i].priority;
+        }
+
+        // owners are after their dependencies, so the reverse pass is enough
+        for ( auto iter = order.rbegin(); iter != order.rend(); ++iter ) {
+            for ( const str& dependency : entries[*iter].dependencies ) {
+                const auto [first, last] = entries_by_address.equal_range(dependency);
+                for ( auto dep_iter = first; dep_iter != last; ++dep_iter ) {
+                    priorities[dep_iter->second] = std::min(
+                        priorities[dep_iter->second],
+                        priorities[*iter]);
+                }
+            }
+        }
+
+        std::stable_sort(order.begin(), order.end(), [&priorities](std::size_t l, std::size_t r){
+            return priorities[l] < priorities[r];
+        });
+
+        return order;
+    }
+
+    class preload_state final : private noncopyable {
+    public:
+        preload_state(asset_manifest::progress_callback callback)
+        : callback_(std::move(callback)) {}
+
+        void start(u64 total_bytes, std::size_t total_assets) {
+            std::lock_guard<std::mutex> guard(mutex_);
+            progress_.total_bytes = total_bytes;
+            progress_.total_assets = total_assets;
+            notify_();
+        }
+
+        void finish(u64 bytes, bool loaded) {
+            std::lock_guard<std::mutex> guard(mutex_);
+            progress_.finished_bytes += bytes;
+            if ( loaded ) {
+                ++progress_.loaded_assets;
+            } else {
+                ++progress_.failed_assets;
+            }
+            notify_();
+        }
+    private:
+        void notify_() {
+            if ( callback_ ) {
+                callback_(progress_);
+            }
+        }
+    private:
+        std::mutex mutex_;
+        asset_manifest::progress progress_;
+        asset_manifest::progress_callback callback_;
+    };
+
+    stdex::promise<preload_result> preload_entry(
+        const library& library,
+        const asset_manifest::entry& entry,
+        vfs::priority priority,
+        const std::shared_ptr<preload_state>& state)
+    {
+        const manifest_loader* loader = find_manifest_loader(entry.type);
+        if ( !loader ) {
+            the<debug>().warning("LIBRARY: Unknown manifest asset type:\n"
+                "--> Type: %0\n"
+                "--> Address: %1",
+                entry.type,
+                entry.address);
+            state->finish(entry.size, false);
+            return stdex::make_resolved_promise(preload_result(entry.address, nullptr));
+        }
+
+        return loader->load(library, entry.address, priority)
+        .then([
+            state,
+            address = entry.address,
+            size = entry.size
+        ](const asset_ptr& asset){
+            state->finish(size, true);
+            return preload_result(address, asset);
+        })
+        .except([
+            state,
+            address = entry.address,
+            size = entry.size
+        ](std::exception_ptr){
+            // the library has already reported the failure
+            state->finish(size, false);
+            return preload_result(address, nullptr);
+        });
+    }
+
+    void add_preload_results(asset_group& group, const vector<preload_result>& results) {
+        for ( const preload_result& r : results ) {
+            if ( r.second ) {
+                group.add_asset(r.first, r.second);
+            }
+        }
+    }
+}
+
+namespace e2d
+{
+    asset_manifest& asset_manifest::add_entry(entry e) {
+        const auto iter = std::find_if(entries_.begin(), entries_.end(), [&e](const entry& o){
+            return o.type == e.type && o.address == e.address;
+        });
+        if ( iter != entries_.end() ) {
+            *iter = std::move(e);
+        } else {
+            entries_.push_back(std::move(e));
+        }
+        return *this;
+    }
+
+    asset_manifest& asset_manifest::clear() noexcept {
+        entries_.clear();
+        return *this;
+    }
+
+    bool asset_manifest::empty() const noexcept {
+        return entries_.empty();
+    }
+
+    std::size_t asset_manifest::size() const noexcept {
+        return entries_.size();
+    }
+
+    u64 asset_manifest::total_size() const noexcept {
+        return std::accumulate(entries_.begin(), entries_.end(), u64(0),
+            [](u64 acc, const entry& e) noexcept {
+                return acc + e.size;
+            });
+    }
+
+    const vector<asset_manifest::entry>& asset_manifest::entries() const noexcept {
+        return entries_;
+    }
+
+    stdex::promise<asset_group> asset_manifest::preload_async(
+        const library& library,
+        progress_callback callback) const
+    {
+        auto state = std::make_shared<preload_state>(std::move(callback));
+        state->start(total_size(), entries_.size());
+
+        vector<vfs::priority> priorities;
+        const vector<std::size_t> order = sort_preload_order(entries_, priorities);
+
+        vector<stdex::promise<preload_result>> urgent_p;
+        vector<entry> prefetch_entries;
+        for ( std::size_t index : order ) {
+            if ( priorities[index] == vfs::priority::prefetch ) {
+                prefetch_entries.push_back(entries_[index]);
+            } else {
+                urgent_p.push_back(preload_entry(
+                    library, entries_[index], priorities[index], state));
+            }
+        }
+
+        return stdex::make_all_promise(std::move(urgent_p))
+        .then([
+            &library,
+            state,
+            prefetch_entries = std::move(prefetch_entries)
+        ](const vector<preload_result>& urgent_results){
+            vector<stdex::promise<preload_result>> prefetch_p;
+            prefetch_p.reserve(prefetch_entries.size());
+            for ( const entry& e : prefetch_entries ) {
+                prefetch_p.push_back(preload_entry(
+                    library, e, vfs::priority::prefetch, state));
+            }
+            return stdex::make_all_promise(std::move(prefetch_p))
+            .then([urgent_results](const vector<preload_result>& prefetch_results){
+                asset_group group;
+                add_preload_results(group, urgent_results);
+                add_preload_results(group, prefetch_results);
+                return group;
+            });
+        });
+    }
+
+    bool asset_manifest::is_known_type(str_view type) noexcept {
+        return !!find_manifest_loader(type);
+    }
+}
+
+namespace e2d::asset_manifests
+{
+    bool try_load_manifest(
+        asset_manifest& dst,
+        buffer_view src) noexcept
+    {
+        try {
+            rapidjson::Document doc;
+            if ( json_utils::is_binary_json(src) ) {
+                if ( !json_utils::try_load_binary_json(doc, src) ) {
+                    return false;
+                }
+            } else if ( doc.Parse(static_cast<const char*>(src.data()), src.size()).HasParseError() ) {
+                return false;
+            }
+
+            if ( !doc.IsObject() || !doc.HasMember("assets") || !doc["assets"].IsArray() ) {
+                return false;
+            }
+
+            asset_manifest manifest;
+            for ( const rapidjson::Value& asset_json : doc["assets"].GetArray() ) {
+                if ( !asset_json.IsObject() ) {
+                    return false;
+                }
+
+                asset_manifest::entry e;
+
+                if ( !asset_json.HasMember("type")
+                    || !json_utils::try_parse_value(asset_json["type"], e.type) )
+                {
+                    return false;
+                }
+
+                if ( !asset_json.HasMember("address")
+                    || !json_utils::try_parse_value(asset_json["address"], e.address) )
+                {
+                    return false;
+                }
+
+                if ( asset_json.HasMember("size") ) {
+                    if ( !asset_json["size"].IsUint64() ) {
+                        return false;
+                    }
+                    e.size = asset_json["size"].GetUint64();
+                }
+
+                if ( asset_json.HasMember("priority") ) {
+                    if ( !asset_json["priority"].IsString()
+                        || !try_parse_priority(asset_json["priority"].GetString(), e.priority) )
+                    {
+                        return false;
+                    }
+                }
+
+                if ( asset_json.HasMember("dependencies") ) {
+                    const rapidjson::Value& dependencies_json = asset_json["dependencies"];
+                    if ( !dependencies_json.IsArray() ) {
+                        return false;
+                    }
+                    e.dependencies.reserve(dependencies_json.Size());
+                    for ( const rapidjson::Value& dependency_json : dependencies_json.GetArray() ) {
+                        str dependency;
+                        if ( !json_utils::try_parse_value(dependency_json, dependency) ) {
+                            return false;
+                        }
+                        e.dependencies.push_back(std::move(dependency));
+                    }
+                }
+
+                manifest.add_entry(std::move(e));
+            }
+
+            dst = std::move(manifest);
+            return true;
+        } catch (...) {
+            return false;
+        }
+    }
+
+    bool try_save_manifest(
+        const asset_manifest& src,
+        buffer& dst) noexcept
+    {
+        try {
+            rapidjson::StringBuffer sb;
+            rapidjson::Writer<rapidjson::StringBuffer> writer(sb);
+
+            writer.StartObject();
+            writer.Key("assets");
+            writer.StartArray();
+            for ( const asset_manifest::entry& e : src.entries() ) {
+                writer.StartObject();
+                writer.Key("type");
+                writer.String(e.type.c_str(), math::numeric_cast<rapidjson::SizeType>(e.type.size()));
+                writer.Key("address");
+                writer.String(e.address.c_str(), math::numeric_cast<rapidjson::SizeType>(e.address.size()));
+                writer.Key("size");
+                writer.Uint64(e.size);
+                writer.Key("priority");
+                writer.String(priority_to_cstr(e.priority));
+                writer.Key("dependencies");
+                writer.StartArray();
+                for ( const str& dependency : e.dependencies ) {
+                    writer.String(dependency.c_str(), math::numeric_cast<rapidjson::SizeType>(dependency.size()));
+                }
+                writer.EndArray();
+                writer.EndObject();
+            }
+            writer.EndArray();
+            writer.EndObject();
+
+            dst.assign(sb.GetString(), sb.GetSize());
+            return true;
+        } catch (...) {
+            return false;
+        }
+    }
+}
@@ -167,16 +167,25 @@ namespace
 
 namespace e2d
 {
+    const rapidjson::SchemaDocument& atlas_asset::json_schema() {
+        return atlas_asset_schema();
+    }
+
     atlas_asset::load_async_result atlas_asset::load_async(
-        const library& library, str_view address)
+        const library& library, str_view address, vfs::priority priority)
     {
-        return library.load_asset_async<json_asset>(address)
+        return library.load_asset_async<json_asset>(address, priority)
         .then([
             &library,
             address = str(address),
             parent_address = path::parent_path(address)
         ](const json_asset::load_result& atlas_data){
             return the<deferrer>().do_in_worker_thread([address, atlas_data](){
+                if ( atlas_data->validated_for() == atlas_asset::type_name() ) {
+                    // validated by e2d_cook
+                    return;
+                }
+
                 const rapidjson::Document& doc = *atlas_data->content();
                 rapidjson::SchemaValidator validator(atlas_asset_schema());
 
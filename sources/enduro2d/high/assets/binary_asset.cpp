@@ -20,13 +20,21 @@ namespace
 namespace e2d
 {
     binary_asset::load_async_result binary_asset::load_async(
-        const library& library, str_view address)
+        const library& library, str_view address, vfs::priority priority)
     {
         const auto asset_url = library.root() / address;
-        return the<vfs>().load_async(asset_url)
-        .then([](auto&& content){
+        return the<vfs>().load_async(asset_url, priority)
+        .then([
+            &library,
+            address = str(address)
+        ](auto&& content){
+            library.register_source_size(address, content.size());
             return binary_asset::create(
                 std::forward<decltype(content)>(content));
         });
     }
+
+    asset_size binary_asset::estimated_size() const noexcept {
+        return {sizeof(binary_asset) + content().size(), 0u};
+    }
 }
@@ -205,16 +205,25 @@ namespace
 
 namespace e2d
 {
+    const rapidjson::SchemaDocument& flipbook_asset::json_schema() {
+        return flipbook_asset_schema();
+    }
+
     flipbook_asset::load_async_result flipbook_asset::load_async(
-        const library& library, str_view address)
+        const library& library, str_view address, vfs::priority priority)
     {
-        return library.load_asset_async<json_asset>(address)
+        return library.load_asset_async<json_asset>(address, priority)
         .then([
             &library,
             address = str(address),
             parent_address = path::parent_path(address)
         ](const json_asset::load_result& flipbook_data){
             return the<deferrer>().do_in_worker_thread([address, flipbook_data](){
+                if ( flipbook_data->validated_for() == flipbook_asset::type_name() ) {
+                    // validated by e2d_cook
+                    return;
+                }
+
                 const rapidjson::Document& doc = *flipbook_data->content();
                 rapidjson::SchemaValidator validator(flipbook_asset_schema());
 
@@ -23,9 +23,9 @@ namespace
 namespace e2d
 {
     font_asset::load_async_result font_asset::load_async(
-        const library& library, str_view address)
+        const library& library, str_view address, vfs::priority priority)
     {
-        return library.load_asset_async<binary_asset>(address)
+        return library.load_asset_async<binary_asset>(address, priority)
         .then([
             address = str(address)
         ](const binary_asset::load_result& font_data){
@@ -5,7 +5,6 @@
  ******************************************************************************/
 
 #include <enduro2d/high/assets/image_asset.hpp>
-#include <enduro2d/high/assets/binary_asset.hpp>
 
 namespace
 {
@@ -21,22 +20,29 @@ namespace
 namespace e2d
 {
     image_asset::load_async_result image_asset::load_async(
-        const library& library, str_view address)
+        const library& library, str_view address, vfs::priority priority)
     {
-        return library.load_asset_async<binary_asset>(address)
+        const auto asset_url = library.root() / address;
+        return the<vfs>().load_view_async(asset_url, priority)
         .then([
+            &library,
             address = str(address)
-        ](const binary_asset::load_result& image_data){
+        ](const file_view& image_data){
+            library.register_source_size(address, image_data.size());
             return the<deferrer>().do_in_worker_thread([
                 image_data,
                 address = std::move(address)
             ](){
                 image content;
-                if ( !images::try_load_image(content, image_data->content()) ) {
+                if ( !images::try_load_image(content, image_data.content()) ) {
                     throw image_asset_loading_exception();
                 }
                 return image_asset::create(std::move(content));
             });
         });
     }
+
+    asset_size image_asset::estimated_size() const noexcept {
+        return {sizeof(image_asset) + content().data().size(), 0u};
+    }
 }
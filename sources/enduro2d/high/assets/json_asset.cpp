@@ -5,7 +5,6 @@
  ******************************************************************************/
 
 #include <enduro2d/high/assets/json_asset.hpp>
-#include <enduro2d/high/assets/text_asset.hpp>
 
 namespace
 {
@@ -21,22 +20,44 @@ namespace
 namespace e2d
 {
     json_asset::load_async_result json_asset::load_async(
-        const library& library, str_view address)
+        const library& library, str_view address, vfs::priority priority)
     {
-        return library.load_asset_async<text_asset>(address)
+        const auto asset_url = library.root() / address;
+        return the<vfs>().load_view_async(asset_url, priority)
         .then([
+            &library,
             address = str(address)
-        ](const text_asset::load_result& json_data){
+        ](const file_view& json_data){
+            library.register_source_size(address, json_data.size());
             return the<deferrer>().do_in_worker_thread([
                 json_data,
                 address = std::move(address)
             ](){
+                str validated_for;
                 auto json = std::make_shared<rapidjson::Document>();
-                if ( json->Parse(json_data->content().c_str()).HasParseError() ) {
+                if ( json_utils::is_binary_json(json_data.content()) ) {
+                    // cooked by e2d_cook, no text parsing required
+                    if ( !json_utils::try_load_binary_json(*json, validated_for, json_data.content()) ) {
+                        throw json_asset_loading_exception();
+                    }
+                } else if ( json->Parse(
+                    static_cast<const char*>(json_data.data()),
+                    json_data.size()).HasParseError() ) {
                     throw json_asset_loading_exception();
                 }
-                return json_asset::create(std::move(json));
+                auto result = json_asset::create(std::move(json));
+                result->validated_for(std::move(validated_for));
+                return result;
             });
         });
     }
+
+    const str& json_asset::validated_for() const noexcept {
+        return validated_for_;
+    }
+
+    json_asset& json_asset::validated_for(str asset_type) noexcept {
+        validated_for_ = std::move(asset_type);
+        return *this;
+    }
 }
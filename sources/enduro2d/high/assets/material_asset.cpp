@@ -1040,16 +1040,25 @@ namespace
 
 namespace e2d
 {
+    const rapidjson::SchemaDocument& material_asset::json_schema() {
+        return material_asset_schema();
+    }
+
     material_asset::load_async_result material_asset::load_async(
-        const library& library, str_view address)
+        const library& library, str_view address, vfs::priority priority)
     {
-        return library.load_asset_async<json_asset>(address)
+        return library.load_asset_async<json_asset>(address, priority)
         .then([
             &library,
             address = str(address),
             parent_address = path::parent_path(address)
         ](const json_asset::load_result& material_data){
             return the<deferrer>().do_in_worker_thread([address, material_data](){
+                if ( material_data->validated_for() == material_asset::type_name() ) {
+                    // validated by e2d_cook
+                    return;
+                }
+
                 const rapidjson::Document& doc = *material_data->content();
                 rapidjson::SchemaValidator validator(material_asset_schema());
 
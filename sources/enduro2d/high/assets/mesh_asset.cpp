@@ -5,7 +5,6 @@
  ******************************************************************************/
 
 #include <enduro2d/high/assets/mesh_asset.hpp>
-#include <enduro2d/high/assets/binary_asset.hpp>
 
 namespace
 {
@@ -21,22 +20,44 @@ namespace
 namespace e2d
 {
     mesh_asset::load_async_result mesh_asset::load_async(
-        const library& library, str_view address)
+        const library& library, str_view address, vfs::priority priority)
     {
-        return library.load_asset_async<binary_asset>(address)
+        const auto asset_url = library.root() / address;
+        return the<vfs>().load_view_async(asset_url, priority)
         .then([
+            &library,
             address = str(address)
-        ](const binary_asset::load_result& mesh_data){
+        ](const file_view& mesh_data){
+            library.register_source_size(address, mesh_data.size());
             return the<deferrer>().do_in_worker_thread([
                 mesh_data,
                 address = std::move(address)
             ](){
                 mesh content;
-                if ( !meshes::try_load_mesh(content, mesh_data->content()) ) {
+                if ( !meshes::try_load_mesh(content, mesh_data.content()) ) {
                     throw mesh_asset_loading_exception();
                 }
                 return mesh_asset::create(std::move(content));
             });
         });
     }
+
+    asset_size mesh_asset::estimated_size() const noexcept {
+        const mesh& content = this->content();
+        std::size_t result = sizeof(mesh_asset);
+        for ( std::size_t i = 0; i < content.uvs_channel_count(); ++i ) {
+            result += content.uvs(i).size() * sizeof(v2f);
+        }
+        for ( std::size_t i = 0; i < content.colors_channel_count(); ++i ) {
+            result += content.colors(i).size() * sizeof(color32);
+        }
+        for ( std::size_t i = 0; i < content.indices_submesh_count(); ++i ) {
+            result += content.indices(i).size() * sizeof(u32);
+        }
+        result += content.vertices().size() * sizeof(v3f);
+        result += content.normals().size() * sizeof(v3f);
+        result += content.tangents().size() * sizeof(v3f);
+        result += content.bitangents().size() * sizeof(v3f);
+        return {result, 0u};
+    }
 }
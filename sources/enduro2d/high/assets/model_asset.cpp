@@ -69,16 +69,25 @@ namespace
 
 namespace e2d
 {
+    const rapidjson::SchemaDocument& model_asset::json_schema() {
+        return model_asset_schema();
+    }
+
     model_asset::load_async_result model_asset::load_async(
-        const library& library, str_view address)
+        const library& library, str_view address, vfs::priority priority)
     {
-        return library.load_asset_async<json_asset>(address)
+        return library.load_asset_async<json_asset>(address, priority)
         .then([
             &library,
             address = str(address),
             parent_address = path::parent_path(address)
         ](const json_asset::load_result& model_data){
             return the<deferrer>().do_in_worker_thread([address, model_data](){
+                if ( model_data->validated_for() == model_asset::type_name() ) {
+                    // validated by e2d_cook
+                    return;
+                }
+
                 const rapidjson::Document& doc = *model_data->content();
                 rapidjson::SchemaValidator validator(model_asset_schema());
 
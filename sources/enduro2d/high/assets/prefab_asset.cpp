@@ -277,16 +277,25 @@ namespace
 
 namespace e2d
 {
+    const rapidjson::SchemaDocument& prefab_asset::json_schema() {
+        return prefab_asset_schema();
+    }
+
     prefab_asset::load_async_result prefab_asset::load_async(
-        const library& library, str_view address)
+        const library& library, str_view address, vfs::priority priority)
     {
-        return library.load_asset_async<json_asset>(address)
+        return library.load_asset_async<json_asset>(address, priority)
         .then([
             &library,
             address = str(address),
             parent_address = path::parent_path(address)
         ](const json_asset::load_result& prefab_data){
             return the<deferrer>().do_in_worker_thread([address, prefab_data](){
+                if ( prefab_data->validated_for() == prefab_asset::type_name() ) {
+                    // validated by e2d_cook
+                    return;
+                }
+
                 const rapidjson::Document& doc = *prefab_data->content();
                 rapidjson::SchemaValidator validator(prefab_asset_schema());
 
@@ -314,8 +323,10 @@ namespace e2d
                     library, parent_address, *prefab_data->content());
             })
             .then([parent_address, prefab_data](const asset_group& dependencies){
-                return prefab_asset::create(parse_prefab(
-                    parent_address, *prefab_data->content(), dependencies));
+                prefab content = parse_prefab(
+                    parent_address, *prefab_data->content(), dependencies);
+                content.compile_plan();
+                return prefab_asset::create(std::move(content));
             });
         });
     }
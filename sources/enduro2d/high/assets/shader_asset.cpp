@@ -90,16 +90,25 @@ namespace
 
 namespace e2d
 {
+    const rapidjson::SchemaDocument& shader_asset::json_schema() {
+        return shader_asset_schema();
+    }
+
     shader_asset::load_async_result shader_asset::load_async(
-        const library& library, str_view address)
+        const library& library, str_view address, vfs::priority priority)
     {
-        return library.load_asset_async<json_asset>(address)
+        return library.load_asset_async<json_asset>(address, priority)
         .then([
             &library,
             address = str(address),
             parent_address = path::parent_path(address)
         ](const json_asset::load_result& shader_data){
             return the<deferrer>().do_in_worker_thread([address, shader_data](){
+                if ( shader_data->validated_for() == shader_asset::type_name() ) {
+                    // validated by e2d_cook
+                    return;
+                }
+
                 const rapidjson::Document& doc = *shader_data->content();
                 rapidjson::SchemaValidator validator(shader_asset_schema());
 
@@ -5,7 +5,6 @@
  ******************************************************************************/
 
 #include <enduro2d/high/assets/shape_asset.hpp>
-#include <enduro2d/high/assets/binary_asset.hpp>
 
 namespace
 {
@@ -21,22 +20,41 @@ namespace
 namespace e2d
 {
     shape_asset::load_async_result shape_asset::load_async(
-        const library& library, str_view address)
+        const library& library, str_view address, vfs::priority priority)
     {
-        return library.load_asset_async<binary_asset>(address)
+        const auto asset_url = library.root() / address;
+        return the<vfs>().load_view_async(asset_url, priority)
         .then([
+            &library,
             address = str(address)
-        ](const binary_asset::load_result& shape_data){
+        ](const file_view& shape_data){
+            library.register_source_size(address, shape_data.size());
             return the<deferrer>().do_in_worker_thread([
                 shape_data,
                 address = std::move(address)
             ](){
                 shape content;
-                if ( !shapes::try_load_shape(content, shape_data->content()) ) {
+                if ( !shapes::try_load_shape(content, shape_data.content()) ) {
                     throw shape_asset_loading_exception();
                 }
                 return shape_asset::create(std::move(content));
             });
         });
     }
+
+    asset_size shape_asset::estimated_size() const noexcept {
+        const shape& content = this->content();
+        std::size_t result = sizeof(shape_asset);
+        for ( std::size_t i = 0; i < content.uvs_channel_count(); ++i ) {
+            result += content.uvs(i).size() * sizeof(v2f);
+        }
+        for ( std::size_t i = 0; i < content.colors_channel_count(); ++i ) {
+            result += content.colors(i).size() * sizeof(color32);
+        }
+        for ( std::size_t i = 0; i < content.indices_subshape_count(); ++i ) {
+            result += content.indices(i).size() * sizeof(u32);
+        }
+        result += content.vertices().size() * sizeof(v2f);
+        return {result, 0u};
+    }
 }
@@ -91,16 +91,25 @@ namespace
 
 namespace e2d
 {
+    const rapidjson::SchemaDocument& sound_asset::json_schema() {
+        return sound_asset_schema();
+    }
+
     sound_asset::load_async_result sound_asset::load_async(
-        const library& library, str_view address)
+        const library& library, str_view address, vfs::priority priority)
     {
-        return library.load_asset_async<json_asset>(address)
+        return library.load_asset_async<json_asset>(address, priority)
         .then([
             &library,
             address = str(address),
             parent_address = path::parent_path(address)
         ](const json_asset::load_result& sound_data){
             return the<deferrer>().do_in_worker_thread([address, sound_data](){
+                if ( sound_data->validated_for() == sound_asset::type_name() ) {
+                    // validated by e2d_cook
+                    return;
+                }
+
                 const rapidjson::Document& doc = *sound_data->content();
                 rapidjson::SchemaValidator validator(sound_asset_schema());
 
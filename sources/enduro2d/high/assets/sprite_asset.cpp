@@ -110,16 +110,25 @@ namespace
 
 namespace e2d
 {
+    const rapidjson::SchemaDocument& sprite_asset::json_schema() {
+        return sprite_asset_schema();
+    }
+
     sprite_asset::load_async_result sprite_asset::load_async(
-        const library& library, str_view address)
+        const library& library, str_view address, vfs::priority priority)
     {
-        return library.load_asset_async<json_asset>(address)
+        return library.load_asset_async<json_asset>(address, priority)
         .then([
             &library,
             address = str(address),
             parent_address = path::parent_path(address)
         ](const json_asset::load_result& sprite_data){
             return the<deferrer>().do_in_worker_thread([address, sprite_data](){
+                if ( sprite_data->validated_for() == sprite_asset::type_name() ) {
+                    // validated by e2d_cook
+                    return;
+                }
+
                 const rapidjson::Document& doc = *sprite_data->content();
                 rapidjson::SchemaValidator validator(sprite_asset_schema());
 
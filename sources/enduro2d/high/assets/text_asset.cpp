@@ -20,13 +20,21 @@ namespace
 namespace e2d
 {
     text_asset::load_async_result text_asset::load_async(
-        const library& library, str_view address)
+        const library& library, str_view address, vfs::priority priority)
     {
         const auto asset_url = library.root() / address;
-        return the<vfs>().load_as_string_async(asset_url)
-        .then([](auto&& content){
+        return the<vfs>().load_as_string_async(asset_url, priority)
+        .then([
+            &library,
+            address = str(address)
+        ](auto&& content){
+            library.register_source_size(address, content.size());
             return text_asset::create(
                 std::forward<decltype(content)>(content));
         });
     }
+
+    asset_size text_asset::estimated_size() const noexcept {
+        return {sizeof(text_asset) + content().capacity(), 0u};
+    }
 }
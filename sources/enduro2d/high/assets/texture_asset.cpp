@@ -21,9 +21,9 @@ namespace
 namespace e2d
 {
     texture_asset::load_async_result texture_asset::load_async(
-        const library& library, str_view address)
+        const library& library, str_view address, vfs::priority priority)
     {
-        return library.load_asset_async<image_asset>(address)
+        return library.load_asset_async<image_asset>(address, priority)
         .then([
             address = str(address)
         ](const image_asset::load_result& texture_data){
@@ -40,4 +40,11 @@ namespace e2d
             });
         });
     }
+
+    asset_size texture_asset::estimated_size() const noexcept {
+        const texture_ptr& content = this->content();
+        return {
+            sizeof(texture_asset),
+            content ? content->decl().data_size_for_dimension(content->size()) : 0u};
+    }
 }
@@ -5,7 +5,6 @@
  ******************************************************************************/
 
 #include <enduro2d/high/assets/xml_asset.hpp>
-#include <enduro2d/high/assets/text_asset.hpp>
 
 namespace
 {
@@ -21,18 +20,23 @@ namespace
 namespace e2d
 {
     xml_asset::load_async_result xml_asset::load_async(
-        const library& library, str_view address)
+        const library& library, str_view address, vfs::priority priority)
     {
-        return library.load_asset_async<text_asset>(address)
+        const auto asset_url = library.root() / address;
+        return the<vfs>().load_view_async(asset_url, priority)
         .then([
+            &library,
             address = str(address)
-        ](const text_asset::load_result& xml_data){
+        ](const file_view& xml_data){
+            library.register_source_size(address, xml_data.size());
             return the<deferrer>().do_in_worker_thread([
                 xml_data,
                 address = std::move(address)
             ](){
                 auto xml = std::make_shared<pugi::xml_document>();
-                if ( !xml->load_string(xml_data->content().c_str()) ) {
+                if ( !xml->load_buffer(
+                    xml_data.data(),
+                    xml_data.size()) ) {
                     throw xml_asset_loading_exception();
                 }
                 return xml_asset::create(std::move(xml));
@@ -225,7 +225,9 @@ namespace e2d
 
             int count = math::numeric_cast<int>(c->points().size());
             if ( ImGui::DragInt("count", &count, 1.f, 0, std::numeric_limits<int>::max()) ) {
-                c->points().resize(math::numeric_cast<std::size_t>(count));
+                vector<v2f> points = c->points();
+                points.resize(math::numeric_cast<std::size_t>(count));
+                c->points(std::move(points));
             }
 
             for ( std::size_t i = 0; i < c->points().size(); ++i ) {
@@ -235,7 +237,7 @@ namespace e2d
                 if ( v2f point = c->points()[i];
                     ImGui::DragFloat2("###point", point.data(), 1.f) )
                 {
-                    c->points()[i] = point;
+                    c->point(i, point);
                 }
             }
         }
@@ -6,6 +6,8 @@
 
 #include <enduro2d/high/components/label.hpp>
 
+#include <enduro2d/high/world.hpp>
+
 namespace e2d
 {
     const char* factory_loader<label>::schema_source = R"json({
@@ -201,7 +203,7 @@ namespace e2d
     const char* component_inspector<label>::title = ICON_FA_PARAGRAPH " label";
 
     void component_inspector<label>::operator()(gcomponent<label>& c) const {
-        if ( bool dirty = c.component<label::dirty>().exists();
+        if ( bool dirty = labels::is_dirty(c);
             ImGui::Checkbox("dirty", &dirty) )
         {
             if ( dirty ) {
@@ -337,20 +339,28 @@ namespace e2d::labels
 {
     gcomponent<label> mark_dirty(gcomponent<label> self) {
         if ( self ) {
-            self.component<label::dirty>().ensure();
+            gobject owner = self.owner();
+            owner.owner_world().changes<label::dirty>().mark(owner.raw_entity().id());
+            gcomponent<label>::mark_changed();
         }
         return self;
     }
 
     gcomponent<label> unmark_dirty(gcomponent<label> self) {
         if ( self ) {
-            self.component<label::dirty>().remove();
+            gobject owner = self.owner();
+            owner.owner_world().changes<label::dirty>().unmark(owner.raw_entity().id());
         }
         return self;
     }
 
     bool is_dirty(const const_gcomponent<label>& self) noexcept {
-        return self.component<label::dirty>().exists();
+        if ( !self ) {
+            return false;
+        }
+        const gobject owner = self.owner();
+        const ecsex::change_set* changes = owner.owner_world().find_changes<label::dirty>();
+        return changes && changes->is_marked(owner.raw_entity().id());
     }
 
     gcomponent<label> change_text(gcomponent<label> self, str value) {
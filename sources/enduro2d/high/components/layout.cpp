@@ -8,6 +8,8 @@
 
 #include <enduro2d/high/components/actor.hpp>
 
+#include <enduro2d/high/world.hpp>
+
 namespace e2d
 {
     const char* factory_loader<layout>::schema_source = R"json({
@@ -172,7 +174,7 @@ namespace e2d
     const char* component_inspector<layout>::title = ICON_FA_BARS " layout";
 
     void component_inspector<layout>::operator()(gcomponent<layout>& c) const {
-        if ( bool dirty = c.component<layout::dirty>().exists();
+        if ( bool dirty = layouts::is_dirty(c);
             ImGui::Checkbox("dirty", &dirty) )
         {
             if ( dirty ) {
@@ -226,20 +228,28 @@ namespace e2d::layouts
 {
     gcomponent<layout> mark_dirty(gcomponent<layout> self) {
         if ( self ) {
-            self.component<layout::dirty>().ensure();
+            gobject owner = self.owner();
+            owner.owner_world().changes<layout::dirty>().mark(owner.raw_entity().id());
+            gcomponent<layout>::mark_changed();
         }
         return self;
     }
 
     gcomponent<layout> unmark_dirty(gcomponent<layout> self) {
         if ( self ) {
-            self.component<layout::dirty>().remove();
+            gobject owner = self.owner();
+            owner.owner_world().changes<layout::dirty>().unmark(owner.raw_entity().id());
         }
         return self;
     }
 
     bool is_dirty(const const_gcomponent<layout>& self) noexcept {
-        return self.component<layout::dirty>().exists();
+        if ( !self ) {
+            return false;
+        }
+        const gobject owner = self.owner();
+        const ecsex::change_set* changes = owner.owner_world().find_changes<layout::dirty>();
+        return changes && changes->is_marked(owner.raw_entity().id());
     }
 
     gcomponent<layout> change_direction(gcomponent<layout> self, layout::directions value) {
@@ -9,6 +9,8 @@
 #include <enduro2d/high/components/actor.hpp>
 #include <enduro2d/high/components/layout.hpp>
 
+#include <enduro2d/high/world.hpp>
+
 namespace e2d
 {
     const char* factory_loader<widget>::schema_source = R"json({
@@ -96,7 +98,7 @@ namespace e2d
     const char* component_inspector<widget>::title = ICON_FA_VECTOR_SQUARE " widget";
 
     void component_inspector<widget>::operator()(gcomponent<widget>& c) const {
-        if ( bool dirty = c.component<widget::dirty>().exists();
+        if ( bool dirty = widgets::is_dirty(c);
             ImGui::Checkbox("dirty", &dirty) )
         {
             if ( dirty ) {
@@ -161,20 +163,28 @@ namespace e2d::widgets
 {
     gcomponent<widget> mark_dirty(gcomponent<widget> self) {
         if ( self ) {
-            self.component<widget::dirty>().ensure();
+            gobject owner = self.owner();
+            owner.owner_world().changes<widget::dirty>().mark(owner.raw_entity().id());
+            gcomponent<widget>::mark_changed();
         }
         return self;
     }
 
     gcomponent<widget> unmark_dirty(gcomponent<widget> self) {
         if ( self ) {
-            self.component<widget::dirty>().remove();
+            gobject owner = self.owner();
+            owner.owner_world().changes<widget::dirty>().unmark(owner.raw_entity().id());
         }
         return self;
     }
 
     bool is_dirty(const const_gcomponent<widget>& self) noexcept {
-        return self.component<widget::dirty>().exists();
+        if ( !self ) {
+            return false;
+        }
+        const gobject owner = self.owner();
+        const ecsex::change_set* changes = owner.owner_world().find_changes<widget::dirty>();
+        return changes && changes->is_marked(owner.raw_entity().id());
     }
 
     gcomponent<widget> change_size(gcomponent<widget> self, const v2f& value) {
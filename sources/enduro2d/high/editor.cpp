@@ -8,6 +8,7 @@
 
 #include <enduro2d/high/widgets/hierarchy_widget.hpp>
 #include <enduro2d/high/widgets/inspector_widget.hpp>
+#include <enduro2d/high/widgets/library_widget.hpp>
 
 namespace e2d
 {
@@ -15,6 +16,7 @@ namespace e2d
         if ( modules::is_initialized<dbgui>() ) {
             the<dbgui>().register_menu_widget<dbgui_widgets::hierarchy_widget>("Scene", ICON_FA_SITEMAP " Hierarchy");
             the<dbgui>().register_menu_widget<dbgui_widgets::inspector_widget>("Scene", ICON_FA_EYE " Inspector");
+            the<dbgui>().register_menu_widget<dbgui_widgets::library_widget>("Debug", ICON_FA_DATABASE " Library");
         }
     }
 
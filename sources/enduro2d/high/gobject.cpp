@@ -6,6 +6,33 @@
 
 #include <enduro2d/high/gobject.hpp>
 
+namespace
+{
+    using namespace e2d;
+
+    std::atomic<u32> version_counter{0u};
+}
+
+namespace e2d::detail
+{
+    thread_local component_access_hook_t component_access_hook{nullptr};
+}
+
+namespace e2d::versions
+{
+    u32 next() noexcept {
+        return version_counter.fetch_add(1u, std::memory_order_relaxed) + 1u;
+    }
+
+    u32 current() noexcept {
+        return version_counter.load(std::memory_order_relaxed);
+    }
+
+    bool changed_since(u32 version, u32 since) noexcept {
+        return static_cast<i32>(version - since) > 0;
+    }
+}
+
 namespace e2d
 {
     const gobject::state_iptr& gobject::internal_state() const noexcept {
@@ -43,6 +70,16 @@ namespace e2d
         return state_->raw_entity();
     }
 
+    world& gobject::owner_world() noexcept {
+        E2D_ASSERT(valid());
+        return state_->owner_world();
+    }
+
+    const world& gobject::owner_world() const noexcept {
+        E2D_ASSERT(valid());
+        return state_->owner_world();
+    }
+
     bool operator<(const gobject& l, const gobject& r) noexcept {
         return (!l && r)
             || (l && r && l.raw_entity() < r.raw_entity());
@@ -6,6 +6,27 @@
 
 #include <enduro2d/high/node.hpp>
 
+namespace
+{
+    using namespace e2d;
+
+    // keeps the owner pool alive in front of each pooled node
+    struct alignas(std::max_align_t) block_header {
+        std::shared_ptr<pool_allocator> allocator;
+    };
+
+    constexpr std::size_t node_block_size =
+        sizeof(block_header) + sizeof(node);
+
+    const std::shared_ptr<pool_allocator>& default_node_allocator() {
+        // pooled nodes share its ownership, so the last node
+        // released by another static object frees the pool
+        static const std::shared_ptr<pool_allocator> allocator =
+            node::create_allocator(1024u);
+        return allocator;
+    }
+}
+
 namespace e2d
 {
     node::node(gobject owner)
@@ -14,10 +35,13 @@ namespace e2d
     node::~node() noexcept {
         E2D_ASSERT(!parent_);
         remove_all_children();
+        if ( transforms_ ) {
+            transforms_->destroy(transforms_handle_);
+        }
     }
 
     node_iptr node::create() {
-        return node_iptr(new node());
+        return create(default_node_allocator(), gobject());
     }
 
     node_iptr node::create(const t2f& transform) {
@@ -41,7 +65,24 @@ namespace e2d
     }
 
     node_iptr node::create(gobject owner) {
-        return node_iptr(new node(std::move(owner)));
+        return create(default_node_allocator(), std::move(owner));
+    }
+
+    node_iptr node::create(
+        const std::shared_ptr<pool_allocator>& allocator,
+        gobject owner)
+    {
+        return node_iptr(new(allocator) node(std::move(owner)));
+    }
+
+    node_iptr node::create(
+        const std::shared_ptr<pool_allocator>& allocator,
+        const std::shared_ptr<transform_hierarchy>& transforms,
+        gobject owner)
+    {
+        node_iptr child = create(allocator, std::move(owner));
+        child->bind_transforms_(transforms);
+        return child;
     }
 
     node_iptr node::create(gobject owner, const t2f& transform) {
@@ -64,6 +105,44 @@ namespace e2d
         return child;
     }
 
+    std::shared_ptr<pool_allocator> node::create_allocator(std::size_t blocks_per_chunk) {
+        return std::make_shared<pool_allocator>(node_block_size, blocks_per_chunk);
+    }
+
+    void* node::operator new(std::size_t size) {
+        return operator new(size, default_node_allocator());
+    }
+
+    void* node::operator new(std::size_t size, const std::shared_ptr<pool_allocator>& allocator) {
+        E2D_ASSERT(allocator && allocator->block_size() == node_block_size);
+        if ( size != sizeof(node) ) {
+            return ::operator new(size);
+        }
+        block_header* header = new(allocator->allocate()) block_header{allocator};
+        return header + 1;
+    }
+
+    void node::operator delete(void* ptr, std::size_t size) noexcept {
+        if ( size != sizeof(node) ) {
+            ::operator delete(ptr);
+            return;
+        }
+        block_header* header = static_cast<block_header*>(ptr) - 1;
+        // the last node can outlive its world, release the pool after it
+        std::shared_ptr<pool_allocator> allocator = std::move(header->allocator);
+        header->~block_header();
+        allocator->deallocate(header);
+    }
+
+    void node::operator delete(void* ptr, const std::shared_ptr<pool_allocator>& allocator) noexcept {
+        E2D_UNUSED(allocator);
+        operator delete(ptr, sizeof(node));
+    }
+
+    pool_allocator::statistics node::allocation_stats() noexcept {
+        return default_node_allocator()->stats();
+    }
+
     void node::owner(gobject owner) noexcept {
         owner_ = std::move(owner);
     }
@@ -72,6 +151,10 @@ namespace e2d
         return owner_;
     }
 
+    const std::shared_ptr<transform_hierarchy>& node::transforms() const noexcept {
+        return transforms_;
+    }
+
     void node::transform(const t2f& transform) noexcept {
         transform_ = transform;
         mark_dirty_local_matrix_();
@@ -108,20 +191,59 @@ namespace e2d
         return transform_.scale;
     }
 
-    const m4f& node::local_matrix() const noexcept {
+    const m3x2f& node::local_matrix() const noexcept {
         if ( math::check_and_clear_any_flags(flags_, fm_dirty_local_matrix) ) {
             update_local_matrix_();
         }
         return local_matrix_;
     }
 
-    const m4f& node::world_matrix() const noexcept {
+    const m3x2f& node::world_matrix() const noexcept {
+        if ( transforms_ ) {
+            return transforms_->world_matrix(transforms_handle_);
+        }
         if ( math::check_and_clear_any_flags(flags_, fm_dirty_world_matrix) ) {
             update_world_matrix_();
         }
         return world_matrix_;
     }
 
+    u32 node::local_version() const noexcept {
+        return local_version_;
+    }
+
+    u32 node::world_version() const noexcept {
+        if ( transforms_ ) {
+            return transforms_->world_version(transforms_handle_);
+        }
+        world_matrix();
+        return world_version_;
+    }
+
+    u32 node::hierarchy_version() const noexcept {
+        return hierarchy_version_;
+    }
+
+    bool node::local_changed_since(u32 version) const noexcept {
+        return versions::changed_since(local_version(), version);
+    }
+
+    bool node::world_changed_since(u32 version) const noexcept {
+        return versions::changed_since(world_version(), version);
+    }
+
+    bool node::hierarchy_changed_since(u32 version) const noexcept {
+        return versions::changed_since(hierarchy_version(), version);
+    }
+
+    v2f node::local_to_world(const v2f& local) const noexcept {
+        return local * world_matrix();
+    }
+
+    v2f node::world_to_local(const v2f& world) const noexcept {
+        return world * math::inversed(world_matrix()).first;
+    }
+
     v4f node::local_to_world(const v4f& local) const noexcept {
         return local * world_matrix();
     }
@@ -237,7 +359,8 @@ namespace e2d
         child->remove_from_parent();
         children_.push_front(*child);
         child->parent_ = this;
-        child->mark_dirty_world_matrix_();
+        child->mark_dirty_parent_();
+        mark_dirty_hierarchy_();
         return true;
     }
 
@@ -256,7 +379,8 @@ namespace e2d
         child->remove_from_parent();
         children_.push_back(*child);
         child->parent_ = this;
-        child->mark_dirty_world_matrix_();
+        child->mark_dirty_parent_();
+        mark_dirty_hierarchy_();
         return true;
     }
 
@@ -278,7 +402,8 @@ namespace e2d
             node_children::iterator_to(*before),
             *child);
         child->parent_ = this;
-        child->mark_dirty_world_matrix_();
+        child->mark_dirty_parent_();
+        mark_dirty_hierarchy_();
         return true;
     }
 
@@ -300,7 +425,8 @@ namespace e2d
             ++node_children::iterator_to(*after),
             *child);
         child->parent_ = this;
-        child->mark_dirty_world_matrix_();
+        child->mark_dirty_parent_();
+        mark_dirty_hierarchy_();
         return true;
     }
 
@@ -324,9 +450,10 @@ namespace e2d
             node_children::iterator_to(*child),
             [](node* n){
                 n->parent_ = nullptr;
-                n->mark_dirty_world_matrix_();
+                n->mark_dirty_parent_();
                 intrusive_ptr_release(n);
             });
+        mark_dirty_hierarchy_();
         return true;
     }
 
@@ -353,6 +480,7 @@ namespace e2d
             node_children::iterator_to(*child_l),
             node_children::iterator_to(*child_r));
 
+        mark_dirty_hierarchy_();
         return true;
     }
 
@@ -495,7 +623,11 @@ namespace e2d
 namespace e2d
 {
     void node::mark_dirty_local_matrix_() noexcept {
-        if ( math::check_and_set_any_flags(flags_, fm_dirty_local_matrix) ) {
+        local_version_ = versions::next();
+        if ( transforms_ ) {
+            math::set_flags_inplace(flags_, fm_dirty_local_matrix);
+            transforms_->transform(transforms_handle_, transform_);
+        } else if ( math::check_and_set_any_flags(flags_, fm_dirty_local_matrix) ) {
             mark_dirty_world_matrix_();
         }
     }
@@ -508,14 +640,57 @@ namespace e2d
         }
     }
 
+    void node::mark_dirty_hierarchy_() noexcept {
+        const u32 version = versions::next();
+        for ( node* n = this; n; n = n->parent_ ) {
+            n->hierarchy_version_ = version;
+        }
+    }
+
+    void node::mark_dirty_parent_() noexcept {
+        if ( parent_ && parent_->transforms_ != transforms_ ) {
+            bind_transforms_(parent_->transforms_);
+        } else if ( transforms_ ) {
+            transforms_->parent(transforms_handle_, parent_
+                ? parent_->transforms_handle_
+                : transform_hierarchy::invalid_handle);
+        } else {
+            mark_dirty_world_matrix_();
+        }
+    }
+
+    void node::bind_transforms_(const std::shared_ptr<transform_hierarchy>& transforms) noexcept {
+        if ( transforms_ ) {
+            transforms_->destroy(transforms_handle_);
+            transforms_handle_ = transform_hierarchy::invalid_handle;
+        }
+
+        transforms_ = transforms;
+
+        if ( transforms_ ) {
+            const bool bound_parent = parent_ && parent_->transforms_ == transforms_;
+            transforms_handle_ = transforms_->create(
+                bound_parent ? parent_->transforms_handle_ : transform_hierarchy::invalid_handle,
+                transform_);
+        } else {
+            // the lazy matrices are stale after leaving the storage
+            math::set_flags_inplace(flags_, fm_dirty_world_matrix);
+        }
+
+        for ( node& child : children_ ) {
+            child.bind_transforms_(transforms);
+        }
+    }
+
     void node::update_local_matrix_() const noexcept {
-        local_matrix_ = math::make_trs_matrix4(transform_);
+        local_matrix_ = math::make_trs_matrix3x2(transform_);
     }
 
     void node::update_world_matrix_() const noexcept {
         world_matrix_ = parent_
             ? local_matrix() * parent_->world_matrix()
             : local_matrix();
+        world_version_ = versions::next();
     }
 }
 
@@ -0,0 +1,274 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/high/prefab_pool.hpp>
+
+#include <enduro2d/high/world.hpp>
+
+#include <enduro2d/high/components/actor.hpp>
+#include <enduro2d/high/components/disabled.hpp>
+
+namespace
+{
+    using namespace e2d;
+
+    // pre-order walk, the same order as the prefab plan
+    bool collect_plan_nodes(
+        const node_iptr& root,
+        const vector<u32>& child_counts,
+        linear_vector<node_iptr>& nodes)
+    {
+        const std::size_t index = nodes.size();
+        if ( index >= child_counts.size() || root->child_count() != child_counts[index] ) {
+            return false;
+        }
+        nodes.push_back(root);
+        for ( node_iptr child = root->first_child(); child; child = child->next_sibling() ) {
+            if ( !collect_plan_nodes(child, child_counts, nodes) ) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+namespace e2d
+{
+    prefab_pool::prefab_pool(world& world, const prefab& prefab)
+    : world_(world)
+    , prefab_(prefab) {
+        E2D_ASSERT_MSG(prefab_.plan(), "prefab_pool: the prefab must have a compiled plan");
+        if ( !prefab_.plan() ) {
+            prefab_.compile_plan();
+        }
+
+        const prefab_plan& plan = *prefab_.plan();
+        child_counts_.resize(plan.size(), 0u);
+        for ( std::size_t i = 0; i < plan.size(); ++i ) {
+            if ( plan.parent(i) != prefab_plan::no_parent ) {
+                ++child_counts_[plan.parent(i)];
+            }
+        }
+    }
+
+    prefab_pool::~prefab_pool() noexcept {
+        shrink(0u);
+    }
+
+    prefab_pool& prefab_pool::warmup(std::size_t count) {
+        idle_.reserve(idle_.size() + count);
+        for ( std::size_t i = 0; i < count; ++i ) {
+            gobject inst = create_();
+            if ( park_(inst) ) {
+                idle_.push_back(std::move(inst));
+            } else {
+                ++stats_.discarded;
+                world_.destroy_instance(inst);
+            }
+        }
+        stats_.idle = idle_.size();
+        return *this;
+    }
+
+    prefab_pool& prefab_pool::shrink(std::size_t max_idle) noexcept {
+        while ( idle_.size() > max_idle ) {
+            ++stats_.discarded;
+            world_.destroy_instance(idle_.back());
+            idle_.pop_back();
+        }
+        stats_.idle = idle_.size();
+        return *this;
+    }
+
+    gobject prefab_pool::acquire() {
+        return acquire(nullptr);
+    }
+
+    gobject prefab_pool::acquire(const t2f& transform) {
+        return acquire(nullptr, transform);
+    }
+
+    gobject prefab_pool::acquire(const node_iptr& parent) {
+        gobject inst;
+
+        // parked instances could be destroyed by someone else
+        while ( !idle_.empty() && !inst ) {
+            inst = std::move(idle_.back());
+            idle_.pop_back();
+            if ( !inst.alive() ) {
+                ++stats_.discarded;
+                inst = gobject();
+            }
+        }
+
+        if ( inst ) {
+            ERROR_DEFER([this, inst](){
+                world_.destroy_instance(inst);
+            });
+            unpark_(inst);
+        } else {
+            inst = create_();
+            ++stats_.misses;
+        }
+
+        ERROR_DEFER([this, inst](){
+            world_.destroy_instance(inst);
+        });
+
+        if ( parent ) {
+            parent->add_child(inst.component<actor>()->node());
+        }
+
+        active_.insert(inst.internal_state().get());
+
+        ++stats_.acquires;
+        stats_.idle = idle_.size();
+        stats_.active = active_.size();
+        return inst;
+    }
+
+    gobject prefab_pool::acquire(const node_iptr& parent, const t2f& transform) {
+        gobject inst = acquire(parent);
+        inst.component<actor>()->node()->transform(transform);
+        return inst;
+    }
+
+    void prefab_pool::release(gobject inst) noexcept {
+        if ( !inst ) {
+            return;
+        }
+
+        const bool owned = active_.erase(inst.internal_state().get()) > 0u;
+        stats_.active = active_.size();
+
+        if ( !inst.alive() ) {
+            return;
+        }
+
+        if ( owned && park_(inst) ) {
+            try {
+                idle_.push_back(std::move(inst));
+                stats_.idle = idle_.size();
+                return;
+            } catch (...) {
+                // nothing
+            }
+        }
+
+        ++stats_.discarded;
+        world_.destroy_instance(inst);
+    }
+
+    bool prefab_pool::owns(const gobject& inst) const noexcept {
+        return inst
+            && active_.count(inst.internal_state().get()) > 0u;
+    }
+
+    const prefab& prefab_pool::source() const noexcept {
+        return prefab_;
+    }
+
+    const prefab_pool::statistics& prefab_pool::stats() const noexcept {
+        return stats_;
+    }
+
+    gobject prefab_pool::create_() {
+        gobject inst = world_.instantiate(prefab_);
+        ++stats_.created;
+
+        if ( disabled_by_prototype_.empty() ) {
+            ERROR_DEFER([this, inst](){
+                world_.destroy_instance(inst);
+            });
+
+            frame_allocator::scope frame_scope;
+            linear_vector<node_iptr> nodes(
+                frame_scope.allocator<node_iptr>());
+
+            if ( !collect_nodes_(inst, nodes) ) {
+                throw bad_world_operation();
+            }
+
+            disabled_by_prototype_.reserve(nodes.size());
+            for ( const node_iptr& node : nodes ) {
+                disabled_by_prototype_.push_back(
+                    node->owner().component<disabled<actor>>().exists() ? 1u : 0u);
+            }
+        }
+
+        return inst;
+    }
+
+    bool prefab_pool::collect_nodes_(const gobject& root, linear_vector<node_iptr>& nodes) const {
+        const_gcomponent<actor> root_a{root};
+        node_iptr root_n = root_a
+            ? const_pointer_cast<node>(root_a->node())
+            : nullptr;
+        return root_n
+            && collect_plan_nodes(root_n, child_counts_, nodes)
+            && nodes.size() == child_counts_.size();
+    }
+
+    bool prefab_pool::park_(gobject& root) noexcept {
+        try {
+            frame_allocator::scope frame_scope;
+            linear_vector<node_iptr> nodes(
+                frame_scope.allocator<node_iptr>());
+
+            if ( !collect_nodes_(root, nodes) ) {
+                return false;
+            }
+
+            nodes.front()->remove_from_parent();
+
+            const prefab_plan& plan = *prefab_.plan();
+            for ( std::size_t i = 0; i < nodes.size(); ++i ) {
+                const node_iptr& inst_n = nodes[i];
+                gobject inst_i = inst_n->owner();
+
+                // drops the components added at runtime and restores the
+                // prototype ones, the prototype actor brings its own node
+                // with the initial transform, the instance node is kept
+                ecs::entity inst_e = inst_i.raw_entity();
+                inst_e.remove_all_components();
+                plan.prototype(i).apply_to_entity(inst_e, true);
+
+                gcomponent<actor> inst_a{inst_i};
+                inst_n->transform(inst_a && inst_a->node() && inst_a->node() != inst_n
+                    ? inst_a->node()->transform()
+                    : t2f::identity());
+                inst_a.ensure().node(inst_n);
+
+                gcomponent<disabled<actor>> inst_d{inst_i};
+                if ( !inst_d.exists() ) {
+                    inst_d.assign();
+                }
+            }
+
+            return true;
+        } catch (...) {
+            return false;
+        }
+    }
+
+    void prefab_pool::unpark_(gobject& root) {
+        frame_allocator::scope frame_scope;
+        linear_vector<node_iptr> nodes(
+            frame_scope.allocator<node_iptr>());
+
+        if ( !collect_nodes_(root, nodes) ) {
+            throw bad_world_operation();
+        }
+
+        for ( std::size_t i = 0; i < nodes.size(); ++i ) {
+            if ( !disabled_by_prototype_[i] ) {
+                gcomponent<disabled<actor>>{nodes[i]->owner()}.remove();
+            }
+            // the prototype values are built again
+            world_.mark_instance_changes(nodes[i]->owner());
+        }
+    }
+}
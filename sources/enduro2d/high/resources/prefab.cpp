@@ -28,6 +28,7 @@ namespace e2d
         uuid_.clear();
         children_.clear();
         prototype_.clear();
+        plan_.reset();
     }
 
     void prefab::swap(prefab& other) noexcept {
@@ -35,6 +36,7 @@ namespace e2d
         swap(uuid_, other.uuid_);
         swap(children_, other.children_);
         swap(prototype_, other.prototype_);
+        swap(plan_, other.plan_);
     }
 
     prefab& prefab::assign(prefab&& other) noexcept {
@@ -51,6 +53,7 @@ namespace e2d
             s.uuid_ = other.uuid_;
             s.children_ = other.children_;
             s.prototype_ = other.prototype_;
+            s.plan_ = other.plan_;
             swap(s);
         }
         return *this;
@@ -68,21 +71,25 @@ namespace e2d
 
     prefab& prefab::set_children(vector<prefab>&& children) noexcept {
         children_ = std::move(children);
+        plan_.reset();
         return *this;
     }
 
     prefab& prefab::set_children(const vector<prefab>& children) {
         children_ = children;
+        plan_.reset();
         return *this;
     }
 
     prefab& prefab::set_prototype(ecs::prototype&& prototype) noexcept {
         prototype_ = std::move(prototype);
+        plan_.reset();
         return *this;
     }
 
     prefab& prefab::set_prototype(const ecs::prototype& prototype) {
         prototype_ = prototype;
+        plan_.reset();
         return *this;
     }
 
@@ -95,6 +102,7 @@ namespace e2d
     }
 
     vector<prefab>& prefab::children() noexcept {
+        plan_.reset();
         return children_;
     }
 
@@ -103,12 +111,22 @@ namespace e2d
     }
 
     ecs::prototype& prefab::prototype() noexcept {
+        plan_.reset();
         return prototype_;
     }
 
     const ecs::prototype& prefab::prototype() const noexcept {
         return prototype_;
     }
+
+    prefab& prefab::compile_plan() {
+        plan_ = std::make_shared<prefab_plan>(*this);
+        return *this;
+    }
+
+    const prefab_plan_ptr& prefab::plan() const noexcept {
+        return plan_;
+    }
 }
 
 namespace e2d
@@ -117,3 +135,37 @@ namespace e2d
         l.swap(r);
     }
 }
+
+namespace e2d
+{
+    prefab_plan::prefab_plan(const prefab& root) {
+        vector<std::pair<const prefab*, u32>> stack{{&root, no_parent}};
+        while ( !stack.empty() ) {
+            const auto [p, parent] = stack.back();
+            stack.pop_back();
+
+            const u32 index = math::numeric_cast<u32>(prototypes_.size());
+            prototypes_.push_back(p->prototype());
+            parents_.push_back(parent);
+
+            const vector<prefab>& children = p->children();
+            for ( auto iter = children.rbegin(); iter != children.rend(); ++iter ) {
+                stack.emplace_back(&*iter, index);
+            }
+        }
+    }
+
+    std::size_t prefab_plan::size() const noexcept {
+        return prototypes_.size();
+    }
+
+    const ecs::prototype& prefab_plan::prototype(std::size_t index) const noexcept {
+        E2D_ASSERT(index < prototypes_.size());
+        return prototypes_[index];
+    }
+
+    u32 prefab_plan::parent(std::size_t index) const noexcept {
+        E2D_ASSERT(index < parents_.size());
+        return parents_[index];
+    }
+}
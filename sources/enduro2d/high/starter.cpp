@@ -10,6 +10,7 @@
 #include <enduro2d/high/factory.hpp>
 #include <enduro2d/high/inspector.hpp>
 #include <enduro2d/high/library.hpp>
+#include <enduro2d/high/system_scheduler.hpp>
 #include <enduro2d/high/world.hpp>
 
 #include <enduro2d/high/components/actor.hpp>
@@ -57,25 +58,39 @@ namespace
         : application_(std::move(application)) {}
 
         bool initialize() final {
+            using update_trigger = ecs::after<systems::update_event>;
+
+            // flipbook_system, label_system and widget_system run concurrently,
+            // layout_system adds and removes its yogo nodes, so it runs alone
+            the<world>().scheduler()
+                .add_system<update_trigger, flipbook_system>("flipbook_system", system_access()
+                    .writes<flipbook_player, sprite_renderer>())
+                .add_system<update_trigger, label_system>("label_system", system_access()
+                    .writes<label, label::dirty, renderer, model_renderer>()
+                    .main_thread(true))
+                .add_system<update_trigger, widget_system>("widget_system", system_access()
+                    .reads<actor, disabled<actor>, disabled<widget>, layout, widget>()
+                    .writes<widget::dirty, layout::dirty>())
+                .add_system<update_trigger, layout_system>("layout_system", system_access()
+                    .reads<disabled<actor>, disabled<widget>, layout, widget>()
+                    .writes<actor, layout::dirty, layout_system::yogo_node>()
+                    .exclusive(true))
+                .add_system<update_trigger, camera_system>("camera_system", system_access()
+                    .reads<actor>()
+                    .writes<camera>()
+                    .main_thread(true));
+
             ecs::registry_filler(the<world>().registry())
-                .feature<struct camera_feature>(ecs::feature()
-                    .add_system<camera_system>())
-                .feature<struct flipbook_feature>(ecs::feature()
-                    .add_system<flipbook_system>())
                 .feature<struct frame_feature>(ecs::feature()
                     .add_system<frame_system>())
                 .feature<struct gizmos_feature>(ecs::feature()
                     .add_system<gizmos_system>())
-                .feature<struct label_feature>(ecs::feature()
-                    .add_system<label_system>())
-                .feature<struct layout_feature>(ecs::feature()
-                    .add_system<layout_system>())
                 .feature<struct render_feature>(ecs::feature()
                     .add_system<render_system>())
+                .feature<struct scheduler_feature>(ecs::feature()
+                    .add_system<scheduled_systems<update_trigger>>(the<world>().scheduler()))
                 .feature<struct touch_feature>(ecs::feature()
                     .add_system<touch_system>())
-                .feature<struct widget_feature>(ecs::feature()
-                    .add_system<widget_system>())
                 .feature<struct world_feature>(ecs::feature()
                     .add_system<world_system>());
             return !application_ || application_->initialize();
@@ -99,6 +114,7 @@ namespace
 
         void frame_finalize() final {
             the<world>().registry().process_event(systems::frame_finalize_event{});
+            the<library>().trim_to_memory_budget();
         }
     private:
         starter::application_uptr application_;
@@ -131,10 +147,19 @@ namespace e2d
         return *this;
     }
 
+    starter::library_parameters& starter::library_parameters::memory_budget(std::size_t value) noexcept {
+        memory_budget_ = value;
+        return *this;
+    }
+
     const url& starter::library_parameters::root() const noexcept {
         return root_;
     }
 
+    std::size_t starter::library_parameters::memory_budget() const noexcept {
+        return memory_budget_;
+    }
+
     //
     // starter::parameters
     //
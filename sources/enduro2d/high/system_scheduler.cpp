@@ -0,0 +1,460 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/high/system_scheduler.hpp>
+
+#include <condition_variable>
+
+namespace
+{
+    using namespace e2d;
+
+    bool contains(const vector<utils::type_family_id>& ids, utils::type_family_id id) noexcept {
+        return std::binary_search(ids.begin(), ids.end(), id);
+    }
+
+    bool intersects(const vector<utils::type_family_id>& l, const vector<utils::type_family_id>& r) noexcept {
+        auto li = l.begin();
+        auto ri = r.begin();
+        while ( li != l.end() && ri != r.end() ) {
+            if ( *li < *ri ) {
+                ++li;
+            } else if ( *ri < *li ) {
+                ++ri;
+            } else {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void insert_sorted(vector<utils::type_family_id>& ids, utils::type_family_id id) {
+        const auto iter = std::lower_bound(ids.begin(), ids.end(), id);
+        if ( iter == ids.end() || *iter != id ) {
+            ids.insert(iter, id);
+        }
+    }
+}
+
+namespace e2d
+{
+    //
+    // system_access
+    //
+
+    system_access& system_access::phase(i32 value) noexcept {
+        phase_ = value;
+        return *this;
+    }
+
+    system_access& system_access::main_thread(bool value) noexcept {
+        main_thread_ = value;
+        return *this;
+    }
+
+    system_access& system_access::exclusive(bool value) noexcept {
+        exclusive_ = value;
+        return *this;
+    }
+
+    i32 system_access::phase() const noexcept {
+        return phase_;
+    }
+
+    bool system_access::main_thread() const noexcept {
+        return main_thread_;
+    }
+
+    bool system_access::exclusive() const noexcept {
+        return exclusive_;
+    }
+
+    bool system_access::can_read(utils::type_family_id type_id) const noexcept {
+        return contains(reads_, type_id)
+            || contains(writes_, type_id);
+    }
+
+    bool system_access::can_write(utils::type_family_id type_id) const noexcept {
+        return contains(writes_, type_id);
+    }
+
+    bool system_access::conflicts_with(const system_access& other) const noexcept {
+        return exclusive_
+            || other.exclusive_
+            || intersects(writes_, other.writes_)
+            || intersects(writes_, other.reads_)
+            || intersects(reads_, other.writes_);
+    }
+
+    void system_access::add_read_(utils::type_family_id type_id) {
+        insert_sorted(reads_, type_id);
+    }
+
+    void system_access::add_write_(utils::type_family_id type_id) {
+        insert_sorted(writes_, type_id);
+    }
+}
+
+namespace e2d
+{
+    //
+    // system_scheduler::system_base
+    //
+
+    system_scheduler::system_base::system_base(str name, system_access access)
+    : name(std::move(name))
+    , access(std::move(access)) {
+        timing.name = this->name;
+    }
+
+    system_scheduler::system_base::~system_base() noexcept = default;
+
+    //
+    // system_scheduler::event_group
+    //
+
+    class system_scheduler::event_group final : private noncopyable {
+    public:
+        vector<std::unique_ptr<system_base>> systems;
+
+        // systems sorted by phase and a dependency graph over that order
+        vector<system_base*> order;
+        vector<vector<std::size_t>> dependents;
+        vector<u32> dependency_counts;
+        bool graph_dirty{true};
+    public:
+        void build_graph() {
+            order.clear();
+            for ( const auto& system : systems ) {
+                order.push_back(system.get());
+            }
+
+            std::stable_sort(order.begin(), order.end(), [](
+                const system_base* l,
+                const system_base* r)
+            {
+                return l->access.phase() < r->access.phase();
+            });
+
+            dependents.assign(order.size(), {});
+            dependency_counts.assign(order.size(), 0u);
+
+            for ( std::size_t i = 0; i < order.size(); ++i ) {
+                for ( std::size_t j = 0; j < i; ++j ) {
+                    const system_access& prev = order[j]->access;
+                    const system_access& next = order[i]->access;
+                    if ( prev.phase() != next.phase() || prev.conflicts_with(next) ) {
+                        dependents[j].push_back(i);
+                        ++dependency_counts[i];
+                    }
+                }
+            }
+
+            graph_dirty = false;
+        }
+    };
+}
+
+namespace
+{
+    using namespace e2d;
+
+    //
+    // access checking
+    //
+
+    thread_local const system_access* current_access{nullptr};
+    thread_local const str* current_system_name{nullptr};
+    thread_local std::atomic<std::size_t>* current_violations{nullptr};
+
+    void check_component_access_hook(
+        utils::type_family_id type_id,
+        const char* type_name,
+        bool write) noexcept
+    {
+        if ( !current_access ) {
+            return;
+        }
+
+        const bool allowed = write
+            ? current_access->can_write(type_id)
+            : current_access->can_read(type_id);
+
+        if ( allowed ) {
+            return;
+        }
+
+        ++*current_violations;
+        if ( !modules::is_initialized<debug>() ) {
+            return;
+        }
+        try {
+            the<debug>().error("SYSTEM_SCHEDULER: Undeclared component access:\n"
+                "--> System: %0\n"
+                "--> Component: %1\n"
+                "--> Access: %2",
+                *current_system_name,
+                type_name,
+                write ? "write" : "read");
+        } catch (...) {
+            // nothing
+        }
+    }
+
+    class current_system_scope final : private noncopyable {
+    public:
+        current_system_scope(
+            const str& name,
+            const system_access& access,
+            std::atomic<std::size_t>& violations,
+            bool check_access) noexcept
+        : prev_access_(current_access)
+        , prev_name_(current_system_name)
+        , prev_violations_(current_violations)
+        , prev_hook_(detail::component_access_hook)
+        {
+            current_access = check_access ? &access : nullptr;
+            current_system_name = &name;
+            current_violations = &violations;
+            detail::component_access_hook = check_access
+                ? &check_component_access_hook
+                : nullptr;
+        }
+
+        ~current_system_scope() noexcept {
+            current_access = prev_access_;
+            current_system_name = prev_name_;
+            current_violations = prev_violations_;
+            detail::component_access_hook = prev_hook_;
+        }
+    private:
+        const system_access* prev_access_{nullptr};
+        const str* prev_name_{nullptr};
+        std::atomic<std::size_t>* prev_violations_{nullptr};
+        detail::component_access_hook_t prev_hook_{nullptr};
+    };
+}
+
+namespace e2d
+{
+    //
+    // system_scheduler
+    //
+
+    system_scheduler::system_scheduler() = default;
+    system_scheduler::~system_scheduler() noexcept = default;
+
+    system_scheduler& system_scheduler::parallel(bool value) noexcept {
+        parallel_ = value;
+        return *this;
+    }
+
+    bool system_scheduler::parallel() const noexcept {
+        return parallel_;
+    }
+
+    system_scheduler& system_scheduler::worker_threads(std::size_t value) {
+        if ( worker_threads_ != value ) {
+            worker_threads_ = value;
+            worker_.reset();
+        }
+        return *this;
+    }
+
+    std::size_t system_scheduler::worker_threads() const noexcept {
+        return worker_threads_
+            ? worker_threads_
+            : math::max(2u, std::thread::hardware_concurrency()) - 1u;
+    }
+
+    stdex::jobber& system_scheduler::worker() {
+        if ( !worker_ ) {
+            worker_ = std::make_unique<stdex::jobber>(worker_threads());
+        }
+        return *worker_;
+    }
+
+    system_scheduler& system_scheduler::check_access(bool value) noexcept {
+        check_access_ = value;
+        return *this;
+    }
+
+    bool system_scheduler::check_access() const noexcept {
+        return check_access_;
+    }
+
+    std::size_t system_scheduler::access_violations() const noexcept {
+        return access_violations_.load();
+    }
+
+    vector<system_scheduler::system_timing> system_scheduler::timings() const {
+        vector<system_timing> result;
+        for ( const event_group_uptr& group : groups_ ) {
+            if ( group ) {
+                for ( const auto& system : group->systems ) {
+                    result.push_back(system->timing);
+                }
+            }
+        }
+        return result;
+    }
+
+    str system_scheduler::timing_report() const {
+        str report;
+        for ( const system_timing& timing : timings() ) {
+            report += strings::rformat(
+                "%0: runs %1, last %2 ms, average %3 ms, max %4 ms\n",
+                timing.name,
+                timing.runs,
+                timing.last_ms,
+                timing.average_ms,
+                timing.max_ms);
+        }
+        return report;
+    }
+
+    void system_scheduler::add_system_(
+        utils::type_family_id event_id,
+        std::unique_ptr<system_base> system)
+    {
+        if ( event_id >= groups_.size() ) {
+            groups_.resize(event_id + 1u);
+        }
+        if ( !groups_[event_id] ) {
+            groups_[event_id] = std::make_unique<event_group>();
+        }
+        groups_[event_id]->systems.push_back(std::move(system));
+        groups_[event_id]->graph_dirty = true;
+    }
+
+    void system_scheduler::process_event_(
+        utils::type_family_id event_id,
+        ecs::registry& owner,
+        const void* event)
+    {
+        event_group* group = event_id < groups_.size()
+            ? groups_[event_id].get()
+            : nullptr;
+
+        if ( !group || group->systems.empty() ) {
+            return;
+        }
+
+        if ( group->graph_dirty ) {
+            group->build_graph();
+        }
+
+        const auto run_system = [this, &owner, event](system_base& system){
+            current_system_scope scope(
+                system.name,
+                system.access,
+                access_violations_,
+                check_access_);
+
+            const auto begin_us = time::now_us<u64>();
+            DEFER([&system, begin_us](){
+                const f32 ms = math::numeric_cast<f32>(
+                    (time::now_us<u64>() - begin_us).value) / 1000.f;
+                system_timing& timing = system.timing;
+                timing.last_ms = ms;
+                timing.max_ms = math::max(timing.max_ms, ms);
+                timing.average_ms += (ms - timing.average_ms) / math::numeric_cast<f32>(++timing.runs);
+            });
+
+            system.process(owner, event);
+        };
+
+        const std::size_t system_count = group->order.size();
+        if ( !parallel_ || system_count < 2u ) {
+            for ( system_base* system : group->order ) {
+                run_system(*system);
+            }
+            return;
+        }
+
+        stdex::jobber& worker = this->worker();
+
+        std::unique_ptr<std::atomic<u32>[]> remaining(new std::atomic<u32>[system_count]);
+        for ( std::size_t i = 0; i < system_count; ++i ) {
+            remaining[i].store(group->dependency_counts[i]);
+        }
+
+        // guards `main_queue` and `finished`, the main thread sleeps on
+        // `main_queue_cond` instead of running unrelated worker tasks
+        std::mutex main_queue_mutex;
+        std::condition_variable main_queue_cond;
+        vector<std::size_t> main_queue;
+        std::size_t finished{0u};
+
+        std::mutex error_mutex;
+        std::exception_ptr error;
+
+        // `finish` and `launch` call each other: a finished system
+        // launches every dependent whose last dependency it was
+        std::function<void(std::size_t)> launch;
+
+        const auto finish = [&](std::size_t index){
+            for ( std::size_t dependent : group->dependents[index] ) {
+                if ( 1u == remaining[dependent].fetch_sub(1u) ) {
+                    launch(dependent);
+                }
+            }
+            // notified under the lock, so the main thread cannot leave
+            // and destroy the locals of this call before it is released
+            std::lock_guard<std::mutex> guard(main_queue_mutex);
+            ++finished;
+            main_queue_cond.notify_one();
+        };
+
+        const auto run_and_finish = [&](std::size_t index){
+            try {
+                run_system(*group->order[index]);
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(error_mutex);
+                if ( !error ) {
+                    error = std::current_exception();
+                }
+            }
+            finish(index);
+        };
+
+        launch = [&](std::size_t index){
+            if ( group->order[index]->access.main_thread() ) {
+                std::lock_guard<std::mutex> guard(main_queue_mutex);
+                main_queue.push_back(index);
+                main_queue_cond.notify_one();
+            } else {
+                worker.async([&run_and_finish, index](){
+                    run_and_finish(index);
+                });
+            }
+        };
+
+        for ( std::size_t i = 0; i < system_count; ++i ) {
+            if ( 0u == group->dependency_counts[i] ) {
+                launch(i);
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(main_queue_mutex);
+        while ( finished < system_count ) {
+            if ( main_queue.empty() ) {
+                main_queue_cond.wait(lock);
+                continue;
+            }
+            const std::size_t index = main_queue.front();
+            main_queue.erase(main_queue.begin());
+            lock.unlock();
+            run_and_finish(index);
+            lock.lock();
+        }
+        lock.unlock();
+
+        if ( error ) {
+            std::rethrow_exception(error);
+        }
+    }
+}
@@ -15,7 +15,7 @@ namespace
 
     m4f make_camera_view(const actor& actor) noexcept {
         return actor.node()
-            ? math::inversed(actor.node()->world_matrix()).first
+            ? math::make_matrix4(math::inversed(actor.node()->world_matrix()).first)
             : m4f::identity();
     }
 
@@ -88,20 +88,34 @@ namespace e2d
         ~internal_state() noexcept = default;
 
         void process_update(ecs::registry& owner) {
-            owner.for_joined_components<camera, actor>([](
+            bool changed = false;
+
+            owner.for_joined_components<camera, actor>([&changed](
                 const ecs::const_entity&,
                 camera& c,
                 const actor& a)
             {
-                c.view(make_camera_view(a));
+                const m4f view = make_camera_view(a);
+                if ( c.view() != view ) {
+                    c.view(view);
+                    changed = true;
+                }
             });
 
-            owner.for_each_component<camera>([this](
+            owner.for_each_component<camera>([this, &changed](
                 const ecs::const_entity&,
                 camera& c)
             {
-                c.projection(make_camera_projection(c, window_));
+                const m4f projection = make_camera_projection(c, window_);
+                if ( c.projection() != projection ) {
+                    c.projection(projection);
+                    changed = true;
+                }
             });
+
+            if ( changed ) {
+                gcomponent<camera>::mark_changed();
+            }
         }
     private:
         window& window_;
@@ -13,61 +13,42 @@ namespace
 {
     using namespace e2d;
 
-    void update_flipbook_timers(f32 dt, ecs::registry& owner) {
-        owner.for_joined_components<flipbook_player>([dt](
-            const ecs::const_entity&,
-            flipbook_player& fp)
-        {
-            if ( fp.speed() <= 0.f || fp.stopped() ) {
-                return;
-            }
-            const flipbook_asset::ptr& flipbook_res = fp.flipbook();
-            if ( !flipbook_res ) {
-                return;
-            }
-            const flipbook& flipbook = flipbook_res->content();
-            const flipbook::sequence* sequence = flipbook.find_sequence(fp.sequence());
-            if ( !sequence || sequence->frames.empty() ) {
-                return;
-            }
-            fp.time(fp.time() + dt * fp.speed());
-            if ( sequence->fps > 0.f ) {
-                const f32 loop_time = sequence->frames.size() / sequence->fps;
-                if ( fp.time() >= loop_time ) {
-                    if ( fp.looped() ) {
-                        fp.time(math::mod(fp.time(), loop_time));
-                    } else {
-                        fp.stop(loop_time);
-                    }
-                }
-            }
-        });
+    constexpr std::size_t invalid_frame_index = ~std::size_t(0);
+
+    // the flipbook player keeps its flipbook, so the sequence pointer
+    // stays valid until the player version changes
+    struct player_state final {
+        ecs::entity_id id{};
+        u32 version{0u};
+        u64 ticket{0u};
+        const flipbook::sequence* sequence{nullptr};
+        std::size_t frame_index{invalid_frame_index};
+    };
+
+    // stale wakeups of restarted or destroyed players are skipped by the ticket
+    struct player_wakeup final {
+        f64 clock{0.0};
+        ecs::entity_id id{};
+        u64 ticket{0u};
+    };
+
+    bool operator<(const player_wakeup& l, const player_wakeup& r) noexcept {
+        // std heaps keep the greatest element first
+        return l.clock > r.clock;
     }
 
-    void update_flipbook_sprites(ecs::registry& owner) {
-        owner.for_joined_components<flipbook_player, sprite_renderer>([](
-            const ecs::const_entity&,
-            const flipbook_player& fp,
-            sprite_renderer& sr)
-        {
-            const flipbook_asset::ptr& flipbook_res = fp.flipbook();
-            if ( !flipbook_res ) {
-                sr.sprite(nullptr);
-                return;
-            }
-            const flipbook& flipbook = flipbook_res->content();
-            const flipbook::sequence* sequence = flipbook.find_sequence(fp.sequence());
-            if ( !sequence || sequence->frames.empty() ) {
-                sr.sprite(nullptr);
-                return;
-            }
-            const std::size_t frame_index = math::clamp<std::size_t>(
-                math::numeric_cast<std::size_t>(fp.time() * sequence->fps),
-                0u,
-                sequence->frames.size() - 1u);
-            const flipbook::frame* frame = flipbook.find_frame(sequence->frames[frame_index]);
-            sr.sprite(frame ? frame->sprite : nullptr);
-        });
+    f32 sequence_loop_time(const flipbook::sequence* sequence) noexcept {
+        return sequence && sequence->fps > 0.f
+            ? sequence->frames.size() / sequence->fps
+            : 0.f;
+    }
+
+    bool change_sprite(sprite_renderer* sr, const sprite_asset::ptr& sprite) {
+        if ( sr && sr->sprite() != sprite ) {
+            sr->sprite(sprite);
+            return true;
+        }
+        return false;
     }
 }
 
@@ -76,16 +57,157 @@ namespace e2d
     //
     // flipbook_system::internal_state
     //
+    // Playing players wait in a min-heap keyed by the clock of their next
+    // frame boundary, so a player is touched only when its frame changes
+    // or its sequence ends. flipbook_player::time() follows the system
+    // clock in between. The players are scanned only when the version of
+    // gcomponent<flipbook_player> changes: new players are started and
+    // players with a new version are restarted. The player states live
+    // here and not in the registry, so the system never adds components.
+    //
 
     class flipbook_system::internal_state final : private noncopyable {
     public:
-        internal_state() = default;
+        internal_state()
+        : clock_(std::make_shared<f64>(0.0)) {}
         ~internal_state() noexcept = default;
 
         void process_update(f32 dt, ecs::registry& owner) {
-            update_flipbook_timers(dt, owner);
-            update_flipbook_sprites(owner);
+            sprites_changed_ = false;
+
+            if ( gcomponent<flipbook_player>::changed_since(seen_version_) ) {
+                seen_version_ = versions::current();
+                restart_changed_players_(owner);
+            }
+
+            *clock_ += dt;
+            wake_due_players_(owner);
+
+            if ( sprites_changed_ ) {
+                gcomponent<sprite_renderer>::mark_changed();
+            }
+        }
+    private:
+        // new players have no state yet or the state of a destroyed entity
+        void restart_changed_players_(ecs::registry& owner) {
+            owner.for_each_component<flipbook_player>([this](
+                ecs::entity e,
+                flipbook_player& fp)
+            {
+                player_state& state = state_slot_(e.id());
+                if ( state.id != e.id() || state.version != fp.version() ) {
+                    state.id = e.id();
+                    restart_player_(e, fp, state);
+                }
+            });
+        }
+
+        player_state& state_slot_(ecs::entity_id id) {
+            const std::size_t index = ecs::detail::entity_id_index(id);
+            if ( index >= states_.size() ) {
+                states_.resize(math::max(index + 1u, states_.size() * 2u));
+            }
+            return states_[index];
+        }
+
+        void wake_due_players_(ecs::registry& owner) {
+            while ( !wakeups_.empty() && wakeups_.front().clock <= *clock_ ) {
+                std::pop_heap(wakeups_.begin(), wakeups_.end());
+                const player_wakeup wakeup = wakeups_.back();
+                wakeups_.pop_back();
+
+                player_state& state = states_[ecs::detail::entity_id_index(wakeup.id)];
+                if ( state.id != wakeup.id || state.ticket != wakeup.ticket ) {
+                    continue;
+                }
+
+                ecs::entity e{owner, wakeup.id};
+                flipbook_player* fp = e.valid()
+                    ? e.find_component<flipbook_player>()
+                    : nullptr;
+                if ( !fp ) {
+                    state = player_state();
+                    continue;
+                }
+
+                if ( state.version != fp->version() ) {
+                    // edited since the last scan, the next scan restarts it
+                    continue;
+                }
+
+                update_player_(e, *fp, state);
+            }
+        }
+
+        void restart_player_(ecs::entity& e, flipbook_player& fp, player_state& state) {
+            const flipbook_asset::ptr& flipbook_res = fp.flipbook();
+            state.version = fp.version();
+            state.ticket = ++last_ticket_;
+            state.sequence = flipbook_res
+                ? flipbook_res->content().find_sequence(fp.sequence())
+                : nullptr;
+            state.frame_index = invalid_frame_index;
+            fp.bind_clock(clock_, sequence_loop_time(state.sequence));
+            update_player_(e, fp, state);
+        }
+
+        void update_player_(ecs::entity& e, flipbook_player& fp, player_state& state) {
+            const flipbook::sequence* sequence = state.sequence;
+            if ( !sequence || sequence->frames.empty() ) {
+                sprites_changed_ |= change_sprite(e.find_component<sprite_renderer>(), nullptr);
+                return;
+            }
+
+            const f32 loop_time = sequence_loop_time(sequence);
+            const f32 time = fp.time();
+
+            if ( fp.playing() && !fp.looped() && loop_time > 0.f && time >= loop_time ) {
+                fp.finish(loop_time);
+            }
+
+            const std::size_t frame_index = math::clamp<std::size_t>(
+                math::numeric_cast<std::size_t>(time * sequence->fps),
+                0u,
+                sequence->frames.size() - 1u);
+
+            if ( state.frame_index != frame_index ) {
+                state.frame_index = frame_index;
+                const flipbook::frame* frame = fp.flipbook()->content().find_frame(
+                    sequence->frames[frame_index]);
+                sprites_changed_ |= change_sprite(
+                    e.find_component<sprite_renderer>(),
+                    frame ? frame->sprite : nullptr);
+            }
+
+            if ( fp.playing() && fp.speed() > 0.f && sequence->fps > 0.f ) {
+                schedule_(e.id(), state, frame_index, time, fp.speed(), sequence->fps);
+            }
+        }
+
+        void schedule_(
+            ecs::entity_id id,
+            const player_state& state,
+            std::size_t frame_index,
+            f32 time,
+            f32 speed,
+            f32 fps)
+        {
+            const f32 next_time = (frame_index + 1u) / fps;
+            const f64 wake_clock = *clock_ + math::max(0.f, next_time - time) / speed;
+            // due players are never woken twice in one update
+            wakeups_.push_back({
+                math::max(wake_clock, std::nextafter(*clock_, std::numeric_limits<f64>::max())),
+                id,
+                state.ticket});
+            std::push_heap(wakeups_.begin(), wakeups_.end());
         }
+    private:
+        std::shared_ptr<f64> clock_;
+        vector<player_state> states_;
+        vector<player_wakeup> wakeups_;
+        u32 seen_version_{0u};
+        u64 last_ticket_{0u};
+        bool sprites_changed_{false};
     };
 
     //
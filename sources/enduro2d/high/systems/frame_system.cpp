@@ -23,11 +23,10 @@ namespace
     }
 
     template < typename Event >
-    void for_all_cameras(ecs::registry& owner) {
-        const auto comp = [](const auto& l, const auto& r) noexcept {
-            return std::get<camera>(l).depth() < std::get<camera>(r).depth();
-        };
-
+    void for_all_cameras(
+        ecs::registry& owner,
+        const ecsex::depth_sorted_entities<camera>& cameras)
+    {
         const auto func = [&owner](
             const ecs::const_entity& e,
             const camera&)
@@ -35,9 +34,8 @@ namespace
             owner.process_event(Event{e});
         };
 
-        ecsex::for_extracted_sorted_components<camera>(
+        cameras.for_each(
             owner,
-            comp,
             func,
             !ecs::exists<disabled<camera>>());
     }
@@ -69,14 +67,16 @@ namespace e2d
         void process_frame_render(ecs::registry& owner) {
             clear_framebuffer(render_, window_);
 
-            for_all_cameras<systems::pre_render_event>(owner);
-            for_all_cameras<systems::render_event>(owner);
-            for_all_cameras<systems::post_render_event>(owner);
+            cameras_.update(owner);
+            for_all_cameras<systems::pre_render_event>(owner, cameras_);
+            for_all_cameras<systems::render_event>(owner, cameras_);
+            for_all_cameras<systems::post_render_event>(owner, cameras_);
         }
     private:
         engine& engine_;
         render& render_;
         window& window_;
+        ecsex::depth_sorted_entities<camera> cameras_;
     };
 
     //
@@ -75,7 +75,7 @@ namespace
                 return false;
             }
 
-            go_matrix_ = e_n->world_matrix() * camera_vp_;
+            go_matrix_ = math::make_matrix4(e_n->world_matrix()) * camera_vp_;
             go_selected_ = e_go == editor_.selection();
             return true;
         }
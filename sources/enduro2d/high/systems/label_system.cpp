@@ -13,6 +13,8 @@
 #include <enduro2d/high/components/renderer.hpp>
 #include <enduro2d/high/components/model_renderer.hpp>
 
+#include <enduro2d/high/world.hpp>
+
 namespace
 {
     using namespace e2d;
@@ -189,9 +191,9 @@ namespace
             .property("u_outline_color", outline_color));
     }
 
-    void update_label_geometry(const label& l, model_renderer& mr, geometry_builder& gb) {
+    template < typename F >
+    void for_each_label_glyph(const label& l, F&& func) {
         if ( !l.font() || l.font()->content().empty() || l.text().empty() ) {
-            gb.update_model(mr);
             return;
         }
 
@@ -207,13 +209,11 @@ namespace
             f32 kerning{0.f};
         };
 
-        //TODO(BlackMat): replace it to frame allocator
-        static thread_local vector<glyph_desc> glyphs;
-        glyphs.clear();
+        frame_allocator::scope frame_scope;
 
-        if ( glyphs.capacity() < text.size() ) {
-            glyphs.reserve(math::max(glyphs.capacity() * 2u, text.size()));
-        }
+        linear_vector<glyph_desc> glyphs(
+            frame_scope.allocator<glyph_desc>());
+        glyphs.reserve(text.size());
 
         for ( std::size_t i = 0, e = text.size(); i < e; ++i ) {
             glyph_desc desc;
@@ -248,14 +248,9 @@ namespace
             : start(start) {}
         };
 
-        //TODO(BlackMat): replace it to frame allocator
-        static thread_local vector<string_desc> strings;
-        strings.clear();
-
-        const std::size_t string_count = calculate_string_count(text);
-        if ( strings.capacity() < string_count ) {
-            strings.reserve(math::max(strings.capacity() * 2u, string_count));
-        }
+        linear_vector<string_desc> strings(
+            frame_scope.allocator<string_desc>());
+        strings.reserve(calculate_string_count(text));
 
         f32 last_space_width = 0.f;
         std::size_t last_space_index = std::size_t(-1);
@@ -337,33 +332,53 @@ namespace
                 texrect.position /= f.info().atlas_size.cast_to<f32>();
                 texrect.size /= f.info().atlas_size.cast_to<f32>();
 
-                gb.add_quad(rect, texrect, l.tint());
+                func(rect, texrect);
                 cursor.x += glyph.glyph->advance + tracking_width;
             }
             cursor.y -= f.info().line_height * l.leading();
         }
+    }
 
-        //
-        // update model
-        //
-
+    void update_label_geometry(const label& l, model_renderer& mr, geometry_builder& gb) {
+        for_each_label_glyph(l, [&l, &gb](const b2f& rect, const b2f& texrect){
+            gb.add_quad(rect, texrect, l.tint());
+        });
         gb.update_model(mr);
     }
 
-    void update_dirty_labels(ecs::registry& owner) {
+    void update_label_glyph_quads(label& l) {
+        vector<label::glyph_quad> quads = std::move(l.glyph_quads());
+        quads.clear();
+        for_each_label_glyph(l, [&quads](const b2f& rect, const b2f& texrect){
+            quads.push_back({rect, texrect});
+        });
+        l.glyph_quads(std::move(quads));
+    }
+
+    void update_dirty_labels(ecs::registry& owner, ecsex::change_set& changes) {
+        if ( changes.empty() ) {
+            return;
+        }
+        DEFER([&changes](){ changes.clear(); });
+
+        gcomponent<label>::mark_changed();
+        gcomponent<renderer>::mark_changed();
+        gcomponent<model_renderer>::mark_changed();
+
         geometry_builder gb;
-        owner.for_joined_components<label::dirty, label, renderer, model_renderer>([&gb](
-            const ecs::const_entity&,
-            const label::dirty&,
-            const label& l,
-            renderer& r,
-            model_renderer& mr
+        ecsex::for_joined_changed_components<label, renderer>(changes, owner, [&gb](
+            ecs::entity& e,
+            label& l,
+            renderer& r
         ){
             update_label_material(l, r);
-            update_label_geometry(l, mr, gb);
-            gb.clear();
+            if ( model_renderer* mr = e.find_component<model_renderer>() ) {
+                update_label_geometry(l, *mr, gb);
+                gb.clear();
+            } else {
+                update_label_glyph_quads(l);
+            }
         });
-        owner.remove_all_components<label::dirty>();
     }
 }
 
@@ -375,12 +390,16 @@ namespace e2d
 
     class label_system::internal_state final : private noncopyable {
     public:
-        internal_state() = default;
+        // the change set is created here, the scheduler threads only look it up
+        internal_state(world& w)
+        : changes_(w.changes<label::dirty>()) {}
         ~internal_state() noexcept = default;
 
         void process_update(ecs::registry& owner) {
-            update_dirty_labels(owner);
+            update_dirty_labels(owner, changes_);
         }
+    private:
+        ecsex::change_set& changes_;
     };
 
     //
@@ -388,7 +407,7 @@ namespace e2d
     //
 
     label_system::label_system()
-    : state_(new internal_state()) {}
+    : state_(new internal_state(the<world>())) {}
     label_system::~label_system() noexcept = default;
 
     void label_system::process(
@@ -11,17 +11,24 @@
 #include <enduro2d/high/components/layout.hpp>
 #include <enduro2d/high/components/widget.hpp>
 
+#include <enduro2d/high/world.hpp>
+
 #include <3rdparty/yoga/Yoga.h>
 
-namespace
+namespace e2d
 {
-    using namespace e2d;
-
-    struct yogo_node final {
+    struct layout_system::yogo_node final {
         using node_ptr = std::shared_ptr<YGNode>;
         node_ptr as_item{YGNodeNew(), YGNodeFree};
         node_ptr as_root{YGNodeNew(), YGNodeFree};
+        u32 hierarchy_version{0u};
     };
+}
+
+namespace
+{
+    using namespace e2d;
+    using yogo_node = layout_system::yogo_node;
 
     YGDirection convert_to_yogo_direction(layout::directions direction) noexcept {
         switch ( direction ) {
@@ -110,6 +117,7 @@ namespace
         YGNodeStyleSetPadding(yn.as_root.get(), YGEdgeHorizontal, w.padding().x);
         YGNodeStyleSetPadding(yn.as_root.get(), YGEdgeVertical, w.padding().y);
 
+        YGNodeStyleSetDirection(yn.as_root.get(), convert_to_yogo_direction(l.direction()));
         YGNodeStyleSetAlignItems(yn.as_root.get(), convert_to_yogo_align(l.align_items()));
         YGNodeStyleSetAlignContent(yn.as_root.get(), convert_to_yogo_align(l.align_content()));
         YGNodeStyleSetJustifyContent(yn.as_root.get(), convert_to_yogo_justify(l.justify_content()));
@@ -134,17 +142,154 @@ namespace
 {
     using namespace e2d;
 
-    void update_yogo_nodes(ecs::registry& owner) {
+    void attach_yogo_child(YGNodeRef parent, YGNodeRef child, u32 index) {
+        if ( index < YGNodeGetChildCount(parent) && YGNodeGetChild(parent, index) == child ) {
+            return;
+        }
+
+        if ( YGNodeRef child_owner = YGNodeGetOwner(child) ) {
+            YGNodeRemoveChild(child_owner, child);
+        }
+
+        YGNodeInsertChild(parent, child, index);
+    }
+
+    void detach_yogo_children(YGNodeRef parent, u32 first) {
+        while ( YGNodeGetChildCount(parent) > first ) {
+            YGNodeRemoveChild(
+                parent,
+                YGNodeGetChild(parent, YGNodeGetChildCount(parent) - 1u));
+        }
+    }
+
+    void detach_yogo_node(YGNodeRef node) {
+        if ( YGNodeRef node_owner = YGNodeGetOwner(node) ) {
+            YGNodeRemoveChild(node_owner, node);
+        }
+    }
+
+    // widget items are children of the parent layout 'as_root' and
+    // a nested layout 'as_root' is the only child of its own 'as_item',
+    // so the whole layout hierarchy is calculated from the top root
+
+    void sync_yogo_nested_root(const yogo_node& root_yn, const actor& root_a) {
+        const const_node_iptr root_n = root_a.node();
+        const const_node_iptr parent_n = root_n ? root_n->parent() : nullptr;
+
+        const_gcomponent<layout> parent_l{parent_n ? parent_n->owner() : gobject()};
+        const_gcomponent<yogo_node> parent_yn{parent_n ? parent_n->owner() : gobject()};
+
+        const bool nested =
+            parent_l &&
+            parent_yn &&
+            YGNodeGetOwner(root_yn.as_item.get()) == parent_yn->as_root.get();
+
+        if ( nested ) {
+            YGNodeStyleSetPositionType(root_yn.as_root.get(), YGPositionTypeAbsolute);
+            attach_yogo_child(root_yn.as_item.get(), root_yn.as_root.get(), 0u);
+            detach_yogo_children(root_yn.as_item.get(), 1u);
+        } else {
+            YGNodeStyleSetPositionType(root_yn.as_root.get(), YGPositionTypeRelative);
+            detach_yogo_node(root_yn.as_root.get());
+        }
+    }
+
+    void sync_yogo_children(const yogo_node& root_yn, const actor& root_a) {
+        u32 child_index = 0u;
+        nodes::for_each_child(root_a.node(), [&root_yn, &child_index](const const_node_iptr& child){
+            const_gcomponent<widget> item_w{child->owner()};
+            const_gcomponent<actor> item_a{child->owner()};
+            const_gcomponent<yogo_node> item_yn{child->owner()};
+            if ( !item_w || !item_a || !item_yn ) {
+                return;
+            }
+
+            update_yogo_widget(*item_yn, *item_w, *item_a);
+            attach_yogo_child(root_yn.as_root.get(), item_yn->as_item.get(), child_index++);
+
+            if ( !child->owner().component<layout>() ) {
+                detach_yogo_children(item_yn->as_item.get(), 0u);
+            }
+        });
+        detach_yogo_children(root_yn.as_root.get(), child_index);
+    }
+
+    const_node_iptr find_yogo_top_root(const actor& root_a) {
+        const_node_iptr top_n = root_a.node();
+        while ( top_n && top_n->has_parent() ) {
+            const_gcomponent<yogo_node> top_yn{top_n->owner()};
+            const_gcomponent<yogo_node> parent_yn{top_n->parent()->owner()};
+
+            const bool nested =
+                top_yn &&
+                parent_yn &&
+                YGNodeGetOwner(top_yn->as_root.get()) == top_yn->as_item.get() &&
+                YGNodeGetOwner(top_yn->as_item.get()) == parent_yn->as_root.get();
+
+            if ( !nested ) {
+                break;
+            }
+
+            top_n = top_n->parent();
+        }
+        return top_n;
+    }
+
+    void apply_yogo_layout(const const_node_iptr& root_n, const yogo_node& root_yn) {
+        nodes::for_each_child(root_n, [&root_yn](const const_node_iptr& child){
+            gcomponent<actor> item_a{child->owner()};
+            const_gcomponent<yogo_node> item_yn{child->owner()};
+            if ( !item_a || !item_a->node() || !item_yn ) {
+                return;
+            }
+
+            YGNodeRef item_yg = item_yn->as_item.get();
+            if ( YGNodeGetOwner(item_yg) != root_yn.as_root.get() ) {
+                return;
+            }
+
+            // yoga does not flag nodes whose layout is unchanged, but their
+            // translations may have been moved since, so compare every item
+            YGNodeSetHasNewLayout(item_yg, false);
+
+            const v2f item_translation = v2f(
+                YGNodeLayoutGetLeft(item_yg),
+                YGNodeLayoutGetTop(item_yg));
+
+            if ( item_a->node()->translation() != item_translation ) {
+                item_a->node()->translation(item_translation);
+            }
+
+            YGNodeRef nested_yg = item_yn->as_root.get();
+            if ( YGNodeGetOwner(nested_yg) == item_yg ) {
+                YGNodeSetHasNewLayout(nested_yg, false);
+                apply_yogo_layout(child, *item_yn);
+            }
+        });
+    }
+}
+
+namespace
+{
+    using namespace e2d;
+
+    void mark_layout_dirty(ecsex::change_set& changes, const gcomponent<layout>& l) {
+        if ( l ) {
+            changes.mark(l.owner().raw_entity().id());
+        }
+    }
+
+    void update_yogo_nodes(ecs::registry& owner, ecsex::change_set& changes) {
         ecsex::remove_all_components_with_disposer<yogo_node>(
             owner,
-            [](ecs::entity e, const yogo_node&){
+            [&changes](ecs::entity e, const yogo_node&){
                 if ( const actor* a = e.find_component<actor>();
                     a && a->node() && a->node()->owner() )
                 {
                     gcomponent<layout> l{a->node()->owner()};
                     gcomponent<widget> w{a->node()->owner()};
-                    layouts::mark_dirty(l);
-                    layouts::mark_dirty(widgets::find_parent_layout(w));
+                    mark_layout_dirty(changes, l);
+                    mark_layout_dirty(changes, widgets::find_parent_layout(w));
                 }
             }, !ecs::exists_all<
                 actor,
@@ -153,79 +298,103 @@ namespace
                 disabled<actor>,
                 disabled<widget>>());
 
-        owner.for_joined_components<widget, actor>([](
-            ecs::entity e,
+        ecsex::command_buffer commands;
+        owner.for_joined_components<widget, actor>([&commands, &changes](
+            const ecs::entity& e,
             const widget&,
             const actor& a)
         {
-            e.ensure_component<yogo_node>();
+            commands.ensure_component<yogo_node>(e);
             if ( a.node() && a.node()->owner() ) {
                 gcomponent<layout> l{a.node()->owner()};
                 gcomponent<widget> w{a.node()->owner()};
-                layouts::mark_dirty(l);
-                layouts::mark_dirty(widgets::find_parent_layout(w));
+                mark_layout_dirty(changes, l);
+                mark_layout_dirty(changes, widgets::find_parent_layout(w));
             }
         }, !ecs::exists_any<
             yogo_node,
             disabled<actor>,
             disabled<widget>>());
+        commands.playback(owner);
+
+        // children added, removed or reordered since the last sync
+        owner.for_joined_components<yogo_node, layout, actor>([&changes](
+            const ecs::entity& e,
+            yogo_node& yn,
+            const layout&,
+            const actor& a)
+        {
+            const u32 hierarchy_version = a.node()
+                ? a.node()->hierarchy_version()
+                : 0u;
+            if ( yn.hierarchy_version != hierarchy_version ) {
+                yn.hierarchy_version = hierarchy_version;
+                changes.mark(e.id());
+            }
+        }, !ecs::exists_any<
+            disabled<actor>,
+            disabled<widget>>());
     }
 
-    void update_dirty_layouts(ecs::registry& owner) {
-        owner.for_joined_components<layout::dirty, yogo_node, layout, widget, actor>([](
-            const ecs::const_entity&,
-            const layout::dirty&,
+    void update_dirty_layouts(ecs::registry& owner, ecsex::change_set& changes) {
+        frame_allocator::scope frame_scope;
+        linear_vector<const_node_iptr> top_roots(
+            frame_scope.allocator<const_node_iptr>());
+
+        if ( changes.empty() ) {
+            return;
+        }
+        DEFER([&changes](){ changes.clear(); });
+
+        ecsex::for_joined_changed_components<yogo_node, layout, widget, actor>(changes, owner, [](
+            const ecs::entity&,
             const yogo_node& root_yn,
             const layout& root_l,
             const widget& root_w,
             const actor& root_a)
         {
-            static thread_local vector<gcomponent<widget>> item_ws;
-            DEFER([](){ item_ws.clear(); });
+            update_yogo_layout(root_yn, root_l, root_w);
+            sync_yogo_children(root_yn, root_a);
+        });
 
-            nodes::extract_components_from_children<widget>(
-                root_a.node(),
-                std::back_inserter(item_ws));
+        ecsex::for_joined_changed_components<yogo_node, actor>(changes, owner, [](
+            const ecs::entity&,
+            const yogo_node& root_yn,
+            const actor& root_a)
+        {
+            sync_yogo_nested_root(root_yn, root_a);
+        });
 
-            DEFER([&root_yn](){
-                YGNodeRemoveAllChildren(root_yn.as_root.get());
-            });
+        ecsex::for_joined_changed_components<yogo_node, actor>(changes, owner, [&top_roots](
+            const ecs::entity&,
+            const yogo_node&,
+            const actor& root_a)
+        {
+            if ( const_node_iptr top_n = find_yogo_top_root(root_a) ) {
+                top_roots.push_back(std::move(top_n));
+            }
+        });
 
-            update_yogo_layout(root_yn, root_l, root_w);
+        std::sort(top_roots.begin(), top_roots.end());
+        top_roots.erase(
+            std::unique(top_roots.begin(), top_roots.end()),
+            top_roots.end());
 
-            for ( const auto& item_w : item_ws ) {
-                const_gcomponent<actor> item_a{item_w.owner()};
-                const_gcomponent<yogo_node> item_yn{item_w.owner()};
-                if ( item_a && item_yn ) {
-                    update_yogo_widget(
-                        *item_yn,
-                        *item_w,
-                        *item_a);
-                    YGNodeInsertChild(
-                        root_yn.as_root.get(),
-                        item_yn->as_item.get(),
-                        YGNodeGetChildCount(root_yn.as_root.get()));
-                }
+        for ( const const_node_iptr& top_n : top_roots ) {
+            const_gcomponent<yogo_node> top_yn{top_n->owner()};
+            if ( !top_yn ) {
+                continue;
             }
 
             YGNodeCalculateLayout(
-                root_yn.as_root.get(),
+                top_yn->as_root.get(),
                 YGUndefined,
                 YGUndefined,
-                convert_to_yogo_direction(root_l.direction()));
-
-            for ( const auto& item_w : item_ws ) {
-                gcomponent<actor> item_a{item_w.owner()};
-                const_gcomponent<yogo_node> item_yn{item_w.owner()};
-                if ( item_a && item_a->node() && item_yn && item_yn->as_item ) {
-                    item_a->node()->translation(v2f(
-                        YGNodeLayoutGetLeft(item_yn->as_item.get()),
-                        YGNodeLayoutGetTop(item_yn->as_item.get())));
-                }
-            }
-        });
+                YGDirectionLTR);
 
-        owner.remove_all_components<layout::dirty>();
+            YGNodeSetHasNewLayout(top_yn->as_root.get(), false);
+            apply_yogo_layout(top_n, *top_yn);
+        }
     }
 }
 
@@ -237,13 +406,17 @@ namespace e2d
 
     class layout_system::internal_state final : private noncopyable {
     public:
-        internal_state() = default;
+        // the change set is created here, the scheduler threads only look it up
+        internal_state(world& w)
+        : changes_(w.changes<layout::dirty>()) {}
         ~internal_state() noexcept = default;
 
         void process_update(ecs::registry& owner) {
-            update_yogo_nodes(owner);
-            update_dirty_layouts(owner);
+            update_yogo_nodes(owner, changes_);
+            update_dirty_layouts(owner, changes_);
         }
+    private:
+        ecsex::change_set& changes_;
     };
 
     //
@@ -251,7 +424,7 @@ namespace e2d
     //
 
     layout_system::layout_system()
-    : state_(new internal_state()) {}
+    : state_(new internal_state(the<world>())) {}
     layout_system::~layout_system() noexcept = default;
 
     void layout_system::process(
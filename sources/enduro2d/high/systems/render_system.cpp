@@ -31,11 +31,11 @@ namespace
         });
     }
 
-    void for_all_scenes(drawer::context& ctx, const ecs::registry& owner) {
-        const auto comp = [](const auto& l, const auto& r) noexcept {
-            return std::get<scene>(l).depth() < std::get<scene>(r).depth();
-        };
-
+    void for_all_scenes(
+        drawer::context& ctx,
+        const ecs::registry& owner,
+        const ecsex::depth_sorted_entities<scene>& scenes)
+    {
         const auto func = [&ctx](
             const ecs::const_entity&,
             const scene&,
@@ -44,9 +44,8 @@ namespace
             for_all_children(scene_a.node(), ctx);
         };
 
-        ecsex::for_extracted_sorted_components<scene, actor>(
+        scenes.for_each<actor>(
             owner,
-            comp,
             func,
             !ecs::exists_any<
                 disabled<actor>,
@@ -70,14 +69,16 @@ namespace e2d
             if ( !cam_e.valid() || !cam_e.exists_component<camera>() ) {
                 return;
             }
+            scenes_.update(owner);
             drawer_.with(
                 cam_e.get_component<camera>(),
-                [&owner](drawer::context& ctx){
-                    for_all_scenes(ctx, owner);
+                [this, &owner](drawer::context& ctx){
+                    for_all_scenes(ctx, owner, scenes_);
                 });
         }
     private:
         drawer drawer_;
+        ecsex::depth_sorted_entities<scene> scenes_;
     };
 
     //
@@ -7,6 +7,7 @@
 #include "render_system_drawer.hpp"
 
 #include <enduro2d/high/components/disabled.hpp>
+#include <enduro2d/high/components/label.hpp>
 #include <enduro2d/high/components/model_renderer.hpp>
 #include <enduro2d/high/components/renderer.hpp>
 #include <enduro2d/high/components/sprite_renderer.hpp>
@@ -29,6 +30,28 @@ namespace
     const str_hash additive_material_hash = "additive";
     const str_hash multiply_material_hash = "multiply";
     const str_hash screen_material_hash = "screen";
+
+    bool is_planar_trs(const t3f& trs) noexcept {
+        return math::is_near_zero(trs.translation.z)
+            && math::is_near_zero(trs.rotation.x)
+            && math::is_near_zero(trs.rotation.y);
+    }
+
+    m3x2f make_planar_trs_matrix3x2(const t3f& trs) noexcept {
+        E2D_ASSERT(is_planar_trs(trs));
+        return math::make_trs_matrix3x2(t2f(
+            v2f(trs.translation),
+            trs.rotation.z,
+            v2f(trs.scale)));
+    }
+
+    v3f transform_position(const v2f& p, const m3x2f& m) noexcept {
+        return v3f(p * m, 0.f);
+    }
+
+    v3f transform_position(const v2f& p, const m4f& m) noexcept {
+        return v3f(v4f(p, 0.f, 1.f) * m);
+    }
 }
 
 namespace e2d::render_system_impl
@@ -92,16 +115,40 @@ namespace e2d::render_system_impl
             return;
         }
 
-        const m4f& model_m =
-            math::make_trs_matrix4(node_r->transform()) *
-            node->world_matrix();
+        const m3x2f& world_m = node->world_matrix();
 
         if ( auto mdl_r = gcomponent<model_renderer>{owner} ) {
+            const m4f model_m =
+                math::make_trs_matrix4(node_r->transform()) *
+                math::make_matrix4(world_m);
             draw(model_m, *node_r, *mdl_r);
         }
 
-        if ( auto spr_r = gcomponent<sprite_renderer>{owner} ) {
-            draw(model_m, *node_r, *spr_r);
+        const auto spr_r = gcomponent<sprite_renderer>{owner};
+        const auto lbl = gcomponent<label>{owner};
+        const bool draw_label = lbl && !owner.component<model_renderer>();
+
+        const auto draw_quads = [&](const auto& model_m){
+            if ( spr_r ) {
+                draw(model_m, *node_r, *spr_r);
+            }
+            if ( draw_label ) {
+                draw(model_m, *node_r, *lbl);
+            }
+        };
+
+        // sprites and labels use the compact matrix unless the renderer
+        // transform leaves the plane, then they take the model path
+        if ( !spr_r && !draw_label ) {
+            return;
+        } else if ( is_planar_trs(node_r->transform()) ) {
+            draw_quads(
+                make_planar_trs_matrix3x2(node_r->transform()) *
+                world_m);
+        } else {
+            draw_quads(
+                math::make_trs_matrix4(node_r->transform()) *
+                math::make_matrix4(world_m));
         }
     }
 
@@ -148,8 +195,9 @@ namespace e2d::render_system_impl
         }
     }
 
+    template < typename Matrix >
     void drawer::context::draw(
-        const m4f& model_m,
+        const Matrix& model_m,
         const renderer& node_r,
         const sprite_renderer& spr_r)
     {
@@ -241,10 +289,10 @@ namespace e2d::render_system_impl
             };
 
             const batcher_type::vertex_type vertices[] = {
-                { v3f{v4f{pos_xs[0], pos_ys[0], 0.f, 1.f} * model_m}, v2f{tex_xs[0], tex_ys[0]}, tc },
-                { v3f{v4f{pos_xs[1], pos_ys[0], 0.f, 1.f} * model_m}, v2f{tex_xs[1], tex_ys[0]}, tc },
-                { v3f{v4f{pos_xs[0], pos_ys[1], 0.f, 1.f} * model_m}, v2f{tex_xs[0], tex_ys[1]}, tc },
-                { v3f{v4f{pos_xs[1], pos_ys[1], 0.f, 1.f} * model_m}, v2f{tex_xs[1], tex_ys[1]}, tc },
+                { transform_position(v2f{pos_xs[0], pos_ys[0]}, model_m), v2f{tex_xs[0], tex_ys[0]}, tc },
+                { transform_position(v2f{pos_xs[1], pos_ys[0]}, model_m), v2f{tex_xs[1], tex_ys[0]}, tc },
+                { transform_position(v2f{pos_xs[0], pos_ys[1]}, model_m), v2f{tex_xs[0], tex_ys[1]}, tc },
+                { transform_position(v2f{pos_xs[1], pos_ys[1]}, model_m), v2f{tex_xs[1], tex_ys[1]}, tc },
             };
 
             batcher_.batch(
@@ -327,25 +375,25 @@ namespace e2d::render_system_impl
             };
 
             const batcher_type::vertex_type vertices[] = {
-                { v3f{v4f{pos_xs[0], pos_ys[0], 0.f, 1.f} * model_m}, v2f{tex_xs[0], tex_ys[0]}, tc },
-                { v3f{v4f{pos_xs[1], pos_ys[0], 0.f, 1.f} * model_m}, v2f{tex_xs[1], tex_ys[0]}, tc },
-                { v3f{v4f{pos_xs[2], pos_ys[0], 0.f, 1.f} * model_m}, v2f{tex_xs[2], tex_ys[0]}, tc },
-                { v3f{v4f{pos_xs[3], pos_ys[0], 0.f, 1.f} * model_m}, v2f{tex_xs[3], tex_ys[0]}, tc },
-
-                { v3f{v4f{pos_xs[0], pos_ys[1], 0.f, 1.f} * model_m}, v2f{tex_xs[0], tex_ys[1]}, tc },
-                { v3f{v4f{pos_xs[1], pos_ys[1], 0.f, 1.f} * model_m}, v2f{tex_xs[1], tex_ys[1]}, tc },
-                { v3f{v4f{pos_xs[2], pos_ys[1], 0.f, 1.f} * model_m}, v2f{tex_xs[2], tex_ys[1]}, tc },
-                { v3f{v4f{pos_xs[3], pos_ys[1], 0.f, 1.f} * model_m}, v2f{tex_xs[3], tex_ys[1]}, tc },
-
-                { v3f{v4f{pos_xs[0], pos_ys[2], 0.f, 1.f} * model_m}, v2f{tex_xs[0], tex_ys[2]}, tc },
-                { v3f{v4f{pos_xs[1], pos_ys[2], 0.f, 1.f} * model_m}, v2f{tex_xs[1], tex_ys[2]}, tc },
-                { v3f{v4f{pos_xs[2], pos_ys[2], 0.f, 1.f} * model_m}, v2f{tex_xs[2], tex_ys[2]}, tc },
-                { v3f{v4f{pos_xs[3], pos_ys[2], 0.f, 1.f} * model_m}, v2f{tex_xs[3], tex_ys[2]}, tc },
-
-                { v3f{v4f{pos_xs[0], pos_ys[3], 0.f, 1.f} * model_m}, v2f{tex_xs[0], tex_ys[3]}, tc },
-                { v3f{v4f{pos_xs[1], pos_ys[3], 0.f, 1.f} * model_m}, v2f{tex_xs[1], tex_ys[3]}, tc },
-                { v3f{v4f{pos_xs[2], pos_ys[3], 0.f, 1.f} * model_m}, v2f{tex_xs[2], tex_ys[3]}, tc },
-                { v3f{v4f{pos_xs[3], pos_ys[3], 0.f, 1.f} * model_m}, v2f{tex_xs[3], tex_ys[3]}, tc },
+                { transform_position(v2f{pos_xs[0], pos_ys[0]}, model_m), v2f{tex_xs[0], tex_ys[0]}, tc },
+                { transform_position(v2f{pos_xs[1], pos_ys[0]}, model_m), v2f{tex_xs[1], tex_ys[0]}, tc },
+                { transform_position(v2f{pos_xs[2], pos_ys[0]}, model_m), v2f{tex_xs[2], tex_ys[0]}, tc },
+                { transform_position(v2f{pos_xs[3], pos_ys[0]}, model_m), v2f{tex_xs[3], tex_ys[0]}, tc },
+
+                { transform_position(v2f{pos_xs[0], pos_ys[1]}, model_m), v2f{tex_xs[0], tex_ys[1]}, tc },
+                { transform_position(v2f{pos_xs[1], pos_ys[1]}, model_m), v2f{tex_xs[1], tex_ys[1]}, tc },
+                { transform_position(v2f{pos_xs[2], pos_ys[1]}, model_m), v2f{tex_xs[2], tex_ys[1]}, tc },
+                { transform_position(v2f{pos_xs[3], pos_ys[1]}, model_m), v2f{tex_xs[3], tex_ys[1]}, tc },
+
+                { transform_position(v2f{pos_xs[0], pos_ys[2]}, model_m), v2f{tex_xs[0], tex_ys[2]}, tc },
+                { transform_position(v2f{pos_xs[1], pos_ys[2]}, model_m), v2f{tex_xs[1], tex_ys[2]}, tc },
+                { transform_position(v2f{pos_xs[2], pos_ys[2]}, model_m), v2f{tex_xs[2], tex_ys[2]}, tc },
+                { transform_position(v2f{pos_xs[3], pos_ys[2]}, model_m), v2f{tex_xs[3], tex_ys[2]}, tc },
+
+                { transform_position(v2f{pos_xs[0], pos_ys[3]}, model_m), v2f{tex_xs[0], tex_ys[3]}, tc },
+                { transform_position(v2f{pos_xs[1], pos_ys[3]}, model_m), v2f{tex_xs[1], tex_ys[3]}, tc },
+                { transform_position(v2f{pos_xs[2], pos_ys[3]}, model_m), v2f{tex_xs[2], tex_ys[3]}, tc },
+                { transform_position(v2f{pos_xs[3], pos_ys[3]}, model_m), v2f{tex_xs[3], tex_ys[3]}, tc },
             };
 
             batcher_.batch(
@@ -358,6 +406,81 @@ namespace e2d::render_system_impl
         }
     }
 
+    template < typename Matrix >
+    void drawer::context::draw(
+        const Matrix& model_m,
+        const renderer& node_r,
+        const label& lbl)
+    {
+        if ( lbl.glyph_quads().empty() || math::is_near_zero(lbl.tint().a) ) {
+            return;
+        }
+
+        if ( node_r.materials().empty() || !node_r.materials().front() ) {
+            return;
+        }
+
+        const material_asset::ptr& mat_a = node_r.materials().front();
+
+        DEFER([this](){
+            property_cache_.clear();
+        });
+
+        property_cache_
+            .property(matrix_m_property_hash, m4f::identity())
+            .merge(node_r.properties());
+
+        // Y
+        // ^
+        // | 3 - 2
+        // | | / |
+        // | 0 - 1
+        // +------> X
+
+        constexpr std::size_t max_chunk_quads = 64u;
+
+        std::array<batcher_type::index_type, max_chunk_quads * 6u> indices;
+        std::array<batcher_type::vertex_type, max_chunk_quads * 4u> vertices;
+
+        const color32& tc = lbl.tint();
+        const vector<label::glyph_quad>& quads = lbl.glyph_quads();
+
+        for ( std::size_t first = 0; first < quads.size(); first += max_chunk_quads ) {
+            const std::size_t chunk_quads = math::min(
+                max_chunk_quads,
+                quads.size() - first);
+
+            for ( std::size_t i = 0; i < chunk_quads; ++i ) {
+                const label::glyph_quad& quad = quads[first + i];
+
+                const v2f& gp = quad.rect.position;
+                const v2f& gs = quad.rect.size;
+                const v2f& tp = quad.texrect.position;
+                const v2f& ts = quad.texrect.size;
+
+                const auto start_vertex = static_cast<batcher_type::index_type>(i * 4u);
+
+                indices[i * 6u + 0u] = static_cast<batcher_type::index_type>(start_vertex + 0u);
+                indices[i * 6u + 1u] = static_cast<batcher_type::index_type>(start_vertex + 1u);
+                indices[i * 6u + 2u] = static_cast<batcher_type::index_type>(start_vertex + 2u);
+                indices[i * 6u + 3u] = static_cast<batcher_type::index_type>(start_vertex + 2u);
+                indices[i * 6u + 4u] = static_cast<batcher_type::index_type>(start_vertex + 3u);
+                indices[i * 6u + 5u] = static_cast<batcher_type::index_type>(start_vertex + 0u);
+
+                vertices[i * 4u + 0u] = { transform_position(v2f{gp.x + 0.0f, gp.y + 0.0f}, model_m), v2f{tp.x + 0.0f, tp.y + 0.0f}, tc };
+                vertices[i * 4u + 1u] = { transform_position(v2f{gp.x + gs.x, gp.y + 0.0f}, model_m), v2f{tp.x + ts.x, tp.y + 0.0f}, tc };
+                vertices[i * 4u + 2u] = { transform_position(v2f{gp.x + gs.x, gp.y + gs.y}, model_m), v2f{tp.x + ts.x, tp.y + ts.y}, tc };
+                vertices[i * 4u + 3u] = { transform_position(v2f{gp.x + 0.0f, gp.y + gs.y}, model_m), v2f{tp.x + 0.0f, tp.y + ts.y}, tc };
+            }
+
+            batcher_.batch(
+                mat_a,
+                property_cache_,
+                indices.data(), chunk_quads * 6u,
+                vertices.data(), chunk_quads * 4u);
+        }
+    }
+
     //
     // drawer
     //
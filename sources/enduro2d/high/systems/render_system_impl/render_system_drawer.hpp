@@ -47,10 +47,18 @@ namespace e2d::render_system_impl
                 const renderer& node_r,
                 const model_renderer& mdl_r);
 
+            // Matrix is m3x2f for planar transforms and m4f otherwise
+            template < typename Matrix >
             void draw(
-                const m4f& model_m,
+                const Matrix& model_m,
                 const renderer& node_r,
                 const sprite_renderer& spr_r);
+
+            template < typename Matrix >
+            void draw(
+                const Matrix& model_m,
+                const renderer& node_r,
+                const label& lbl);
         private:
             render& render_;
             batcher_type& batcher_;
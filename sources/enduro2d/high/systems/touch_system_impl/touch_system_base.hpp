@@ -24,15 +24,31 @@ namespace e2d::touch_system_impl
     struct world_space_rect_collider final {
         using local_space_collider_t = rect_collider;
         std::array<v3f, 4> points{};
+        m3x2f world_to_local = m3x2f::identity();
+        bool has_world_to_local = false;
+        u32 world_version = 0u;
+        u32 collider_version = 0u;
+        bool has_versions = false;
     };
 
     struct world_space_circle_collider final {
         using local_space_collider_t = circle_collider;
         std::array<v3f, 12> points{};
+        m3x2f world_to_local = m3x2f::identity();
+        bool has_world_to_local = false;
+        u32 world_version = 0u;
+        u32 collider_version = 0u;
+        bool has_versions = false;
     };
 
     struct world_space_polygon_collider final {
         using local_space_collider_t = polygon_collider;
         vector<v3f> points{};
+        m3x2f world_to_local = m3x2f::identity();
+        bool has_world_to_local = false;
+        u32 world_version = 0u;
+        u32 collider_version = 0u;
+        bool has_versions = false;
+        f32 local_bounding_radius_sqr = 0.f;
     };
 }
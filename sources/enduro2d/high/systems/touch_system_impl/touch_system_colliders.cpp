@@ -14,7 +14,7 @@ namespace e2d::touch_system_impl::impl
     void update_world_space_collider(
         world_space_rect_collider& dst,
         const rect_collider& src,
-        const m4f& local_to_world)
+        const m3x2f& local_to_world)
     {
         const v2f& of = src.offset();
         const v2f& hs = src.size() * 0.5f;
@@ -24,35 +24,49 @@ namespace e2d::touch_system_impl::impl
         const v2f p3{of.x + hs.x, of.y + hs.y};
         const v2f p4{of.x - hs.x, of.y + hs.y};
 
-        dst.points[0] = v3f(v4f(p1, 0.f, 1.f) * local_to_world);
-        dst.points[1] = v3f(v4f(p2, 0.f, 1.f) * local_to_world);
-        dst.points[2] = v3f(v4f(p3, 0.f, 1.f) * local_to_world);
-        dst.points[3] = v3f(v4f(p4, 0.f, 1.f) * local_to_world);
+        dst.points[0] = v3f(p1 * local_to_world, 0.f);
+        dst.points[1] = v3f(p2 * local_to_world, 0.f);
+        dst.points[2] = v3f(p3 * local_to_world, 0.f);
+        dst.points[3] = v3f(p4 * local_to_world, 0.f);
+
+        std::tie(dst.world_to_local, dst.has_world_to_local) =
+            math::inversed(local_to_world);
     }
 
     void update_world_space_collider(
         world_space_circle_collider& dst,
         const circle_collider& src,
-        const m4f& local_to_world)
+        const m3x2f& local_to_world)
     {
+        static const auto unit_circle_points = [](){
+            std::array<
+                v2f,
+                std::tuple_size_v<decltype(world_space_circle_collider::points)>
+            > points;
+            for ( std::size_t i = 0, e = points.size(); i < e; ++i ) {
+                const radf a =
+                    math::two_pi<f32>() /
+                    math::numeric_cast<f32>(e) *
+                    math::numeric_cast<f32>(i);
+                points[i] = v2f(math::cos(a), math::sin(a));
+            }
+            return points;
+        }();
+
         const v2f& of = src.offset();
         for ( std::size_t i = 0, e = dst.points.size(); i < e; ++i ) {
-            const radf a =
-                math::two_pi<f32>() /
-                math::numeric_cast<f32>(e) *
-                math::numeric_cast<f32>(i);
-            const v2f p =
-                of +
-                v2f(math::cos(a), math::sin(a)) *
-                src.radius();
-            dst.points[i] = v3f(v4f(p, 0.f, 1.f) * local_to_world);
+            const v2f p = of + unit_circle_points[i] * src.radius();
+            dst.points[i] = v3f(p * local_to_world, 0.f);
         }
+
+        std::tie(dst.world_to_local, dst.has_world_to_local) =
+            math::inversed(local_to_world);
     }
 
     void update_world_space_collider(
         world_space_polygon_collider& dst,
         const polygon_collider& src,
-        const m4f& local_to_world)
+        const m3x2f& local_to_world)
     {
         const vector<v2f>& src_points = src.points();
 
@@ -61,11 +75,20 @@ namespace e2d::touch_system_impl::impl
             dst.points.reserve(math::max(dst.points.capacity() * 2u, src_points.size()));
         }
 
+        f32 bounding_radius_sqr = 0.f;
+
         const v2f& of = src.offset();
         for ( std::size_t i = 0, e = src_points.size(); i < e; ++i ) {
             const v2f p = of + src_points[i];
-            dst.points.push_back(v3f(v4f(p, 0.f, 1.f) * local_to_world));
+            dst.points.push_back(v3f(p * local_to_world, 0.f));
+            bounding_radius_sqr = math::max(
+                bounding_radius_sqr,
+                math::length_squared(src_points[i]));
         }
+
+        dst.local_bounding_radius_sqr = bounding_radius_sqr;
+        std::tie(dst.world_to_local, dst.has_world_to_local) =
+            math::inversed(local_to_world);
     }
 }
 
@@ -125,12 +148,9 @@ namespace e2d::touch_system_impl::impl
         const m4f& camera_vp,
         const b2f& camera_viewport)
     {
-        static thread_local std::vector<v2f> points;
-        DEFER([](){ points.clear(); });
-
-        if ( points.capacity() < c.points.size() ) {
-            points.reserve(math::max(points.capacity() * 2u, c.points.size()));
-        }
+        frame_allocator::scope frame_scope;
+        linear_vector<v2f> points(frame_scope.allocator<v2f>());
+        points.reserve(c.points.size());
 
         std::transform(c.points.begin(), c.points.end(), std::back_inserter(points), [
             &camera_vp,
@@ -146,6 +166,48 @@ namespace e2d::touch_system_impl::impl
     }
 }
 
+namespace e2d::touch_system_impl::impl
+{
+    bool is_local_space_collider_under_mouse(
+        const world_space_rect_collider& wc,
+        const rect_collider& lc,
+        const v2f& local_mouse_p) noexcept
+    {
+        E2D_UNUSED(wc);
+        const v2f p = local_mouse_p - lc.offset();
+        const v2f hs = lc.size() * 0.5f;
+        return math::abs(p.x) <= math::abs(hs.x)
+            && math::abs(p.y) <= math::abs(hs.y);
+    }
+
+    bool is_local_space_collider_under_mouse(
+        const world_space_circle_collider& wc,
+        const circle_collider& lc,
+        const v2f& local_mouse_p) noexcept
+    {
+        E2D_UNUSED(wc);
+        const f32 r = lc.radius();
+        return math::length_squared(local_mouse_p - lc.offset()) <= r * r;
+    }
+
+    bool is_local_space_collider_under_mouse(
+        const world_space_polygon_collider& wc,
+        const polygon_collider& lc,
+        const v2f& local_mouse_p) noexcept
+    {
+        const v2f p = local_mouse_p - lc.offset();
+        if ( math::length_squared(p) > wc.local_bounding_radius_sqr ) {
+            return false;
+        }
+
+        const vector<v2f>& points = lc.points();
+        return !points.empty() && !!pnpoly_aos(
+            math::numeric_cast<int>(points.size()),
+            points.data()->data(),
+            p.x, p.y);
+    }
+}
+
 namespace e2d::touch_system_impl
 {
     void update_world_space_colliders(ecs::registry& owner) {
@@ -182,21 +244,41 @@ namespace e2d::touch_system_impl
                 return;
             }
 
+            const auto [inv_camera_vp, inv_camera_vp_success] =
+                math::inversed(camera_vp);
+
+            if ( !inv_camera_vp_success ) {
+                return;
+            }
+
+            // node transforms are planar, so the cursor ray is intersected
+            // with the z=0 plane once and then mapped into each collider
+            const v3f near_p = math::unproject(v3f(mouse_p, 0.f), inv_camera_vp, camera_viewport).first;
+            const v3f far_p = math::unproject(v3f(mouse_p, 1.f), inv_camera_vp, camera_viewport).first;
+            const v3f ray_d = far_p - near_p;
+
+            const std::pair<v2f, bool> world_mouse_p = math::is_near_zero(ray_d.z)
+                ? std::make_pair(v2f(near_p), math::is_near_zero(near_p.z))
+                : std::make_pair(v2f(near_p + ray_d * (-near_p.z / ray_d.z)), true);
+
             impl::update_world_space_colliders_under_mouse<world_space_rect_collider>(
                 owner,
                 mouse_p,
+                world_mouse_p,
                 camera_vp,
                 camera_viewport);
 
             impl::update_world_space_colliders_under_mouse<world_space_circle_collider>(
                 owner,
                 mouse_p,
+                world_mouse_p,
                 camera_vp,
                 camera_viewport);
 
             impl::update_world_space_colliders_under_mouse<world_space_polygon_collider>(
                 owner,
                 mouse_p,
+                world_mouse_p,
                 camera_vp,
                 camera_viewport);
         }, !ecs::exists_any<
@@ -15,17 +15,17 @@ namespace e2d::touch_system_impl
         void update_world_space_collider(
             world_space_rect_collider& dst,
             const rect_collider& src,
-            const m4f& local_to_world);
+            const m3x2f& local_to_world);
 
         void update_world_space_collider(
             world_space_circle_collider& dst,
             const circle_collider& src,
-            const m4f& local_to_world);
+            const m3x2f& local_to_world);
 
         void update_world_space_collider(
             world_space_polygon_collider& dst,
             const polygon_collider& src,
-            const m4f& local_to_world);
+            const m3x2f& local_to_world);
 
         template < typename WorldSpaceCollider >
         void update_world_space_colliders(ecs::registry& owner) {
@@ -49,10 +49,26 @@ namespace e2d::touch_system_impl
                 const touchable&,
                 const actor& a)
             {
+                const u32 world_version = a.node()
+                    ? a.node()->world_version()
+                    : 0u;
+
+                world_space_collider_t& dst = e.ensure_component<world_space_collider_t>();
+                if ( dst.has_versions
+                    && dst.world_version == world_version
+                    && dst.collider_version == src.version() )
+                {
+                    return;
+                }
+
                 update_world_space_collider(
-                    e.ensure_component<world_space_collider_t>(),
+                    dst,
                     src,
-                    a.node() ? a.node()->world_matrix() : m4f::identity());
+                    a.node() ? a.node()->world_matrix() : m3x2f::identity());
+
+                dst.world_version = world_version;
+                dst.collider_version = src.version();
+                dst.has_versions = true;
             }, !ecs::exists_any<
                 disabled<actor>,
                 disabled<touchable>,
@@ -80,29 +96,69 @@ namespace e2d::touch_system_impl
             const v2f& mouse_p,
             const m4f& camera_vp,
             const b2f& camera_viewport);
+    }
+
+    namespace impl
+    {
+        bool is_local_space_collider_under_mouse(
+            const world_space_rect_collider& wc,
+            const rect_collider& lc,
+            const v2f& local_mouse_p) noexcept;
 
+        bool is_local_space_collider_under_mouse(
+            const world_space_circle_collider& wc,
+            const circle_collider& lc,
+            const v2f& local_mouse_p) noexcept;
+
+        bool is_local_space_collider_under_mouse(
+            const world_space_polygon_collider& wc,
+            const polygon_collider& lc,
+            const v2f& local_mouse_p) noexcept;
+    }
+
+    namespace impl
+    {
         template < typename WorldSpaceCollider >
         void update_world_space_colliders_under_mouse(
             ecs::registry& owner,
             const v2f& mouse_p,
+            const std::pair<v2f, bool>& world_mouse_p,
             const m4f& camera_vp,
             const b2f& camera_viewport)
         {
             using world_space_collider_t = WorldSpaceCollider;
             using local_space_collider_t = typename WorldSpaceCollider::local_space_collider_t;
 
-            owner.for_joined_components<touchable, world_space_collider_t>([
+            ecsex::command_buffer commands;
+            owner.for_joined_components<touchable, world_space_collider_t, local_space_collider_t>([
+                &commands,
                 &mouse_p,
+                &world_mouse_p,
                 &camera_vp,
                 &camera_viewport
-            ](ecs::entity e, const touchable&, const world_space_collider_t& c){
-                if ( is_world_space_collider_under_mouse(c, mouse_p, camera_vp, camera_viewport) ) {
-                    e.ensure_component<touchable_under_mouse>();
+            ](const ecs::entity& e,
+                const touchable&,
+                const world_space_collider_t& wc,
+                const local_space_collider_t& lc)
+            {
+                bool under_mouse = false;
+                if ( wc.has_world_to_local ) {
+                    under_mouse = world_mouse_p.second
+                        && is_local_space_collider_under_mouse(
+                            wc, lc, world_mouse_p.first * wc.world_to_local);
+                } else {
+                    under_mouse = is_world_space_collider_under_mouse(
+                        wc, mouse_p, camera_vp, camera_viewport);
+                }
+                if ( under_mouse ) {
+                    commands.ensure_component<touchable_under_mouse>(e);
                 }
             }, !ecs::exists_any<
+                touchable_under_mouse,
                 disabled<touchable>,
                 disabled<world_space_collider_t>,
                 disabled<local_space_collider_t>>());
+            commands.playback(owner);
         }
     }
 
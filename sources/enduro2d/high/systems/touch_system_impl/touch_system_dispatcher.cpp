@@ -12,12 +12,15 @@ namespace
     using namespace e2d::touch_system_impl;
 
     gobject find_event_target(const ecs::registry& owner) {
-        static thread_local vector<std::tuple<
+        using scene_tuple = std::tuple<
             ecs::const_entity,
             scene,
-            actor>> scenes;
+            actor>;
+
+        frame_allocator::scope frame_scope;
+        linear_vector<scene_tuple> scenes(
+            frame_scope.allocator<scene_tuple>());
 
-        DEFER([](){ scenes.clear(); });
         ecsex::extract_components<scene, actor>(
             owner,
             std::back_inserter(scenes),
@@ -61,8 +64,9 @@ namespace
         // parents
         //
 
-        static thread_local std::vector<gcomponent<touchable>> parents;
-        DEFER([](){ parents.clear(); });
+        frame_allocator::scope frame_scope;
+        linear_vector<gcomponent<touchable>> parents(
+            frame_scope.allocator<gcomponent<touchable>>());
 
         nodes::extract_components_from_parents<touchable>(
             target_actor->node(),
@@ -11,28 +11,45 @@
 #include <enduro2d/high/components/layout.hpp>
 #include <enduro2d/high/components/widget.hpp>
 
+#include <enduro2d/high/world.hpp>
+
 namespace
 {
     using namespace e2d;
 
-    void update_dirty_widgets(ecs::registry& owner) {
-        owner.for_joined_components<widget::dirty, widget, actor>([](
-            const ecs::const_entity&,
-            const widget::dirty&,
+    void mark_layout_dirty(ecsex::change_set& layout_changes, const gcomponent<layout>& l) {
+        if ( l ) {
+            layout_changes.mark(l.owner().raw_entity().id());
+        }
+    }
+
+    void update_dirty_widgets(
+        ecs::registry& owner,
+        ecsex::change_set& changes,
+        ecsex::change_set& layout_changes)
+    {
+        if ( changes.empty() ) {
+            return;
+        }
+        DEFER([&changes](){ changes.clear(); });
+
+        ecsex::for_joined_changed_components<widget, actor>(changes, owner, [&layout_changes](
+            const ecs::entity& e,
             const widget&,
             const actor& a)
         {
+            if ( e.exists_component<disabled<actor>>()
+                || e.exists_component<disabled<widget>>() )
+            {
+                return;
+            }
             if ( a.node() && a.node()->owner() ) {
                 gcomponent<layout> l{a.node()->owner()};
                 gcomponent<widget> w{a.node()->owner()};
-                layouts::mark_dirty(l);
-                layouts::mark_dirty(widgets::find_parent_layout(w));
+                mark_layout_dirty(layout_changes, l);
+                mark_layout_dirty(layout_changes, widgets::find_parent_layout(w));
             }
-        }, !ecs::exists_any<
-            disabled<actor>,
-            disabled<widget>>());
-
-        owner.remove_all_components<widget::dirty>();
+        });
     }
 }
 
@@ -44,12 +61,18 @@ namespace e2d
 
     class widget_system::internal_state final : private noncopyable {
     public:
-        internal_state() = default;
+        // the change sets are created here, the scheduler threads only look them up
+        internal_state(world& w)
+        : changes_(w.changes<widget::dirty>())
+        , layout_changes_(w.changes<layout::dirty>()) {}
         ~internal_state() noexcept = default;
 
         void process_update(ecs::registry& owner) {
-            update_dirty_widgets(owner);
+            update_dirty_widgets(owner, changes_, layout_changes_);
         }
+    private:
+        ecsex::change_set& changes_;
+        ecsex::change_set& layout_changes_;
     };
 
     //
@@ -57,7 +80,7 @@ namespace e2d
     //
 
     widget_system::widget_system()
-    : state_(new internal_state()) {}
+    : state_(new internal_state(the<world>())) {}
     widget_system::~widget_system() noexcept = default;
 
     void widget_system::process(
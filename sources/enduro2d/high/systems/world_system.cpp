@@ -20,9 +20,17 @@ namespace e2d
         : world_(w) {}
         ~internal_state() noexcept = default;
 
+        void process_frame_render() {
+            // one batched pass instead of lazy refreshes by the first reader
+            if ( const auto& transforms = world_.transforms() ) {
+                transforms->update(world_.scheduler().worker());
+            }
+        }
+
         void process_frame_finalize(ecs::registry& owner) {
-            E2D_UNUSED(owner);
+            world_.commands().playback(owner);
             world_.finalize_instances();
+            world_.process_async_instances();
         }
     private:
         world& world_;
@@ -36,6 +44,14 @@ namespace e2d
     : state_(new internal_state(the<world>())) {}
     world_system::~world_system() noexcept = default;
 
+    void world_system::process(
+        ecs::registry& owner,
+        const ecs::before<systems::frame_render_event>& trigger)
+    {
+        E2D_UNUSED(owner, trigger);
+        state_->process_frame_render();
+    }
+
     void world_system::process(
         ecs::registry& owner,
         const ecs::after<systems::frame_finalize_event>& trigger)
@@ -0,0 +1,346 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/high/transform_hierarchy.hpp>
+
+#include <enduro2d/high/gobject.hpp>
+
+namespace e2d
+{
+    transform_hierarchy::handle transform_hierarchy::create(const t2f& transform) {
+        return create(invalid_handle, transform);
+    }
+
+    transform_hierarchy::handle transform_hierarchy::create(handle parent, const t2f& transform) {
+        E2D_ASSERT(parent == invalid_handle || valid(parent));
+
+        const u32 parent_slot = valid(parent)
+            ? slots_[parent]
+            : invalid_slot;
+
+        const u32 depth = parent_slot != invalid_slot
+            ? depths_[parent_slot] + 1u
+            : 0u;
+
+        handle h = invalid_handle;
+        if ( free_handles_.empty() ) {
+            h = math::numeric_cast<handle>(slots_.size());
+            slots_.push_back(invalid_slot);
+        } else {
+            h = free_handles_.back();
+            free_handles_.pop_back();
+        }
+
+        const u32 slot = math::numeric_cast<u32>(parents_.size());
+
+        parents_.push_back(parent_slot);
+        depths_.push_back(depth);
+        transforms_.push_back(transform);
+        world_matrices_.push_back(m3x2f::identity());
+        world_versions_.push_back(0u);
+        dirty_.push_back(0u);
+        handles_.push_back(h);
+        slots_[h] = slot;
+
+        // appending keeps the order if the new slot ends the last level
+        // or starts the next one, otherwise the arrays are re-sorted
+        if ( !order_dirty_ ) {
+            if ( levels_.empty() ) {
+                levels_.push_back(slot);
+                levels_.push_back(slot + 1u);
+            } else if ( depth == depths_[slot - 1u] ) {
+                levels_.back() = slot + 1u;
+            } else if ( depth == depths_[slot - 1u] + 1u ) {
+                levels_.push_back(slot + 1u);
+            } else {
+                order_dirty_ = true;
+            }
+        }
+
+        mark_dirty_(slot);
+        return h;
+    }
+
+    void transform_hierarchy::destroy(handle h) noexcept {
+        if ( !valid(h) ) {
+            return;
+        }
+
+        handles_[slots_[h]] = invalid_handle;
+        slots_[h] = invalid_slot;
+        free_handles_.push_back(h);
+        order_dirty_ = true;
+        needs_update_.store(true, std::memory_order_release);
+    }
+
+    bool transform_hierarchy::valid(handle h) const noexcept {
+        return h < slots_.size()
+            && slots_[h] != invalid_slot;
+    }
+
+    void transform_hierarchy::parent(handle h, handle parent) noexcept {
+        E2D_ASSERT(valid(h));
+        E2D_ASSERT(parent == invalid_handle || valid(parent));
+
+        const u32 slot = slots_[h];
+        const u32 parent_slot = valid(parent)
+            ? slots_[parent]
+            : invalid_slot;
+
+        if ( parents_[slot] == parent_slot ) {
+            return;
+        }
+
+        for ( u32 p = parent_slot; p != invalid_slot; p = parents_[p] ) {
+            if ( p == slot ) {
+                return;
+            }
+        }
+
+        parents_[slot] = parent_slot;
+        order_dirty_ = true;
+        mark_dirty_(slot);
+    }
+
+    transform_hierarchy::handle transform_hierarchy::parent(handle h) const noexcept {
+        E2D_ASSERT(valid(h));
+        const u32 parent_slot = parents_[slots_[h]];
+        return parent_slot != invalid_slot
+            ? handles_[parent_slot]
+            : invalid_handle;
+    }
+
+    void transform_hierarchy::transform(handle h, const t2f& transform) noexcept {
+        E2D_ASSERT(valid(h));
+        transforms_[slots_[h]] = transform;
+        mark_dirty_(slots_[h]);
+    }
+
+    const t2f& transform_hierarchy::transform(handle h) const noexcept {
+        E2D_ASSERT(valid(h));
+        return transforms_[slots_[h]];
+    }
+
+    const m3x2f& transform_hierarchy::world_matrix(handle h) {
+        if ( needs_update_.load(std::memory_order_acquire) ) {
+            update();
+        }
+        E2D_ASSERT(valid(h));
+        return world_matrices_[slots_[h]];
+    }
+
+    u32 transform_hierarchy::world_version(handle h) {
+        if ( needs_update_.load(std::memory_order_acquire) ) {
+            update();
+        }
+        E2D_ASSERT(valid(h));
+        return world_versions_[slots_[h]];
+    }
+
+    void transform_hierarchy::update() {
+        std::lock_guard<std::mutex> guard(update_mutex_);
+        if ( !needs_update_.load(std::memory_order_relaxed) ) {
+            return;
+        }
+
+        if ( order_dirty_ ) {
+            reorder_();
+        }
+
+        if ( first_dirty_slot_ != invalid_slot ) {
+            update_range_(first_dirty_slot_, parents_.size(), versions::next());
+            std::fill(dirty_.begin() + first_dirty_slot_, dirty_.end(), u8(0u));
+            first_dirty_slot_ = invalid_slot;
+        }
+
+        needs_update_.store(false, std::memory_order_release);
+    }
+
+    void transform_hierarchy::update(stdex::jobber& worker, std::size_t min_chunk_size) {
+        std::lock_guard<std::mutex> guard(update_mutex_);
+        if ( !needs_update_.load(std::memory_order_relaxed) ) {
+            return;
+        }
+
+        if ( order_dirty_ ) {
+            reorder_();
+        }
+
+        if ( first_dirty_slot_ == invalid_slot ) {
+            needs_update_.store(false, std::memory_order_release);
+            return;
+        }
+
+        const u32 version = versions::next();
+        const std::size_t chunk_size = math::max(min_chunk_size, std::size_t(1u));
+
+        //TODO(BlackMat): replace it to frame allocator
+        static thread_local vector<stdex::promise<void>> chunks;
+        DEFER([](){ chunks.clear(); });
+
+        // levels go one after another, the slots of a level are independent
+        for ( std::size_t i = 1; i < levels_.size(); ++i ) {
+            const std::size_t begin = math::max<std::size_t>(levels_[i - 1u], first_dirty_slot_);
+            const std::size_t end = levels_[i];
+
+            if ( begin >= end ) {
+                continue;
+            }
+
+            const std::size_t chunk_count = (end - begin) / chunk_size;
+            if ( chunk_count < 2u ) {
+                update_range_(begin, end, version);
+                continue;
+            }
+
+            const std::size_t level_chunk_size = (end - begin + chunk_count - 1u) / chunk_count;
+            for ( std::size_t b = begin + level_chunk_size; b < end; b += level_chunk_size ) {
+                const std::size_t e = math::min(b + level_chunk_size, end);
+                chunks.push_back(worker.async([this, b, e, version](){
+                    update_range_(b, e, version);
+                }));
+            }
+
+            update_range_(begin, begin + level_chunk_size, version);
+
+            for ( const stdex::promise<void>& chunk : chunks ) {
+                chunk.wait();
+            }
+            chunks.clear();
+        }
+
+        std::fill(dirty_.begin() + first_dirty_slot_, dirty_.end(), u8(0u));
+        first_dirty_slot_ = invalid_slot;
+        needs_update_.store(false, std::memory_order_release);
+    }
+
+    bool transform_hierarchy::empty() const noexcept {
+        return size() == 0u;
+    }
+
+    std::size_t transform_hierarchy::size() const noexcept {
+        return slots_.size() - free_handles_.size();
+    }
+
+    void transform_hierarchy::mark_dirty_(u32 slot) noexcept {
+        dirty_[slot] = 1u;
+        first_dirty_slot_ = first_dirty_slot_ != invalid_slot
+            ? math::min(first_dirty_slot_, slot)
+            : slot;
+        needs_update_.store(true, std::memory_order_release);
+    }
+
+    void transform_hierarchy::reorder_() {
+        const std::size_t slot_count = parents_.size();
+
+        // detach children of destroyed transforms
+        for ( std::size_t i = 0; i < slot_count; ++i ) {
+            const u32 p = parents_[i];
+            if ( p != invalid_slot && handles_[p] == invalid_handle ) {
+                parents_[i] = invalid_slot;
+                dirty_[i] = 1u;
+            }
+        }
+
+        // recalculate depths, parents may be placed after children here
+        vector<u32> path;
+        std::fill(depths_.begin(), depths_.end(), invalid_slot);
+        for ( std::size_t i = 0; i < slot_count; ++i ) {
+            u32 s = math::numeric_cast<u32>(i);
+            while ( s != invalid_slot && depths_[s] == invalid_slot ) {
+                path.push_back(s);
+                s = parents_[s];
+            }
+            u32 depth = s != invalid_slot ? depths_[s] + 1u : 0u;
+            for ( auto iter = path.rbegin(); iter != path.rend(); ++iter, ++depth ) {
+                depths_[*iter] = depth;
+            }
+            path.clear();
+        }
+
+        vector<u32> order;
+        order.reserve(slot_count);
+        for ( std::size_t i = 0; i < slot_count; ++i ) {
+            if ( handles_[i] != invalid_handle ) {
+                order.push_back(math::numeric_cast<u32>(i));
+            }
+        }
+
+        std::stable_sort(order.begin(), order.end(), [this](u32 l, u32 r){
+            return depths_[l] < depths_[r];
+        });
+
+        vector<u32> new_slots(slot_count, invalid_slot);
+        for ( std::size_t i = 0; i < order.size(); ++i ) {
+            new_slots[order[i]] = math::numeric_cast<u32>(i);
+        }
+
+        vector<u32> parents(order.size());
+        vector<u32> depths(order.size());
+        vector<t2f> transforms(order.size());
+        vector<m3x2f> world_matrices(order.size());
+        vector<u32> world_versions(order.size());
+        vector<u8> dirty(order.size());
+        vector<handle> handles(order.size());
+
+        levels_.clear();
+        first_dirty_slot_ = invalid_slot;
+
+        for ( std::size_t i = 0; i < order.size(); ++i ) {
+            const u32 old_slot = order[i];
+            const u32 old_parent = parents_[old_slot];
+
+            parents[i] = old_parent != invalid_slot
+                ? new_slots[old_parent]
+                : invalid_slot;
+            depths[i] = depths_[old_slot];
+            transforms[i] = transforms_[old_slot];
+            world_matrices[i] = world_matrices_[old_slot];
+            world_versions[i] = world_versions_[old_slot];
+            dirty[i] = dirty_[old_slot];
+            handles[i] = handles_[old_slot];
+
+            slots_[handles[i]] = math::numeric_cast<u32>(i);
+
+            if ( i == 0u || depths[i] != depths[i - 1u] ) {
+                levels_.push_back(math::numeric_cast<u32>(i));
+            }
+
+            if ( dirty[i] && first_dirty_slot_ == invalid_slot ) {
+                first_dirty_slot_ = math::numeric_cast<u32>(i);
+            }
+        }
+
+        if ( !order.empty() ) {
+            levels_.push_back(math::numeric_cast<u32>(order.size()));
+        }
+
+        parents_ = std::move(parents);
+        depths_ = std::move(depths);
+        transforms_ = std::move(transforms);
+        world_matrices_ = std::move(world_matrices);
+        world_versions_ = std::move(world_versions);
+        dirty_ = std::move(dirty);
+        handles_ = std::move(handles);
+
+        order_dirty_ = false;
+    }
+
+    void transform_hierarchy::update_range_(std::size_t begin, std::size_t end, u32 version) noexcept {
+        for ( std::size_t i = begin; i < end; ++i ) {
+            const u32 p = parents_[i];
+            if ( p != invalid_slot && dirty_[p] ) {
+                dirty_[i] = 1u;
+            }
+            if ( dirty_[i] ) {
+                world_matrices_[i] = p != invalid_slot
+                    ? math::make_trs_matrix3x2(transforms_[i]) * world_matrices_[p]
+                    : math::make_trs_matrix3x2(transforms_[i]);
+                world_versions_[i] = version;
+            }
+        }
+    }
+}
@@ -0,0 +1,92 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "library_widget.hpp"
+
+#include <enduro2d/high/library.hpp>
+
+namespace
+{
+    using namespace e2d;
+
+    str format_bytes(std::size_t bytes) {
+        if ( bytes >= 1024u * 1024u ) {
+            return strings::rformat("%0 MiB", static_cast<f32>(bytes) / (1024.f * 1024.f));
+        }
+        if ( bytes >= 1024u ) {
+            return strings::rformat("%0 KiB", static_cast<f32>(bytes) / 1024.f);
+        }
+        return strings::rformat("%0 B", bytes);
+    }
+
+    void show_budget(library& l, const asset_store::statistics& stats) {
+        int budget_mib = static_cast<int>(stats.budget / (1024u * 1024u));
+        if ( ImGui::InputInt("budget (MiB)", &budget_mib) ) {
+            l.memory_budget(static_cast<std::size_t>(math::max(0, budget_mib)) * 1024u * 1024u);
+        }
+
+        imgui_utils::show_formatted_text("cpu memory: %0", format_bytes(stats.cpu_bytes));
+        imgui_utils::show_formatted_text("gpu memory: %0", format_bytes(stats.gpu_bytes));
+        imgui_utils::show_formatted_text("evictions: %0", stats.evictions);
+        imgui_utils::show_formatted_text("loading assets: %0", l.loading_asset_count());
+
+        if ( ImGui::Button("Unload unused assets") ) {
+            l.unload_unused_assets();
+        }
+    }
+
+    void show_caches(const asset_store::statistics& stats) {
+        ImGui::Columns(6, "library_widget_caches");
+        DEFER([](){ ImGui::Columns(1); });
+
+        ImGui::Separator();
+        ImGui::TextUnformatted("type"); ImGui::NextColumn();
+        ImGui::TextUnformatted("assets"); ImGui::NextColumn();
+        ImGui::TextUnformatted("unused"); ImGui::NextColumn();
+        ImGui::TextUnformatted("cpu"); ImGui::NextColumn();
+        ImGui::TextUnformatted("gpu"); ImGui::NextColumn();
+        ImGui::TextUnformatted("hits/misses/evictions"); ImGui::NextColumn();
+        ImGui::Separator();
+
+        for ( const auto& cache : stats.caches ) {
+            ImGui::TextUnformatted(cache.type_name.c_str()); ImGui::NextColumn();
+            imgui_utils::show_formatted_text("%0", cache.assets); ImGui::NextColumn();
+            imgui_utils::show_formatted_text("%0", cache.unused_assets); ImGui::NextColumn();
+            imgui_utils::show_formatted_text("%0", format_bytes(cache.cpu_bytes)); ImGui::NextColumn();
+            imgui_utils::show_formatted_text("%0", format_bytes(cache.gpu_bytes)); ImGui::NextColumn();
+            imgui_utils::show_formatted_text("%0/%1/%2",
+                cache.hits, cache.misses, cache.evictions); ImGui::NextColumn();
+        }
+
+        ImGui::Separator();
+    }
+}
+
+namespace e2d::dbgui_widgets
+{
+    library_widget::library_widget() {
+        desc_.first_size = v2f(600.f, 300.f);
+    }
+
+    bool library_widget::show() {
+        if ( !modules::is_initialized<library>() ) {
+            return false;
+        }
+
+        library& l = the<library>();
+        const asset_store::statistics stats = l.store_stats();
+
+        show_budget(l, stats);
+        ImGui::Separator();
+        show_caches(stats);
+
+        return true;
+    }
+
+    const library_widget::description& library_widget::desc() const noexcept {
+        return desc_;
+    }
+}
@@ -8,17 +8,46 @@
 
 #include <enduro2d/high/components/actor.hpp>
 #include <enduro2d/high/components/disabled.hpp>
+#include <enduro2d/high/components/label.hpp>
+#include <enduro2d/high/components/layout.hpp>
+#include <enduro2d/high/components/widget.hpp>
 
 namespace
 {
     using namespace e2d;
 
+    // keeps the owner pool alive in front of each pooled state
+    struct alignas(std::max_align_t) block_header {
+        std::shared_ptr<pool_allocator> allocator;
+    };
+
     class gobject_state final : public gobject::state {
     private:
         enum flag_masks : u32 {
             fm_destroyed = 1u << 0,
             fm_invalided = 1u << 1,
         };
+    public:
+        static void* operator new(std::size_t size, const std::shared_ptr<pool_allocator>& allocator) {
+            E2D_ASSERT(allocator);
+            E2D_ASSERT(sizeof(block_header) + size <= allocator->block_size());
+            E2D_UNUSED(size);
+            block_header* header = new(allocator->allocate()) block_header{allocator};
+            return header + 1;
+        }
+
+        static void operator delete(void* ptr, const std::shared_ptr<pool_allocator>& allocator) noexcept {
+            E2D_UNUSED(allocator);
+            operator delete(ptr);
+        }
+
+        static void operator delete(void* ptr) noexcept {
+            block_header* header = static_cast<block_header*>(ptr) - 1;
+            // the last state can outlive the world, release the pool after it
+            std::shared_ptr<pool_allocator> allocator = std::move(header->allocator);
+            header->~block_header();
+            allocator->deallocate(header);
+        }
     public:
         gobject_state(world& w, ecs::entity e)
         : world_(w)
@@ -54,11 +83,22 @@ namespace
             E2D_ASSERT(!invalided());
             return entity_;
         }
+
+        world& owner_world() noexcept final {
+            return world_;
+        }
+
+        const world& owner_world() const noexcept final {
+            return world_;
+        }
     private:
         world& world_;
         ecs::entity entity_;
         u32 flags_{0u};
     };
+
+    constexpr std::size_t gobject_state_block_size =
+        sizeof(block_header) + sizeof(gobject_state);
 }
 
 namespace
@@ -84,22 +124,85 @@ namespace
         }
     }
 
+    // creates the next node of the plan, its parent must be created already
+    template < typename Nodes >
+    gobject new_plan_instance(world& world, const prefab_plan& plan, Nodes& nodes) {
+        const std::size_t index = nodes.size();
+        E2D_ASSERT(index < plan.size());
+
+        ecs::entity ent = world.registry().create_entity(plan.prototype(index));
+        auto ent_defer = defer_hpp::make_error_defer([&ent](){
+            ent.destroy();
+        });
+
+        gobject inst_i(gobject::state_iptr(
+            new(world.state_allocator()) gobject_state(world, ent)));
+        ERROR_DEFER([&inst_i](){
+            delete_instance(inst_i);
+        });
+
+        ent_defer.dismiss();
+        world.mark_instance_changes(inst_i);
+
+        gcomponent<actor> inst_a{inst_i};
+        node_iptr inst_n = node::create(world.node_allocator(), world.transforms(), inst_i);
+        if ( inst_a && inst_a->node() ) {
+            inst_n->transform(inst_a->node()->transform());
+        }
+        inst_a.ensure().node(inst_n);
+
+        if ( plan.parent(index) != prefab_plan::no_parent ) {
+            nodes[plan.parent(index)]->add_child(inst_n);
+        }
+
+        nodes.push_back(std::move(inst_n));
+        return inst_i;
+    }
+
+    gobject new_instance(world& world, const prefab_plan& plan) {
+        frame_allocator::scope frame_scope;
+        linear_vector<node_iptr> nodes(
+            frame_scope.allocator<node_iptr>());
+        nodes.reserve(plan.size());
+
+        gobject root_i;
+        ERROR_DEFER([&root_i](){
+            delete_instance(root_i);
+        });
+
+        while ( nodes.size() < plan.size() ) {
+            gobject inst_i = new_plan_instance(world, plan, nodes);
+            if ( !root_i ) {
+                // from here every instance is owned by the root
+                root_i = std::move(inst_i);
+            }
+        }
+
+        return root_i;
+    }
+
     gobject new_instance(world& world, const prefab& root_prefab) {
+        if ( const prefab_plan_ptr& plan = root_prefab.plan() ) {
+            return new_instance(world, *plan);
+        }
+
         ecs::entity ent = world.registry().create_entity(root_prefab.prototype());
         auto ent_defer = defer_hpp::make_error_defer([&ent](){
             ent.destroy();
         });
 
-        gobject root_i(make_intrusive<gobject_state>(world, ent));
+        gobject root_i(gobject::state_iptr(
+            new(world.state_allocator()) gobject_state(world, ent)));
         ERROR_DEFER([&root_i](){
             delete_instance(root_i);
         });
 
         ent_defer.dismiss();
+        world.mark_instance_changes(root_i);
 
         {
             gcomponent<actor> root_a{root_i};
-            node_iptr new_root_node = node::create(root_i);
+            node_iptr new_root_node = node::create(world.node_allocator(), world.transforms(), root_i);
             if ( root_a && root_a->node() ) {
                 new_root_node->transform(root_a->node()->transform());
             }
@@ -122,7 +225,118 @@ namespace
 
 namespace e2d
 {
-    world::~world() noexcept = default;
+    //
+    // world::async_instance
+    //
+
+    class world::async_instance final : private noncopyable {
+    public:
+        async_instance(prefab_plan_ptr plan, node_iptr parent, u64 budget_us)
+        : plan_(std::move(plan))
+        , parent_(std::move(parent))
+        , budget_us_(budget_us) {
+            nodes_.reserve(plan_->size());
+        }
+
+        ~async_instance() noexcept {
+            if ( !finished_ ) {
+                delete_instance(root_);
+                promise_.reject(instantiate_cancelled_exception());
+            } else {
+                settle();
+            }
+        }
+
+        const stdex::promise<gobject>& promise() const noexcept {
+            return promise_;
+        }
+
+        u64 budget_us() const noexcept {
+            return budget_us_;
+        }
+
+        bool finished() const noexcept {
+            return finished_;
+        }
+
+        std::size_t pending_nodes() const noexcept {
+            return plan_->size() - nodes_.size();
+        }
+
+        // resolves or rejects the promise of a finished instance, handlers
+        // run here, so it must not be called while instances are iterated
+        void settle() noexcept {
+            if ( !finished_ || settled_ ) {
+                return;
+            }
+            settled_ = true;
+            if ( error_ ) {
+                promise_.reject(error_);
+            } else {
+                promise_.resolve(root_);
+            }
+        }
+
+        // builds one node, completes the instance after the last one
+        void build_next(world& w) noexcept {
+            E2D_ASSERT(!finished_);
+            try {
+                if ( nodes_.size() < plan_->size() ) {
+                    gobject inst_i = new_plan_instance(w, *plan_, nodes_);
+                    if ( !root_ ) {
+                        root_ = inst_i;
+                    }
+                    gcomponent<disabled<actor>> inst_d{inst_i};
+                    if ( !inst_d.exists() ) {
+                        inst_d.assign();
+                        disabled_.push_back(std::move(inst_i));
+                    }
+                }
+                if ( nodes_.size() == plan_->size() ) {
+                    complete_();
+                }
+            } catch (...) {
+                finished_ = true;
+                delete_instance(root_);
+                error_ = std::current_exception();
+            }
+        }
+    private:
+        void complete_() {
+            if ( parent_ ) {
+                parent_->add_child(nodes_.front());
+            }
+            for ( gobject& inst : disabled_ ) {
+                gcomponent<disabled<actor>>{inst}.remove();
+            }
+            finished_ = true;
+        }
+    private:
+        prefab_plan_ptr plan_;
+        node_iptr parent_;
+        u64 budget_us_{0u};
+        gobject root_;
+        vector<node_iptr> nodes_;
+        vector<gobject> disabled_;
+        stdex::promise<gobject> promise_;
+        std::exception_ptr error_;
+        bool finished_{false};
+        bool settled_{false};
+    };
+
+    //
+    // world
+    //
+
+    world::world()
+    : state_allocator_(std::make_shared<pool_allocator>(gobject_state_block_size, 1024u))
+    , node_allocator_(node::create_allocator(1024u)) {}
+
+    world::~world() noexcept {
+        async_instances_.clear();
+        clear_pools();
+        finalize_instances();
+    }
 
     ecs::registry& world::registry() noexcept {
         return registry_;
@@ -198,6 +412,177 @@ namespace e2d
         }
     }
 
+    stdex::promise<gobject> world::instantiate_async(const prefab& prefab) {
+        return instantiate_async(prefab, nullptr, async_budget_us_);
+    }
+
+    stdex::promise<gobject> world::instantiate_async(const prefab& prefab, const node_iptr& parent) {
+        return instantiate_async(prefab, parent, async_budget_us_);
+    }
+
+    stdex::promise<gobject> world::instantiate_async(
+        const prefab& prefab,
+        const node_iptr& parent,
+        u64 budget_us)
+    {
+        prefab_plan_ptr plan = prefab.plan()
+            ? prefab.plan()
+            : std::make_shared<prefab_plan>(prefab);
+
+        async_instances_.push_back(std::make_unique<async_instance>(
+            std::move(plan),
+            parent,
+            budget_us));
+
+        async_stats_.pending_instances = async_instances_.size();
+        async_stats_.pending_nodes += async_instances_.back()->pending_nodes();
+
+        return async_instances_.back()->promise();
+    }
+
+    prefab_pool& world::pool(const prefab& prefab) {
+        if ( !prefab.plan() ) {
+            throw bad_world_operation();
+        }
+        auto iter = pools_.find(prefab.plan().get());
+        if ( iter == pools_.end() ) {
+            iter = pools_.emplace(
+                prefab.plan().get(),
+                std::make_unique<prefab_pool>(*this, prefab)).first;
+        }
+        return *iter->second;
+    }
+
+    void world::clear_pools() noexcept {
+        pools_.clear();
+    }
+
+    void world::mark_instance_changes(const gobject& inst) {
+        const ecs::const_entity inst_e = inst.raw_entity();
+        if ( inst_e.exists_component<label>() ) {
+            changes<label::dirty>().mark(inst_e.id());
+        }
+        if ( inst_e.exists_component<layout>() ) {
+            changes<layout::dirty>().mark(inst_e.id());
+        }
+        if ( inst_e.exists_component<widget>() ) {
+            changes<widget::dirty>().mark(inst_e.id());
+        }
+    }
+
+    void world::process_async_instances() {
+        const auto begin_us = time::now_us<u64>();
+        const auto elapsed_us = [begin_us](){
+            return (time::now_us<u64>() - begin_us).value;
+        };
+
+        std::size_t step_nodes = 0u;
+        std::size_t pending_nodes = 0u;
+
+        // promise handlers can start new instances, so the step works on
+        // its own list and the new instances are appended after it
+        vector<async_instance_uptr> instances;
+        instances.swap(async_instances_);
+
+        // instances are built in order, the first node of a step is built
+        // regardless of the budget so every step makes progress
+        for ( const async_instance_uptr& inst : instances ) {
+            while ( !inst->finished() ) {
+                if ( step_nodes > 0u && elapsed_us() >= inst->budget_us() ) {
+                    break;
+                }
+                inst->build_next(*this);
+                ++step_nodes;
+            }
+            if ( inst->finished() ) {
+                ++async_stats_.finished_instances;
+            } else {
+                pending_nodes += inst->pending_nodes();
+            }
+        }
+
+        const auto finished_begin = std::stable_partition(
+            instances.begin(),
+            instances.end(),
+            [](const async_instance_uptr& inst){ return !inst->finished(); });
+
+        vector<async_instance_uptr> finished;
+        finished.reserve(static_cast<std::size_t>(
+            std::distance(finished_begin, instances.end())));
+        std::move(finished_begin, instances.end(), std::back_inserter(finished));
+        instances.erase(finished_begin, instances.end());
+
+        // instances started during the step go after the pending ones
+        instances.insert(
+            instances.end(),
+            std::make_move_iterator(async_instances_.begin()),
+            std::make_move_iterator(async_instances_.end()));
+        async_instances_.swap(instances);
+
+        async_stats_.pending_instances = async_instances_.size();
+        async_stats_.pending_nodes = pending_nodes;
+        async_stats_.last_step_nodes = step_nodes;
+        async_stats_.last_step_us = elapsed_us();
+
+        for ( const async_instance_uptr& inst : finished ) {
+            inst->settle();
+        }
+    }
+
+    world& world::async_budget_us(u64 value) noexcept {
+        async_budget_us_ = value;
+        return *this;
+    }
+
+    u64 world::async_budget_us() const noexcept {
+        return async_budget_us_;
+    }
+
+    world::async_statistics world::async_stats() const noexcept {
+        return async_stats_;
+    }
+
+    system_scheduler& world::scheduler() noexcept {
+        return scheduler_;
+    }
+
+    const system_scheduler& world::scheduler() const noexcept {
+        return scheduler_;
+    }
+
+    ecsex::command_buffer& world::commands() noexcept {
+        return commands_;
+    }
+
+    const ecsex::command_buffer& world::commands() const noexcept {
+        return commands_;
+    }
+
+    const std::shared_ptr<pool_allocator>& world::state_allocator() const noexcept {
+        return state_allocator_;
+    }
+
+    const std::shared_ptr<pool_allocator>& world::node_allocator() const noexcept {
+        return node_allocator_;
+    }
+
+    world& world::flat_transforms(bool value) {
+        if ( value != flat_transforms() ) {
+            transforms_ = value
+                ? std::make_shared<transform_hierarchy>()
+                : nullptr;
+        }
+        return *this;
+    }
+
+    bool world::flat_transforms() const noexcept {
+        return !!transforms_;
+    }
+
+    const std::shared_ptr<transform_hierarchy>& world::transforms() const noexcept {
+        return transforms_;
+    }
+
     void world::finalize_instances() noexcept {
         while ( !destroying_states_.empty() ) {
             gobject inst{&destroying_states_.front()};
@@ -10,6 +10,8 @@
 
 #include <fcntl.h>
 #include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 namespace
 {
@@ -181,6 +183,68 @@ namespace
         str path_;
         int handle_ = -1;
     };
+
+    class mapped_file_posix final : public mapped_file {
+    public:
+        mapped_file_posix(str path)
+        : path_(std::move(path))
+        {
+            if ( !open_() ) {
+                throw bad_stream_operation();
+            }
+        }
+
+        ~mapped_file_posix() noexcept final {
+            close_();
+        }
+    public:
+        const void* data() const noexcept final {
+            return data_;
+        }
+
+        std::size_t size() const noexcept final {
+            return size_;
+        }
+
+        const str& path() const noexcept final {
+            return path_;
+        }
+    private:
+        bool open_() noexcept {
+            const int handle = ::open(path_.c_str(), O_RDONLY);
+            if ( handle < 0 ) {
+                return false;
+            }
+            struct stat st;
+            if ( 0 != ::fstat(handle, &st) || st.st_size < 0 ) {
+                ::close(handle);
+                return false;
+            }
+            size_ = math::numeric_cast<std::size_t>(st.st_size);
+            if ( size_ > 0u ) {
+                void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, handle, 0);
+                if ( MAP_FAILED == data ) {
+                    ::close(handle);
+                    return false;
+                }
+                data_ = data;
+            }
+            // the mapping stays valid after closing the descriptor
+            ::close(handle);
+            return true;
+        }
+
+        void close_() noexcept {
+            if ( data_ ) {
+                ::munmap(data_, size_);
+                data_ = nullptr;
+            }
+        }
+    private:
+        str path_;
+        void* data_ = nullptr;
+        std::size_t size_ = 0;
+    };
 }
 
 namespace e2d::impl
@@ -200,6 +264,14 @@ namespace e2d::impl
             return nullptr;
         }
     }
+
+    mapped_file_uptr make_mapped_file(str_view path) noexcept {
+        try {
+            return std::make_unique<mapped_file_posix>(str(path));
+        } catch (...) {
+            return nullptr;
+        }
+    }
 }
 
 #endif
@@ -220,6 +220,81 @@ namespace
         str path_;
         HANDLE handle_ = INVALID_HANDLE_VALUE;
     };
+
+    class mapped_file_winapi final : public mapped_file {
+    public:
+        mapped_file_winapi(str path)
+        : path_(std::move(path))
+        {
+            if ( !open_() ) {
+                throw bad_stream_operation();
+            }
+        }
+
+        ~mapped_file_winapi() noexcept final {
+            close_();
+        }
+    public:
+        const void* data() const noexcept final {
+            return data_;
+        }
+
+        std::size_t size() const noexcept final {
+            return size_;
+        }
+
+        const str& path() const noexcept final {
+            return path_;
+        }
+    private:
+        bool open_() {
+            const wstr wide_path = make_wide(path_);
+            HANDLE file = ::CreateFileW(
+                wide_path.c_str(),
+                GENERIC_READ,
+                FILE_SHARE_READ,
+                NULL,
+                OPEN_EXISTING,
+                FILE_ATTRIBUTE_READONLY,
+                NULL);
+            if ( INVALID_HANDLE_VALUE == file ) {
+                return false;
+            }
+            LARGE_INTEGER file_size;
+            if ( FALSE == ::GetFileSizeEx(file, &file_size) ) {
+                ::CloseHandle(file);
+                return false;
+            }
+            size_ = math::numeric_cast<std::size_t>(file_size.QuadPart);
+            if ( size_ > 0u ) {
+                HANDLE mapping = ::CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+                if ( NULL == mapping ) {
+                    ::CloseHandle(file);
+                    return false;
+                }
+                data_ = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                // the view keeps the mapping object alive
+                ::CloseHandle(mapping);
+                if ( NULL == data_ ) {
+                    ::CloseHandle(file);
+                    return false;
+                }
+            }
+            ::CloseHandle(file);
+            return true;
+        }
+
+        void close_() noexcept {
+            if ( data_ ) {
+                ::UnmapViewOfFile(data_);
+                data_ = nullptr;
+            }
+        }
+    private:
+        str path_;
+        const void* data_ = nullptr;
+        std::size_t size_ = 0;
+    };
 }
 
 namespace e2d::impl
@@ -239,6 +314,14 @@ namespace e2d::impl
             return nullptr;
         }
     }
+
+    mapped_file_uptr make_mapped_file(str_view path) noexcept {
+        try {
+            return std::make_unique<mapped_file_winapi>(str(path));
+        } catch (...) {
+            return nullptr;
+        }
+    }
 }
 
 #endif
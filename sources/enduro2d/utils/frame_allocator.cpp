@@ -0,0 +1,203 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/utils/frame_allocator.hpp>
+
+namespace
+{
+    using namespace e2d;
+
+    std::atomic<u32> frame_index{0u};
+    std::atomic<std::size_t> arena_count{0u};
+    std::atomic<std::size_t> arena_capacity{0u};
+    std::atomic<std::size_t> frame_high_water{0u};
+    std::atomic<std::size_t> last_frame_high_water{0u};
+    std::atomic<std::size_t> peak_high_water{0u};
+
+    void atomic_max(std::atomic<std::size_t>& target, std::size_t value) noexcept {
+        std::size_t prev = target.load(std::memory_order_relaxed);
+        while ( prev < value && !target.compare_exchange_weak(
+            prev, value, std::memory_order_relaxed) ) {}
+    }
+
+    class thread_frame_arena final : private noncopyable {
+    public:
+        thread_frame_arena() {
+            arena_count.fetch_add(1u, std::memory_order_relaxed);
+        }
+
+        ~thread_frame_arena() noexcept {
+            arena_count.fetch_sub(1u, std::memory_order_relaxed);
+            arena_capacity.fetch_sub(capacity_, std::memory_order_relaxed);
+        }
+
+        linear_arena& arena() noexcept {
+            const u32 frame = frame_index.load(std::memory_order_relaxed);
+            if ( frame_ != frame && !arena_.stats().used ) {
+                arena_.reset();
+                frame_ = frame;
+            }
+            return arena_;
+        }
+
+        void publish() noexcept {
+            const linear_arena::statistics& stats = arena_.stats();
+            atomic_max(frame_high_water, stats.high_water);
+            atomic_max(peak_high_water, stats.high_water);
+            if ( capacity_ != stats.capacity ) {
+                arena_capacity.fetch_add(stats.capacity - capacity_, std::memory_order_relaxed);
+                capacity_ = stats.capacity;
+            }
+        }
+    private:
+        linear_arena arena_;
+        u32 frame_{frame_index.load(std::memory_order_relaxed)};
+        std::size_t capacity_{0u};
+    };
+
+    thread_frame_arena& current_thread_frame_arena() {
+        static thread_local thread_frame_arena arena;
+        return arena;
+    }
+}
+
+namespace e2d
+{
+    //
+    // linear_arena
+    //
+
+    linear_arena::linear_arena(std::size_t chunk_size)
+    : chunk_size_(math::max(chunk_size, std::size_t(1u))) {}
+
+    linear_arena::~linear_arena() noexcept {
+        E2D_ASSERT_MSG(!stats_.used, "all allocations must be rewound before destruction");
+    }
+
+    void* linear_arena::allocate(std::size_t size, std::size_t alignment) {
+        E2D_ASSERT(math::is_power_of_2(alignment));
+
+        while ( true ) {
+            if ( chunk_index_ == chunks_.size() ) {
+                const std::size_t new_chunk_size = math::max(chunk_size_, size + alignment);
+                chunks_.push_back({std::unique_ptr<u8[]>(new u8[new_chunk_size]), new_chunk_size});
+                stats_.capacity += new_chunk_size;
+                ++stats_.chunks;
+            }
+
+            chunk& c = chunks_[chunk_index_];
+            const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(c.data.get());
+            const std::uintptr_t begin = (base + offset_ + alignment - 1u) & ~std::uintptr_t(alignment - 1u);
+            const std::size_t end = (begin - base) + size;
+
+            if ( end <= c.size ) {
+                stats_.used += end - offset_;
+                stats_.high_water = math::max(stats_.high_water, stats_.used);
+                stats_.peak_high_water = math::max(stats_.peak_high_water, stats_.used);
+                offset_ = end;
+                return reinterpret_cast<void*>(begin);
+            }
+
+            // the tail of the chunk stays unused until rewind
+            stats_.used += c.size - offset_;
+            offset_ = 0u;
+            ++chunk_index_;
+        }
+    }
+
+    void linear_arena::deallocate(void* ptr, std::size_t size) noexcept {
+        if ( !ptr || chunk_index_ == chunks_.size() ) {
+            return;
+        }
+
+        const u8* chunk_data = chunks_[chunk_index_].data.get();
+        const u8* ptr_data = static_cast<const u8*>(ptr);
+
+        if ( ptr_data >= chunk_data && ptr_data + size == chunk_data + offset_ ) {
+            const std::size_t begin = math::numeric_cast<std::size_t>(ptr_data - chunk_data);
+            stats_.used -= offset_ - begin;
+            offset_ = begin;
+        }
+    }
+
+    linear_arena::marker linear_arena::mark() const noexcept {
+        return {chunk_index_, offset_, stats_.used};
+    }
+
+    void linear_arena::rewind(const marker& m) noexcept {
+        E2D_ASSERT(m.chunk < chunk_index_ || (m.chunk == chunk_index_ && m.offset <= offset_));
+        chunk_index_ = m.chunk;
+        offset_ = m.offset;
+        stats_.used = m.used;
+    }
+
+    void linear_arena::reset() noexcept {
+        chunk_index_ = 0u;
+        offset_ = 0u;
+        stats_.used = 0u;
+
+        if ( chunks_.size() > 1u ) {
+            const std::size_t new_chunk_size = math::max(chunk_size_, stats_.high_water);
+            try {
+                chunk new_chunk{std::unique_ptr<u8[]>(new u8[new_chunk_size]), new_chunk_size};
+                chunks_.clear();
+                chunks_.push_back(std::move(new_chunk));
+                stats_.capacity = new_chunk_size;
+                stats_.chunks = 1u;
+            } catch (...) {
+                // keeps the old chunks
+            }
+        }
+
+        stats_.high_water = 0u;
+    }
+
+    const linear_arena::statistics& linear_arena::stats() const noexcept {
+        return stats_;
+    }
+
+    //
+    // frame_allocator
+    //
+
+    linear_arena& frame_allocator::thread_arena() {
+        return current_thread_frame_arena().arena();
+    }
+
+    void frame_allocator::next_frame() noexcept {
+        last_frame_high_water.store(
+            frame_high_water.exchange(0u, std::memory_order_relaxed),
+            std::memory_order_relaxed);
+        frame_index.fetch_add(1u, std::memory_order_relaxed);
+    }
+
+    frame_allocator::statistics frame_allocator::stats() noexcept {
+        statistics result;
+        result.frame = frame_index.load(std::memory_order_relaxed);
+        result.arenas = arena_count.load(std::memory_order_relaxed);
+        result.capacity = arena_capacity.load(std::memory_order_relaxed);
+        result.frame_high_water = last_frame_high_water.load(std::memory_order_relaxed);
+        result.peak_high_water = peak_high_water.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    //
+    // frame_allocator::scope
+    //
+
+    frame_allocator::scope::scope()
+    : arena_(thread_arena())
+    , marker_(arena_.mark()) {}
+
+    frame_allocator::scope::~scope() noexcept {
+        current_thread_frame_arena().publish();
+        arena_.rewind(marker_);
+    }
+
+    linear_arena& frame_allocator::scope::arena() const noexcept {
+        return arena_;
+    }
+}
@@ -556,6 +556,216 @@ namespace
     }
 }
 
+namespace
+{
+    using namespace e2d;
+
+    const char binary_json_magic[] = {'E', '2', 'D', 'J'};
+    const u8 binary_json_version = 2u; // adds the schema tag
+    const u8 binary_json_untagged_version = 1u;
+    const std::size_t binary_json_max_depth = 256u;
+
+    enum class binary_json_tag : u8 {
+        null_value,
+        false_value,
+        true_value,
+        int_value,
+        uint_value,
+        int64_value,
+        uint64_value,
+        double_value,
+        string_value,
+        start_object,
+        end_object,
+        start_array,
+        end_array
+    };
+
+    class binary_json_writer final {
+    public:
+        using Ch = char;
+    public:
+        binary_json_writer(vector<u8>& dst)
+        : dst_(dst) {}
+
+        bool Null() { return write_tag_(binary_json_tag::null_value); }
+        bool Bool(bool b) { return write_tag_(b ? binary_json_tag::true_value : binary_json_tag::false_value); }
+        bool Int(int i) { return write_tag_(binary_json_tag::int_value) && write_(static_cast<i32>(i)); }
+        bool Uint(unsigned u) { return write_tag_(binary_json_tag::uint_value) && write_(static_cast<u32>(u)); }
+        bool Int64(i64 i) { return write_tag_(binary_json_tag::int64_value) && write_(i); }
+        bool Uint64(u64 u) { return write_tag_(binary_json_tag::uint64_value) && write_(u); }
+        bool Double(f64 d) { return write_tag_(binary_json_tag::double_value) && write_(d); }
+
+        bool String(const Ch* str, rapidjson::SizeType length, bool) {
+            write_tag_(binary_json_tag::string_value);
+            write_(static_cast<u32>(length));
+            dst_.insert(dst_.end(), str, str + length);
+            return true;
+        }
+
+        bool Key(const Ch* str, rapidjson::SizeType length, bool copy) {
+            return String(str, length, copy);
+        }
+
+        bool StartObject() { return write_tag_(binary_json_tag::start_object); }
+        bool EndObject(rapidjson::SizeType) { return write_tag_(binary_json_tag::end_object); }
+        bool StartArray() { return write_tag_(binary_json_tag::start_array); }
+        bool EndArray(rapidjson::SizeType) { return write_tag_(binary_json_tag::end_array); }
+    private:
+        bool write_tag_(binary_json_tag tag) {
+            dst_.push_back(static_cast<u8>(tag));
+            return true;
+        }
+
+        template < typename T >
+        bool write_(T v) {
+            const u8* p = reinterpret_cast<const u8*>(&v);
+            dst_.insert(dst_.end(), p, p + sizeof(v));
+            return true;
+        }
+    private:
+        vector<u8>& dst_;
+    };
+
+    class binary_json_reader final {
+    public:
+        binary_json_reader(buffer_view src, std::size_t pos) noexcept
+        : data_(static_cast<const u8*>(src.data()))
+        , size_(src.size())
+        , pos_(pos) {}
+
+        template < typename Handler >
+        bool operator()(Handler& handler) {
+            success_ = read_value_(handler, 0u) && pos_ == size_;
+            return success_;
+        }
+
+        bool success() const noexcept {
+            return success_;
+        }
+    private:
+        template < typename Handler >
+        bool read_value_(Handler& handler, std::size_t depth) {
+            binary_json_tag tag;
+            return read_(tag)
+                && read_tagged_value_(handler, tag, depth);
+        }
+
+        template < typename Handler >
+        bool read_tagged_value_(Handler& handler, binary_json_tag tag, std::size_t depth) {
+            switch ( tag ) {
+                case binary_json_tag::null_value:
+                    return handler.Null();
+                case binary_json_tag::false_value:
+                    return handler.Bool(false);
+                case binary_json_tag::true_value:
+                    return handler.Bool(true);
+                case binary_json_tag::int_value: {
+                    i32 v{0};
+                    return read_(v) && handler.Int(v);
+                }
+                case binary_json_tag::uint_value: {
+                    u32 v{0u};
+                    return read_(v) && handler.Uint(v);
+                }
+                case binary_json_tag::int64_value: {
+                    i64 v{0};
+                    return read_(v) && handler.Int64(v);
+                }
+                case binary_json_tag::uint64_value: {
+                    u64 v{0u};
+                    return read_(v) && handler.Uint64(v);
+                }
+                case binary_json_tag::double_value: {
+                    f64 v{0.0};
+                    return read_(v) && handler.Double(v);
+                }
+                case binary_json_tag::string_value: {
+                    const char* str = nullptr;
+                    rapidjson::SizeType length = 0u;
+                    return read_string_(str, length) && handler.String(str, length, true);
+                }
+                case binary_json_tag::start_object:
+                    return read_object_(handler, depth);
+                case binary_json_tag::start_array:
+                    return read_array_(handler, depth);
+                default:
+                    return false;
+            }
+        }
+
+        template < typename Handler >
+        bool read_object_(Handler& handler, std::size_t depth) {
+            if ( depth >= binary_json_max_depth || !handler.StartObject() ) {
+                return false;
+            }
+            for ( rapidjson::SizeType count = 0u; ; ++count ) {
+                binary_json_tag tag;
+                if ( !read_(tag) ) {
+                    return false;
+                }
+                if ( tag == binary_json_tag::end_object ) {
+                    return handler.EndObject(count);
+                }
+                const char* key = nullptr;
+                rapidjson::SizeType length = 0u;
+                if ( tag != binary_json_tag::string_value
+                    || !read_string_(key, length)
+                    || !handler.Key(key, length, true)
+                    || !read_value_(handler, depth + 1u) )
+                {
+                    return false;
+                }
+            }
+        }
+
+        template < typename Handler >
+        bool read_array_(Handler& handler, std::size_t depth) {
+            if ( depth >= binary_json_max_depth || !handler.StartArray() ) {
+                return false;
+            }
+            for ( rapidjson::SizeType count = 0u; ; ++count ) {
+                binary_json_tag tag;
+                if ( !read_(tag) ) {
+                    return false;
+                }
+                if ( tag == binary_json_tag::end_array ) {
+                    return handler.EndArray(count);
+                }
+                if ( !read_tagged_value_(handler, tag, depth + 1u) ) {
+                    return false;
+                }
+            }
+        }
+
+        bool read_string_(const char*& str, rapidjson::SizeType& length) noexcept {
+            u32 size{0u};
+            if ( !read_(size) || size > size_ - pos_ ) {
+                return false;
+            }
+            str = reinterpret_cast<const char*>(data_ + pos_);
+            length = size;
+            pos_ += size;
+            return true;
+        }
+
+        template < typename T >
+        bool read_(T& v) noexcept {
+            if ( sizeof(v) > size_ - pos_ ) {
+                return false;
+            }
+            std::memcpy(&v, data_ + pos_, sizeof(v));
+            pos_ += sizeof(v);
+            return true;
+        }
+    private:
+        const u8* data_{nullptr};
+        std::size_t size_{0u};
+        std::size_t pos_{0u};
+        bool success_{false};
+    };
+}
+
 namespace e2d::json_utils
 {
     void add_common_schema_definitions(rapidjson::Document& schema) {
@@ -568,6 +778,83 @@ namespace e2d::json_utils
     }
 }
 
+namespace e2d::json_utils
+{
+    bool is_binary_json(buffer_view src) noexcept {
+        return src.size() >= sizeof(binary_json_magic) + sizeof(binary_json_version)
+            && 0 == std::memcmp(src.data(), binary_json_magic, sizeof(binary_json_magic));
+    }
+
+    bool try_load_binary_json(rapidjson::Document& dst, buffer_view src) noexcept {
+        str schema_tag;
+        return try_load_binary_json(dst, schema_tag, src);
+    }
+
+    bool try_load_binary_json(rapidjson::Document& dst, str& schema_tag, buffer_view src) noexcept {
+        try {
+            if ( !is_binary_json(src) ) {
+                return false;
+            }
+
+            const u8* data = static_cast<const u8*>(src.data());
+            std::size_t pos = sizeof(binary_json_magic);
+            const u8 version = data[pos++];
+
+            str tag;
+            if ( version == binary_json_version ) {
+                if ( pos >= src.size() || data[pos] > src.size() - pos - 1u ) {
+                    return false;
+                }
+                const std::size_t tag_size = data[pos++];
+                tag.assign(reinterpret_cast<const char*>(data + pos), tag_size);
+                pos += tag_size;
+            } else if ( version != binary_json_untagged_version ) {
+                return false;
+            }
+
+            rapidjson::Document doc;
+            binary_json_reader reader(src, pos);
+            doc.Populate(reader);
+            if ( !reader.success() ) {
+                return false;
+            }
+
+            dst.Swap(doc);
+            schema_tag = std::move(tag);
+            return true;
+        } catch (...) {
+            return false;
+        }
+    }
+
+    bool try_save_binary_json(const rapidjson::Value& src, buffer& dst) noexcept {
+        return try_save_binary_json(src, str_view(), dst);
+    }
+
+    bool try_save_binary_json(const rapidjson::Value& src, str_view schema_tag, buffer& dst) noexcept {
+        try {
+            if ( schema_tag.size() > std::numeric_limits<u8>::max() ) {
+                return false;
+            }
+
+            vector<u8> data(std::begin(binary_json_magic), std::end(binary_json_magic));
+            data.push_back(binary_json_version);
+            data.push_back(static_cast<u8>(schema_tag.size()));
+            data.insert(data.end(), schema_tag.begin(), schema_tag.end());
+
+            binary_json_writer writer(data);
+            if ( !src.Accept(writer) ) {
+                return false;
+            }
+
+            dst.assign(data.data(), data.size());
+            return true;
+        } catch (...) {
+            return false;
+        }
+    }
+}
+
 namespace e2d::json_utils
 {
     bool try_parse_value(const rapidjson::Value& root, v2i& v) noexcept {
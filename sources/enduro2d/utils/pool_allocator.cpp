@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/utils/pool_allocator.hpp>
+
+namespace
+{
+    using namespace e2d;
+
+    constexpr std::size_t block_alignment = alignof(std::max_align_t);
+
+    std::size_t align_block_size(std::size_t size) noexcept {
+        size = math::max(size, sizeof(void*));
+        return (size + block_alignment - 1u) / block_alignment * block_alignment;
+    }
+}
+
+namespace e2d
+{
+    pool_allocator::pool_allocator(
+        std::size_t block_size,
+        std::size_t blocks_per_chunk)
+    : block_size_(align_block_size(block_size))
+    , blocks_per_chunk_(math::max(blocks_per_chunk, std::size_t(1u))) {}
+
+    pool_allocator::~pool_allocator() noexcept {
+        E2D_ASSERT_MSG(!stats_.live_blocks, "all blocks must be returned to the pool");
+    }
+
+    void* pool_allocator::allocate() {
+        std::lock_guard<std::mutex> guard(mutex_);
+
+        if ( !free_list_ ) {
+            chunks_.push_back(std::make_unique<u8[]>(block_size_ * blocks_per_chunk_));
+            u8* chunk = chunks_.back().get();
+            for ( std::size_t i = blocks_per_chunk_; i > 0u; --i ) {
+                free_list_ = new(chunk + (i - 1u) * block_size_) free_block{free_list_};
+            }
+            ++stats_.chunks;
+        }
+
+        free_block* block = free_list_;
+        free_list_ = block->next;
+
+        ++stats_.allocations;
+        ++stats_.live_blocks;
+        stats_.peak_blocks = math::max(stats_.peak_blocks, stats_.live_blocks);
+
+        return block;
+    }
+
+    void pool_allocator::deallocate(void* block) noexcept {
+        if ( !block ) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        E2D_ASSERT(stats_.live_blocks > 0u);
+
+        free_list_ = new(block) free_block{free_list_};
+
+        ++stats_.deallocations;
+        --stats_.live_blocks;
+    }
+
+    std::size_t pool_allocator::block_size() const noexcept {
+        return block_size_;
+    }
+
+    pool_allocator::statistics pool_allocator::stats() const noexcept {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return stats_;
+    }
+}
@@ -0,0 +1,546 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/enduro2d.hpp>
+using namespace e2d;
+
+#include <cctype>
+
+namespace
+{
+    const char* cooked_manifest_filename = "cooked_manifest.json";
+    const char* type_sidecar_extension = ".type";
+
+    struct typed_json_asset {
+        const char* type;
+        const rapidjson::SchemaDocument& (*schema)();
+    };
+
+    const typed_json_asset typed_json_assets[] = {
+        {atlas_asset::type_name(), &atlas_asset::json_schema},
+        {flipbook_asset::type_name(), &flipbook_asset::json_schema},
+        {material_asset::type_name(), &material_asset::json_schema},
+        {model_asset::type_name(), &model_asset::json_schema},
+        {prefab_asset::type_name(), &prefab_asset::json_schema},
+        {shader_asset::type_name(), &shader_asset::json_schema},
+        {sound_asset::type_name(), &sound_asset::json_schema},
+        {sprite_asset::type_name(), &sprite_asset::json_schema}};
+
+    void print_usage() {
+        std::printf(
+            "usage: e2d_cook [--keep-images] <input directory> <output directory>\n"
+            "  --keep-images : copy images as is instead of decoding them\n"
+            "\n"
+            "  json files are validated and converted to binary json,\n"
+            "  the asset type is inferred from the asset schemas or read\n"
+            "  from a '<file>%s' sidecar with the type name, the files\n"
+            "  the typed assets reference are listed as their dependencies,\n"
+            "  png, jpg and tga images are decoded to uncompressed pvr,\n"
+            "  other files are copied, the result is listed in '%s':\n"
+            "  images, fonts, meshes, shapes and xml by their extension,\n"
+            "  textures, shader sources and sounds with the type they are\n"
+            "  loaded as by the assets that reference them, unreferenced\n"
+            "  files of unknown types are not listed\n",
+            type_sidecar_extension,
+            cooked_manifest_filename);
+    }
+
+    str to_lower(str_view s) {
+        str result(s);
+        std::transform(result.begin(), result.end(), result.begin(), [](char c){
+            return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        });
+        return result;
+    }
+
+    bool is_json_file(str_view filename) {
+        return to_lower(path::extension(filename)) == ".json";
+    }
+
+    bool is_type_sidecar_file(str_view filename) {
+        return to_lower(path::extension(filename)) == type_sidecar_extension;
+    }
+
+    bool is_decodable_image_file(str_view filename) {
+        const str ext = to_lower(path::extension(filename));
+        return ext == ".png"
+            || ext == ".jpg"
+            || ext == ".jpeg"
+            || ext == ".tga";
+    }
+
+    bool is_font_file(str_view filename) {
+        return to_lower(path::extension(filename)) == ".fnt";
+    }
+
+    // the loader of raw files known by their extension
+    const char* find_raw_asset_type(str_view filename, bool keep_images) {
+        const str ext = to_lower(path::extension(filename));
+        if ( ext == ".pvr" || ext == ".dds" || (keep_images && is_decodable_image_file(filename)) ) {
+            return image_asset::type_name();
+        }
+        if ( ext == ".e2d_mesh" ) {
+            return mesh_asset::type_name();
+        }
+        if ( ext == ".e2d_shape" ) {
+            return shape_asset::type_name();
+        }
+        if ( ext == ".xml" ) {
+            return xml_asset::type_name();
+        }
+        return nullptr;
+    }
+
+    const typed_json_asset* find_typed_json_asset(str_view type) noexcept {
+        const auto iter = std::find_if(
+            std::begin(typed_json_assets), std::end(typed_json_assets),
+            [type](const typed_json_asset& a) noexcept {
+                return type == a.type;
+            });
+        return iter != std::end(typed_json_assets)
+            ? iter
+            : nullptr;
+    }
+
+    bool is_valid_json_asset(const rapidjson::Document& doc, const typed_json_asset& asset) {
+        rapidjson::SchemaValidator validator(asset.schema());
+        return doc.Accept(validator);
+    }
+
+    // the sidecar type wins, otherwise the only schema the document matches,
+    // ambiguous and unknown documents stay plain json assets
+    bool infer_json_asset_type(
+        const rapidjson::Document& doc,
+        const str& input_path,
+        str& type)
+    {
+        const str sidecar_path = input_path + type_sidecar_extension;
+        if ( filesystem::file_exists(sidecar_path) ) {
+            str sidecar;
+            if ( !filesystem::try_read_all(sidecar, sidecar_path) ) {
+                std::fprintf(stderr, "e2d_cook: failed to read file '%s'\n", sidecar_path.c_str());
+                return false;
+            }
+            sidecar.erase(std::remove_if(sidecar.begin(), sidecar.end(), [](char c){
+                return std::isspace(static_cast<unsigned char>(c));
+            }), sidecar.end());
+
+            if ( sidecar == json_asset::type_name() ) {
+                type = sidecar;
+                return true;
+            }
+
+            const typed_json_asset* asset = find_typed_json_asset(sidecar);
+            if ( !asset ) {
+                std::fprintf(stderr, "e2d_cook: unknown json asset type '%s' in '%s'\n",
+                    sidecar.c_str(), sidecar_path.c_str());
+                return false;
+            }
+            if ( !is_valid_json_asset(doc, *asset) ) {
+                std::fprintf(stderr, "e2d_cook: json '%s' is not a valid '%s'\n",
+                    input_path.c_str(), asset->type);
+                return false;
+            }
+
+            type = asset->type;
+            return true;
+        }
+
+        vector<const char*> matches;
+        for ( const typed_json_asset& asset : typed_json_assets ) {
+            if ( is_valid_json_asset(doc, asset) ) {
+                matches.push_back(asset.type);
+            }
+        }
+
+        if ( matches.size() > 1u ) {
+            std::fprintf(stderr, "e2d_cook: json '%s' matches several asset types, "
+                "add a '%s' sidecar to choose one\n",
+                input_path.c_str(), type_sidecar_extension);
+        }
+
+        type = matches.size() == 1u
+            ? matches.front()
+            : json_asset::type_name();
+        return true;
+    }
+
+    // nested addresses ('atlas.json:/sprite') depend on their main asset
+    void add_dependency(
+        str_view parent_address,
+        const rapidjson::Value& root,
+        vector<str>& dependencies)
+    {
+        if ( root.IsString() ) {
+            dependencies.push_back(address::parent(
+                path::combine(parent_address, root.GetString())));
+        }
+    }
+
+    void add_member_dependency(
+        str_view parent_address,
+        const rapidjson::Value& root,
+        const char* member,
+        vector<str>& dependencies)
+    {
+        if ( root.IsObject() && root.HasMember(member) ) {
+            add_dependency(parent_address, root[member], dependencies);
+        }
+    }
+
+    void collect_material_dependencies(
+        str_view parent_address,
+        const rapidjson::Value& root,
+        vector<str>& dependencies,
+        hash_map<str, str>& raw_types)
+    {
+        if ( !root.IsObject() ) {
+            return;
+        }
+
+        add_member_dependency(parent_address, root, "shader", dependencies);
+
+        if ( root.HasMember("samplers") && root["samplers"].IsArray() ) {
+            for ( const rapidjson::Value& sampler : root["samplers"].GetArray() ) {
+                if ( sampler.IsObject() && sampler.HasMember("texture") ) {
+                    add_dependency(parent_address, sampler["texture"], dependencies);
+                    raw_types.emplace(dependencies.back(), texture_asset::type_name());
+                }
+            }
+        }
+
+        if ( root.HasMember("property_block") ) {
+            collect_material_dependencies(
+                parent_address, root["property_block"], dependencies, raw_types);
+        }
+
+        if ( root.HasMember("passes") && root["passes"].IsArray() ) {
+            for ( const rapidjson::Value& pass : root["passes"].GetArray() ) {
+                collect_material_dependencies(parent_address, pass, dependencies, raw_types);
+            }
+        }
+    }
+
+    // mirrors the collect_dependencies of the component factory loaders
+    void collect_prefab_dependencies(
+        str_view parent_address,
+        const rapidjson::Value& root,
+        vector<str>& dependencies)
+    {
+        if ( !root.IsObject() ) {
+            return;
+        }
+
+        add_member_dependency(parent_address, root, "prefab", dependencies);
+
+        for ( const char* children : {"children", "mod_children"} ) {
+            if ( root.HasMember(children) && root[children].IsArray() ) {
+                for ( const rapidjson::Value& child : root[children].GetArray() ) {
+                    collect_prefab_dependencies(parent_address, child, dependencies);
+                }
+            }
+        }
+
+        if ( !root.HasMember("components") || !root["components"].IsObject() ) {
+            return;
+        }
+
+        const rapidjson::Value& components = root["components"];
+        for ( rapidjson::Value::ConstMemberIterator component = components.MemberBegin();
+            component != components.MemberEnd();
+            ++component )
+        {
+            const str_view name = component->name.GetString();
+            const rapidjson::Value& value = component->value;
+            if ( !value.IsObject() ) {
+                continue;
+            }
+            if ( name == "flipbook_player" ) {
+                add_member_dependency(parent_address, value, "flipbook", dependencies);
+            } else if ( name == "label" ) {
+                add_member_dependency(parent_address, value, "font", dependencies);
+            } else if ( name == "model_renderer" ) {
+                add_member_dependency(parent_address, value, "model", dependencies);
+            } else if ( name == "renderer" ) {
+                if ( value.HasMember("materials") && value["materials"].IsArray() ) {
+                    for ( const rapidjson::Value& material : value["materials"].GetArray() ) {
+                        add_dependency(parent_address, material, dependencies);
+                    }
+                }
+            } else if ( name == "sprite_renderer" ) {
+                add_member_dependency(parent_address, value, "atlas", dependencies);
+                add_member_dependency(parent_address, value, "sprite", dependencies);
+                if ( value.HasMember("materials") && value["materials"].IsObject() ) {
+                    const rapidjson::Value& materials = value["materials"];
+                    for ( rapidjson::Value::ConstMemberIterator material = materials.MemberBegin();
+                        material != materials.MemberEnd();
+                        ++material )
+                    {
+                        add_dependency(parent_address, material->value, dependencies);
+                    }
+                }
+            }
+        }
+    }
+
+    // the assets the typed loader of the document requests, sorted and unique,
+    // raw files it reads get the type of their loader in 'raw_types'
+    vector<str> collect_json_dependencies(
+        str_view type,
+        const rapidjson::Document& doc,
+        str_view address,
+        hash_map<str, str>& raw_types)
+    {
+        const str parent_address = path::parent_path(address);
+
+        vector<str> dependencies;
+        if ( type == atlas_asset::type_name() || type == sprite_asset::type_name() ) {
+            add_member_dependency(parent_address, doc, "texture", dependencies);
+            for ( const str& dependency : dependencies ) {
+                raw_types.emplace(dependency, texture_asset::type_name());
+            }
+        } else if ( type == flipbook_asset::type_name() ) {
+            if ( doc.HasMember("frames") && doc["frames"].IsArray() ) {
+                for ( const rapidjson::Value& frame : doc["frames"].GetArray() ) {
+                    add_member_dependency(parent_address, frame, "atlas", dependencies);
+                    add_member_dependency(parent_address, frame, "sprite", dependencies);
+                }
+            }
+        } else if ( type == material_asset::type_name() ) {
+            collect_material_dependencies(parent_address, doc, dependencies, raw_types);
+        } else if ( type == model_asset::type_name() ) {
+            add_member_dependency(parent_address, doc, "mesh", dependencies);
+        } else if ( type == prefab_asset::type_name() ) {
+            collect_prefab_dependencies(parent_address, doc, dependencies);
+        } else if ( type == shader_asset::type_name() ) {
+            add_member_dependency(parent_address, doc, "vertex", dependencies);
+            add_member_dependency(parent_address, doc, "fragment", dependencies);
+            for ( const str& dependency : dependencies ) {
+                raw_types.emplace(dependency, text_asset::type_name());
+            }
+        } else if ( type == sound_asset::type_name() ) {
+            // streaming sounds are opened by the sound loader, not the library
+            const bool streaming = doc.HasMember("streaming")
+                && doc["streaming"].IsBool()
+                && doc["streaming"].GetBool();
+            if ( !streaming ) {
+                add_member_dependency(parent_address, doc, "sound", dependencies);
+                for ( const str& dependency : dependencies ) {
+                    raw_types.emplace(dependency, binary_asset::type_name());
+                }
+            }
+        }
+
+        std::sort(dependencies.begin(), dependencies.end());
+        dependencies.erase(
+            std::unique(dependencies.begin(), dependencies.end()),
+            dependencies.end());
+        dependencies.erase(
+            std::remove(dependencies.begin(), dependencies.end(), address),
+            dependencies.end());
+        return dependencies;
+    }
+
+    bool cook_json(
+        const buffer& src,
+        const str& input_path,
+        asset_manifest::entry& entry,
+        hash_map<str, str>& raw_types,
+        buffer& dst)
+    {
+        rapidjson::Document doc;
+        if ( doc.Parse(reinterpret_cast<const char*>(src.data()), src.size()).HasParseError() ) {
+            std::fprintf(stderr, "e2d_cook: failed to parse json '%s'\n", input_path.c_str());
+            return false;
+        }
+
+        if ( !infer_json_asset_type(doc, input_path, entry.type) ) {
+            return false;
+        }
+
+        entry.dependencies = collect_json_dependencies(
+            entry.type, doc, entry.address, raw_types);
+
+        // typed blobs are tagged, their loaders skip the schema validation
+        const str_view schema_tag = entry.type != json_asset::type_name()
+            ? str_view(entry.type)
+            : str_view();
+
+        if ( !json_utils::try_save_binary_json(doc, schema_tag, dst) ) {
+            std::fprintf(stderr, "e2d_cook: failed to convert json '%s'\n", input_path.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    // fonts are copied as is, their atlas texture is a dependency
+    bool cook_font(
+        const buffer& src,
+        asset_manifest::entry& entry,
+        hash_map<str, str>& raw_types)
+    {
+        font content;
+        if ( !fonts::try_load_font(content, src) ) {
+            return false;
+        }
+        entry.type = font_asset::type_name();
+        entry.dependencies.push_back(address::parent(path::combine(
+            path::parent_path(entry.address),
+            content.info().atlas_file)));
+        raw_types.emplace(entry.dependencies.back(), texture_asset::type_name());
+        return true;
+    }
+
+    bool cook_image(const buffer& src, buffer& dst) {
+        image content;
+        if ( !images::try_load_image(content, src) ) {
+            return false;
+        }
+        // the address keeps its extension, loaders detect pvr by content
+        return images::check_save_image_support(content, image_file_format::pvr)
+            && images::try_save_image(content, image_file_format::pvr, dst);
+    }
+
+    bool write_file(const buffer& content, str_view filename) {
+        const str directory = path::parent_path(filename);
+        if ( !directory.empty() && !filesystem::create_directory_recursive(directory) ) {
+            return false;
+        }
+        return filesystem::try_write_all(content, filename, false);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    bool keep_images = false;
+    vector<str_view> paths;
+
+    for ( int i = 1; i < argc; ++i ) {
+        const str_view arg = argv[i];
+        if ( arg == "--keep-images" ) {
+            keep_images = true;
+        } else if ( arg == "--help" || arg == "-h" ) {
+            print_usage();
+            return 0;
+        } else {
+            paths.push_back(arg);
+        }
+    }
+
+    if ( paths.size() != 2u ) {
+        print_usage();
+        return 1;
+    }
+
+    const str input_directory(paths[0]);
+    const str output_directory(paths[1]);
+
+    vector<str> filenames;
+    const bool traced = filesystem::trace_directory_recursive(input_directory,
+        [&filenames](str_view relative, bool is_directory){
+            if ( !is_directory
+                && relative != cooked_manifest_filename
+                && !is_type_sidecar_file(relative) )
+            {
+                filenames.emplace_back(relative);
+            }
+            return true;
+        });
+
+    if ( !traced ) {
+        std::fprintf(stderr, "e2d_cook: failed to read directory '%s'\n", input_directory.c_str());
+        return 1;
+    }
+
+    std::sort(filenames.begin(), filenames.end());
+
+    u64 source_bytes = 0u;
+    u64 cooked_bytes = 0u;
+
+    // raw files and images get their type from the assets that reference them
+    hash_map<str, str> raw_types;
+    vector<asset_manifest::entry> entries;
+
+    for ( str& filename : filenames ) {
+        const str input_path = path::combine(input_directory, filename);
+        const str output_path = path::combine(output_directory, filename);
+        std::replace(filename.begin(), filename.end(), '\\', '/');
+
+        buffer source;
+        if ( !filesystem::try_read_all(source, input_path) ) {
+            std::fprintf(stderr, "e2d_cook: failed to read file '%s'\n", input_path.c_str());
+            return 1;
+        }
+
+        asset_manifest::entry entry;
+        entry.address = filename;
+
+        buffer cooked;
+        if ( is_json_file(filename) ) {
+            if ( !cook_json(source, input_path, entry, raw_types, cooked) ) {
+                return 1;
+            }
+        } else if ( !keep_images && is_decodable_image_file(filename) ) {
+            entry.type = image_asset::type_name();
+            if ( !cook_image(source, cooked) ) {
+                std::fprintf(stderr, "e2d_cook: failed to decode image '%s'\n", input_path.c_str());
+                return 1;
+            }
+        } else if ( is_font_file(filename) ) {
+            if ( !cook_font(source, entry, raw_types) ) {
+                std::fprintf(stderr, "e2d_cook: failed to parse font '%s'\n", input_path.c_str());
+                return 1;
+            }
+            cooked = source;
+        } else {
+            if ( const char* type = find_raw_asset_type(filename, keep_images) ) {
+                entry.type = type;
+            }
+            cooked = source;
+        }
+
+        if ( !write_file(cooked, output_path) ) {
+            std::fprintf(stderr, "e2d_cook: failed to write file '%s'\n", output_path.c_str());
+            return 1;
+        }
+
+        source_bytes += source.size();
+        cooked_bytes += cooked.size();
+        entry.size = cooked.size();
+        entries.push_back(std::move(entry));
+    }
+
+    // an entry under another type than its readers request would keep
+    // the same file twice in the store, unreferenced unknown files stay out
+    asset_manifest manifest;
+    for ( asset_manifest::entry& entry : entries ) {
+        const auto iter = raw_types.find(entry.address);
+        if ( iter != raw_types.end()
+            && (entry.type.empty() || entry.type == image_asset::type_name()) )
+        {
+            entry.type = iter->second;
+        }
+        if ( !entry.type.empty() ) {
+            manifest.add_entry(std::move(entry));
+        }
+    }
+
+    buffer manifest_data;
+    const str manifest_path = path::combine(output_directory, cooked_manifest_filename);
+    if ( !asset_manifests::try_save_manifest(manifest, manifest_data)
+        || !write_file(manifest_data, manifest_path) )
+    {
+        std::fprintf(stderr, "e2d_cook: failed to write manifest '%s'\n", manifest_path.c_str());
+        return 1;
+    }
+
+    std::printf("e2d_cook: %zu files cooked into '%s', %zu listed (%llu -> %llu bytes)\n",
+        filenames.size(),
+        output_directory.c_str(),
+        manifest.size(),
+        static_cast<unsigned long long>(source_bytes),
+        static_cast<unsigned long long>(cooked_bytes));
+    return 0;
+}
@@ -0,0 +1,56 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/enduro2d.hpp>
+using namespace e2d;
+
+namespace
+{
+    void print_usage() {
+        std::printf(
+            "usage: e2d_pack [--compress] <input directory> <output bundle>\n"
+            "  --compress : deflate files that become smaller\n");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    bool compress = false;
+    vector<str_view> paths;
+
+    for ( int i = 1; i < argc; ++i ) {
+        const str_view arg = argv[i];
+        if ( arg == "--compress" ) {
+            compress = true;
+        } else if ( arg == "--help" || arg == "-h" ) {
+            print_usage();
+            return 0;
+        } else {
+            paths.push_back(arg);
+        }
+    }
+
+    if ( paths.size() != 2u ) {
+        print_usage();
+        return 1;
+    }
+
+    const str input_directory(paths[0]);
+    const str output_bundle(paths[1]);
+
+    bundle_builder builder;
+    if ( !builder.add_directory(input_directory, compress) ) {
+        std::fprintf(stderr, "e2d_pack: failed to read directory '%s'\n", input_directory.c_str());
+        return 1;
+    }
+
+    if ( !builder.write(output_bundle) ) {
+        std::fprintf(stderr, "e2d_pack: failed to write bundle '%s'\n", output_bundle.c_str());
+        return 1;
+    }
+
+    std::printf("e2d_pack: %zu files packed into '%s'\n", builder.size(), output_bundle.c_str());
+    return 0;
+}
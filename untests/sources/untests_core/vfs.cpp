@@ -47,6 +47,63 @@ TEST_CASE("vfs"){
             auto b3 = v.load_as_string_async({"file", file_path}).get();
             REQUIRE(b3 == "hello");
         }
+        {
+            auto v0 = v.load_view({"file", file_path});
+            REQUIRE(v0);
+            REQUIRE(v0->mapped());
+            REQUIRE(v0->content() == buffer_view(buffer{"hello", 5}));
+
+            auto v1 = v.load_view_async({"file", file_path}).get();
+            REQUIRE(v1.content() == buffer_view(buffer{"hello", 5}));
+
+            REQUIRE_FALSE(v.load_view({"file", nofile_path}));
+            REQUIRE_THROWS_AS(
+                v.load_view_async({"file", nofile_path}).get(),
+                vfs_load_async_exception);
+        }
+    }
+    {
+        vfs v(4u);
+        REQUIRE(v.register_scheme<filesystem_file_source>("file"));
+        REQUIRE(v.io_stats().threads == 4u);
+        {
+            v.worker().pause();
+            vfs::cancellation token;
+            auto p0 = v.load_async({"file", file_path}, vfs::priority::prefetch, token);
+            auto p1 = v.load_async({"file", file_path}, vfs::priority::critical);
+            auto p2 = v.load_as_string_async({"file", file_path}, vfs::priority::normal, token);
+            REQUIRE(v.io_stats().queued == 3u);
+            REQUIRE(v.io_stats().peak_queued == 3u);
+            token.cancel();
+            REQUIRE(token.cancelled());
+            v.worker().resume();
+
+            REQUIRE(p1.get() == buffer{"hello", 5});
+            REQUIRE_THROWS_AS(p0.get(), vfs_load_cancelled_exception);
+            REQUIRE_THROWS_AS(p2.get(), vfs_load_cancelled_exception);
+            REQUIRE_THROWS_AS(
+                v.load_view_async({"file", nofile_path}).get(),
+                vfs_load_async_exception);
+
+            const vfs::io_statistics stats = v.io_stats();
+            REQUIRE(stats.queued == 0u);
+            REQUIRE(stats.completed == 1u);
+            REQUIRE(stats.cancelled == 2u);
+            REQUIRE(stats.failed == 1u);
+            REQUIRE(stats.bytes == 5u);
+        }
+        {
+            v.reset_io_stats();
+            vector<stdex::promise<buffer>> loads;
+            for ( std::size_t i = 0; i < 16; ++i ) {
+                loads.push_back(v.load_async({"file", file_path}));
+            }
+            for ( auto& l : loads ) {
+                REQUIRE(l.get() == buffer{"hello", 5});
+            }
+            REQUIRE(v.io_stats().completed == 16u);
+            REQUIRE(v.io_stats().bytes == 80u);
+        }
     }
     {
         vfs v;
@@ -54,6 +111,31 @@ TEST_CASE("vfs"){
         v.register_scheme_alias("save", url("home://game/saves"));
         REQUIRE(v.resolve_scheme_aliases({"home", "file.txt"}) == url("file://~/file.txt"));
         REQUIRE(v.resolve_scheme_aliases({"save", "save.txt"}) == url("file://~/game/saves/save.txt"));
+        REQUIRE(v.resolve_scheme_aliases({"file", "file.txt"}) == url("file://file.txt"));
+
+        REQUIRE_FALSE(v.register_scheme_alias("home", url("file://~2")));
+        REQUIRE_FALSE(v.register_scheme_alias("file", url("save://file")));
+        REQUIRE(v.resolve_scheme_aliases({"file", "file.txt"}) == url("file://file.txt"));
+
+        REQUIRE(v.unregister_scheme_alias("home"));
+        REQUIRE(v.resolve_scheme_aliases({"save", "save.txt"}) == url("home://game/saves/save.txt"));
+        REQUIRE(v.register_scheme_alias("home", url("file://~3")));
+        REQUIRE(v.resolve_scheme_aliases({"save", "save.txt"}) == url("file://~3/game/saves/save.txt"));
+        REQUIRE(v.resolve_scheme_aliases({"save", str(300, 'a')}) == url("file://~3/game/saves/" + str(300, 'a')));
+    }
+    {
+        vfs v;
+        REQUIRE(v.register_scheme<filesystem_file_source>("file"));
+        REQUIRE(v.register_scheme_alias("work", url("file://")));
+        REQUIRE(v.exists({"work", file_path}));
+
+        // readers keep using the source until they finish
+        auto f = v.read({"work", file_path});
+        REQUIRE(v.unregister_scheme("file"));
+        REQUIRE_FALSE(v.exists({"work", file_path}));
+        buffer b;
+        REQUIRE(streams::try_read_tail(b, f));
+        REQUIRE(b == buffer{"hello", 5});
     }
     SECTION("archive"){
         vfs v;
@@ -75,7 +157,31 @@ TEST_CASE("vfs"){
             REQUIRE(v.register_scheme<archive_file_source>(
                 "archive",
                 v.read(url("resources://bin/resources.zip"))));
-
+        }
+        {
+            archive_file_source s(v.read(url("resources://bin/resources.zip")), 1024u);
+            REQUIRE(s.valid());
+            for ( std::size_t i = 0; i < 2; ++i ) {
+                auto f = s.read("folder/file.txt");
+                REQUIRE(f);
+                REQUIRE(f->length() == 5u);
+                REQUIRE(f->seek(1, false) == 1u);
+                buffer b;
+                REQUIRE(streams::try_read_tail(b, f));
+                REQUIRE(b == buffer("orld", 4));
+                REQUIRE(f->seek(-2, true) == 3u);
+            }
+            const auto stats = s.cache_stats();
+            REQUIRE(stats.capacity == 1024u);
+            if ( stats.misses > 0u ) {
+                // the entry is deflated, the second read hits the cache
+                REQUIRE(stats.misses == 1u);
+                REQUIRE(stats.hits == 1u);
+                REQUIRE(stats.entries == 1u);
+                REQUIRE(stats.size == 5u);
+            }
+        }
+        {
             REQUIRE(v.exists({"archive", "test.txt"}));
             REQUIRE_FALSE(v.exists({"archive", "TEst.txt"}));
 
@@ -149,6 +255,12 @@ TEST_CASE("vfs"){
                 auto b3 = v.load_as_string_async(url("archive://test.txt")).get();
                 REQUIRE(b3 == "hello");
             }
+            {
+                auto v0 = v.load_view(url("archive://test.txt"));
+                REQUIRE(v0);
+                REQUIRE_FALSE(v0->mapped());
+                REQUIRE(v0->content() == buffer_view(buffer("hello", 5)));
+            }
             {
                 auto f = v.read(url("archive://folder/file.txt"));
                 REQUIRE(f);
@@ -198,4 +310,98 @@ TEST_CASE("vfs"){
             }
         }
     }
+    SECTION("bundle"){
+        const str bundle_path = "vfs_bundle_name";
+        {
+            bundle_builder b;
+            b.add_file("test.txt", buffer("hello", 5), false);
+            b.add_file("folder/file.txt", buffer("world", 5), true);
+            b.add_file("folder/packed.txt", buffer(str(1024, 'a').c_str(), 1024), true);
+            REQUIRE(b.size() == 3u);
+            REQUIRE(b.write(bundle_path));
+        }
+        {
+            vfs v;
+            REQUIRE(v.register_scheme<bundle_file_source>(
+                "bundle",
+                make_mapped_file(bundle_path)));
+            REQUIRE(v.exists(url("bundle://test.txt")));
+            REQUIRE(v.exists(url("bundle://folder/file.txt")));
+            REQUIRE(v.exists(url("bundle://folder/packed.txt")));
+            REQUIRE_FALSE(v.exists(url("bundle://folder")));
+            REQUIRE_FALSE(v.exists(url("bundle://TEst.txt")));
+            {
+                auto f = v.read(url("bundle://test.txt"));
+                REQUIRE(f);
+                REQUIRE(f->length() == 5u);
+                REQUIRE(f->seek(2, false) == 2u);
+                buffer b;
+                REQUIRE(streams::try_read_tail(b, f));
+                REQUIRE(b == buffer("llo", 3));
+            }
+            {
+                REQUIRE(v.load(url("bundle://folder/file.txt")) == buffer("world", 5));
+                REQUIRE(v.load_as_string(url("bundle://folder/packed.txt")) == str(1024, 'a'));
+                REQUIRE(v.load_async(url("bundle://test.txt")).get() == buffer("hello", 5));
+                REQUIRE_FALSE(v.load(url("bundle://folder/none.txt")));
+            }
+            {
+                vector<std::pair<str,bool>> result;
+                REQUIRE(v.extract(url("bundle://folder"), std::back_inserter(result)));
+                std::sort(result.begin(), result.end());
+                REQUIRE(result == vector<std::pair<str,bool>>{
+                    {"folder/file.txt", false},
+                    {"folder/packed.txt", false}
+                });
+                REQUIRE_FALSE(v.extract(url("bundle://fold"), std::back_inserter(result)));
+            }
+        }
+        {
+            bundle_file_source s(make_mapped_file(bundle_path));
+            REQUIRE(s.valid());
+            auto stored = s.view("test.txt");
+            REQUIRE(stored);
+            REQUIRE(stored->mapped());
+            REQUIRE(stored->content() == buffer_view(buffer("hello", 5)));
+            REQUIRE_FALSE(s.view("folder/packed.txt"));
+            REQUIRE_FALSE(s.view("none.txt"));
+            REQUIRE_FALSE(s.write("test.txt", false));
+        }
+        {
+            vfs v;
+            REQUIRE(v.register_scheme<bundle_file_source>(
+                "bundle",
+                make_mapped_file(bundle_path)));
+            auto stored = v.load_view(url("bundle://test.txt"));
+            auto packed = v.load_view(url("bundle://folder/packed.txt"));
+            REQUIRE(v.unregister_scheme("bundle"));
+            REQUIRE(stored);
+            REQUIRE(stored->mapped());
+            REQUIRE(stored->content() == buffer_view(buffer("hello", 5)));
+            REQUIRE(packed);
+            REQUIRE_FALSE(packed->mapped());
+            REQUIRE(packed->size() == 1024u);
+        }
+        {
+            const str invalid_path = "vfs_bundle_name2";
+            REQUIRE(filesystem::try_write_all(buffer{"hello", 5}, invalid_path, false));
+            REQUIRE_FALSE(bundle_file_source(make_mapped_file(invalid_path)).valid());
+            REQUIRE_FALSE(bundle_file_source(nullptr).valid());
+        }
+        {
+            // entry ranges that wrap around u64 are rejected
+            buffer content;
+            REQUIRE(filesystem::try_read_all(content, bundle_path));
+            u8* first_entry = content.data() + 32u;
+            const u64 offset = ~u64(0) - 0xFFu;
+            const u32 size = 0x200u;
+            std::memcpy(first_entry + 16u, &offset, sizeof(offset));
+            std::memcpy(first_entry + 24u, &size, sizeof(size));
+            std::memcpy(first_entry + 28u, &size, sizeof(size));
+
+            const str invalid_path = "vfs_bundle_name3";
+            REQUIRE(filesystem::try_write_all(content, invalid_path, false));
+            REQUIRE_FALSE(bundle_file_source(make_mapped_file(invalid_path)).valid());
+        }
+    }
 }
@@ -31,8 +31,10 @@ namespace
     public:
         static const char* type_name() noexcept { return "fake_asset"; }
 
-        static load_async_result load_async(const library& library, str_view address) {
-            E2D_UNUSED(library);
+        static load_async_result load_async(
+            const library& library, str_view address, vfs::priority priority)
+        {
+            E2D_UNUSED(library, priority);
             return address == "42"
                 ? stdex::make_resolved_promise(fake_asset::create(42, {
                     {"21", fake_nested_asset::create(21, {
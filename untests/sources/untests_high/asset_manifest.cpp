@@ -0,0 +1,113 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_high.hpp"
+using namespace e2d;
+
+namespace
+{
+    asset_manifest::entry make_entry(
+        str type,
+        str address,
+        u64 size,
+        vfs::priority priority = vfs::priority::normal,
+        vector<str> dependencies = {})
+    {
+        asset_manifest::entry e;
+        e.type = std::move(type);
+        e.address = std::move(address);
+        e.size = size;
+        e.priority = priority;
+        e.dependencies = std::move(dependencies);
+        return e;
+    }
+}
+
+TEST_CASE("asset_manifest") {
+    SECTION("entries") {
+        asset_manifest m;
+        REQUIRE(m.empty());
+        REQUIRE(m.total_size() == 0u);
+
+        m.add_entry(make_entry("texture_asset", "ship.png", 100u));
+        m.add_entry(make_entry("image_asset", "ship.png", 0u));
+        m.add_entry(make_entry("sprite_asset", "ship.json", 10u,
+            vfs::priority::critical, {"ship.png"}));
+        REQUIRE(m.size() == 3u);
+        REQUIRE(m.total_size() == 110u);
+
+        m.add_entry(make_entry("texture_asset", "ship.png", 200u));
+        REQUIRE(m.size() == 3u);
+        REQUIRE(m.total_size() == 210u);
+        REQUIRE(m.entries()[0].size == 200u);
+
+        m.clear();
+        REQUIRE(m.empty());
+    }
+    SECTION("types") {
+        REQUIRE(asset_manifest::is_known_type("texture_asset"));
+        REQUIRE(asset_manifest::is_known_type("prefab_asset"));
+        REQUIRE_FALSE(asset_manifest::is_known_type("unknown_asset"));
+        REQUIRE_FALSE(asset_manifest::is_known_type(""));
+    }
+    SECTION("save_load") {
+        asset_manifest m;
+        m.add_entry(make_entry("texture_asset", "ship.png", 100u));
+        m.add_entry(make_entry("sprite_asset", "ship.json", 10u,
+            vfs::priority::critical, {"ship.png"}));
+        m.add_entry(make_entry("sound_asset", "intro.ogg", 1000u,
+            vfs::priority::prefetch));
+
+        buffer data;
+        REQUIRE(asset_manifests::try_save_manifest(m, data));
+
+        asset_manifest m2;
+        REQUIRE(asset_manifests::try_load_manifest(m2, data));
+        REQUIRE(m2.size() == 3u);
+        REQUIRE(m2.total_size() == 1110u);
+        REQUIRE(m2.entries()[1].type == "sprite_asset");
+        REQUIRE(m2.entries()[1].address == "ship.json");
+        REQUIRE(m2.entries()[1].priority == vfs::priority::critical);
+        REQUIRE(m2.entries()[1].dependencies == vector<str>{"ship.png"});
+        REQUIRE(m2.entries()[2].priority == vfs::priority::prefetch);
+    }
+    SECTION("load") {
+        const str_view src = R"json({
+            "assets" : [
+                { "type" : "texture_asset", "address" : "ship.png" },
+                { "type" : "sprite_asset", "address" : "ship.json", "size" : 10 }
+            ]
+        })json";
+        asset_manifest m;
+        REQUIRE(asset_manifests::try_load_manifest(m, buffer(src.data(), src.size())));
+        REQUIRE(m.size() == 2u);
+        REQUIRE(m.total_size() == 10u);
+        REQUIRE(m.entries()[0].priority == vfs::priority::normal);
+        REQUIRE(m.entries()[0].dependencies.empty());
+    }
+    SECTION("invalid") {
+        asset_manifest m;
+        m.add_entry(make_entry("texture_asset", "ship.png", 100u));
+
+        const str_view srcs[] = {
+            "",
+            "[]",
+            R"json({ "assets" : {} })json",
+            R"json({ "assets" : [{ "address" : "ship.png" }] })json",
+            R"json({ "assets" : [{ "type" : "texture_asset" }] })json",
+            R"json({ "assets" : [{ "type" : "texture_asset", "address" : "a", "size" : -1 }] })json",
+            R"json({ "assets" : [{ "type" : "texture_asset", "address" : "a", "priority" : "high" }] })json",
+            R"json({ "assets" : [{ "type" : "texture_asset", "address" : "a", "dependencies" : [1] }] })json"};
+
+        for ( str_view src : srcs ) {
+            REQUIRE_FALSE(asset_manifests::try_load_manifest(m, buffer(src.data(), src.size())));
+        }
+
+        // failed loads keep the previous content
+        REQUIRE(m.size() == 1u);
+        REQUIRE(m.entries()[0].address == "ship.png");
+    }
+}
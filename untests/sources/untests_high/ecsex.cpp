@@ -0,0 +1,247 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_high.hpp"
+using namespace e2d;
+
+namespace
+{
+    struct dirty_tag {};
+    struct position { int x = 0; };
+
+    struct layer {
+        i32 depth_ = 0;
+        i32 depth() const noexcept { return depth_; }
+    };
+}
+
+TEST_CASE("ecsex") {
+    SECTION("change_set") {
+        ecs::registry owner;
+        ecs::entity e1 = owner.create_entity();
+        ecs::entity e2 = owner.create_entity();
+        ecs::entity e3 = owner.create_entity();
+
+        ecsex::change_set changes;
+        REQUIRE(changes.empty());
+        REQUIRE_FALSE(changes.is_marked(e1.id()));
+
+        REQUIRE(changes.mark(e1.id()));
+        REQUIRE_FALSE(changes.mark(e1.id()));
+        REQUIRE(changes.mark(e2.id()));
+        REQUIRE(changes.mark(e3.id()));
+        REQUIRE(changes.size() == 3u);
+        REQUIRE(changes.is_marked(e1.id()));
+        REQUIRE(changes.is_marked(e2.id()));
+        REQUIRE(changes.is_marked(e3.id()));
+
+        REQUIRE(changes.unmark(e1.id()));
+        REQUIRE_FALSE(changes.unmark(e1.id()));
+        REQUIRE(changes.size() == 2u);
+        REQUIRE_FALSE(changes.is_marked(e1.id()));
+        REQUIRE(changes.is_marked(e2.id()));
+        REQUIRE(changes.is_marked(e3.id()));
+
+        e2.destroy();
+        std::size_t visited = 0;
+        changes.for_each(owner, [&visited, &e3](const ecs::entity& e){
+            REQUIRE(e == e3);
+            ++visited;
+        });
+        REQUIRE(visited == 1u);
+
+        changes.clear();
+        REQUIRE(changes.empty());
+        REQUIRE_FALSE(changes.is_marked(e3.id()));
+        REQUIRE(changes.mark(e3.id()));
+        REQUIRE(changes.is_marked(e3.id()));
+    }
+    SECTION("for_joined_changed_components") {
+        ecs::registry owner;
+        ecs::entity e1 = owner.create_entity();
+        ecs::entity e2 = owner.create_entity();
+        e1.assign_component<position>(position{1});
+
+        ecsex::change_set changes;
+        changes.mark(e1.id());
+        changes.mark(e2.id());
+
+        int sum = 0;
+        ecsex::for_joined_changed_components<position>(changes, owner, [&sum](
+            const ecs::entity&,
+            position& p)
+        {
+            sum += p.x;
+        });
+        REQUIRE(sum == 1);
+    }
+    SECTION("command_buffer") {
+        ecs::registry owner;
+        ecs::entity e1 = owner.create_entity();
+        ecs::entity e2 = owner.create_entity();
+        e1.assign_component<position>(position{1});
+
+        ecsex::command_buffer commands;
+        REQUIRE(commands.empty());
+
+        commands.ensure_component<position>(e1, position{2});
+        commands.assign_component<dirty_tag>(e1);
+        commands.assign_component<position>(e2, position{3});
+        commands.remove_component<position>(e2);
+
+        ecsex::command_buffer::deferred_entity e3 = commands.create_entity();
+        REQUIRE(e3.valid());
+        commands.assign_component<position>(e3, position{4});
+        REQUIRE(commands.size() == 6u);
+
+        REQUIRE(e1.get_component<position>().x == 1);
+        REQUIRE_FALSE(e1.exists_component<dirty_tag>());
+
+        REQUIRE(commands.playback(owner) == 6u);
+        REQUIRE(commands.empty());
+        REQUIRE(e1.get_component<position>().x == 1);
+        REQUIRE(e1.exists_component<dirty_tag>());
+        REQUIRE_FALSE(e2.exists_component<position>());
+
+        int sum = 0;
+        owner.for_each_component<position>([&sum](const ecs::entity&, const position& p){
+            sum += p.x;
+        });
+        REQUIRE(sum == 5);
+
+        commands.remove_component<dirty_tag>(e1);
+        commands.destroy_entity(e2);
+        e1.destroy();
+        REQUIRE(commands.playback(owner) == 2u);
+        REQUIRE_FALSE(e2.valid());
+
+        commands.create_entity();
+        commands.clear();
+        REQUIRE(commands.empty());
+        REQUIRE(commands.playback(owner) == 0u);
+
+        for ( std::size_t i = 0; i < 10'000u; ++i ) {
+            commands.assign_component<position>(commands.create_entity(), position{1});
+        }
+        REQUIRE(commands.size() == 20'000u);
+        REQUIRE(commands.playback(owner) == 20'000u);
+
+        std::size_t count = 0u;
+        owner.for_each_component<position>([&count](const ecs::entity&, const position&){
+            ++count;
+        });
+        REQUIRE(count == 10'001u);
+    }
+    SECTION("depth_sorted_entities") {
+        ecs::registry owner;
+        ecs::entity e1 = owner.create_entity();
+        ecs::entity e2 = owner.create_entity();
+        ecs::entity e3 = owner.create_entity();
+        e1.assign_component<layer>(layer{2});
+        e2.assign_component<layer>(layer{0});
+        e3.assign_component<layer>(layer{1});
+        e3.assign_component<dirty_tag>();
+
+        const auto collect = [&owner](const ecsex::depth_sorted_entities<layer>& layers){
+            vector<i32> depths;
+            layers.for_each(owner, [&depths](const ecs::entity&, const layer& l){
+                depths.push_back(l.depth());
+            });
+            return depths;
+        };
+
+        ecsex::depth_sorted_entities<layer> layers;
+        REQUIRE(layers.update(owner));
+        REQUIRE_FALSE(layers.update(owner));
+        REQUIRE(layers.size() == 3u);
+        REQUIRE(collect(layers) == vector<i32>{0, 1, 2});
+
+        {
+            vector<i32> depths;
+            layers.for_each<dirty_tag>(owner, [&depths](const ecs::entity&, const layer& l, const dirty_tag&){
+                depths.push_back(l.depth());
+            });
+            REQUIRE(depths == vector<i32>{1});
+        }
+        {
+            vector<i32> depths;
+            layers.for_each(owner, [&depths](const ecs::entity&, const layer& l){
+                depths.push_back(l.depth());
+            }, !ecs::exists<dirty_tag>());
+            REQUIRE(depths == vector<i32>{0, 2});
+        }
+
+        e1.get_component<layer>().depth_ = -1;
+        REQUIRE(layers.update(owner));
+        REQUIRE(collect(layers) == vector<i32>{-1, 0, 1});
+
+        e2.remove_component<layer>();
+        REQUIRE(layers.update(owner));
+        REQUIRE(collect(layers) == vector<i32>{-1, 1});
+
+        e2.assign_component<layer>(layer{5});
+        e3.destroy();
+        REQUIRE(layers.update(owner));
+        REQUIRE(collect(layers) == vector<i32>{-1, 5});
+
+        layers.invalidate();
+        REQUIRE(layers.update(owner));
+        REQUIRE_FALSE(layers.update(owner));
+    }
+    SECTION("performance") {
+        std::printf("-= ecsex::performance tests =-\n");
+    #if defined(E2D_BUILD_MODE) && E2D_BUILD_MODE == E2D_BUILD_MODE_DEBUG
+        const std::size_t entity_n = 10'000;
+        const std::size_t frame_n = 100;
+    #else
+        const std::size_t entity_n = 100'000;
+        const std::size_t frame_n = 1'000;
+    #endif
+        ecs::registry owner;
+        vector<ecs::entity> entities;
+        for ( std::size_t i = 0; i < entity_n; ++i ) {
+            ecs::entity e = owner.create_entity();
+            e.assign_component<position>();
+            entities.push_back(e);
+        }
+        {
+            std::size_t result = 0;
+            e2d_untests::verbose_profiler_ms p("dirty tags (1% dirty)");
+            for ( std::size_t f = 0; f < frame_n; ++f ) {
+                for ( std::size_t i = f % 100; i < entity_n; i += 100 ) {
+                    entities[i].ensure_component<dirty_tag>();
+                }
+                owner.for_joined_components<dirty_tag, position>([&result](
+                    const ecs::entity&,
+                    const dirty_tag&,
+                    position& p)
+                {
+                    result += static_cast<std::size_t>(++p.x);
+                });
+                owner.remove_all_components<dirty_tag>();
+            }
+            p.done(result);
+        }
+        {
+            std::size_t result = 0;
+            ecsex::change_set changes;
+            e2d_untests::verbose_profiler_ms p("change set (1% dirty)");
+            for ( std::size_t f = 0; f < frame_n; ++f ) {
+                for ( std::size_t i = f % 100; i < entity_n; i += 100 ) {
+                    changes.mark(entities[i].id());
+                }
+                ecsex::for_joined_changed_components<position>(changes, owner, [&result](
+                    const ecs::entity&,
+                    position& p)
+                {
+                    result += static_cast<std::size_t>(++p.x);
+                });
+                changes.clear();
+            }
+            p.done(result);
+        }
+    }
+}
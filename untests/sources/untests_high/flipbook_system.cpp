@@ -0,0 +1,177 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_high.hpp"
+using namespace e2d;
+
+namespace
+{
+    class safe_starter_initializer final : private noncopyable {
+    public:
+        safe_starter_initializer() {
+            modules::initialize<starter>(0, nullptr,
+                starter::parameters(
+                    engine::parameters("flipbook_system_untests", "enduro2d")));
+        }
+
+        ~safe_starter_initializer() noexcept {
+            modules::shutdown<starter>();
+        }
+    };
+
+    struct flipbook_fixture {
+        vector<sprite_asset::ptr> sprites;
+        flipbook_asset::ptr flipbook_res;
+
+        flipbook_fixture() {
+            vector<flipbook::frame> frames;
+            for ( std::size_t i = 0; i < 3; ++i ) {
+                sprites.push_back(sprite_asset::create(sprite()));
+                frames.push_back({sprites.back()});
+            }
+
+            flipbook::sequence run;
+            run.fps = 10.f;
+            run.name = make_hash("run");
+            run.frames = {0u, 1u, 2u};
+
+            flipbook content;
+            content.set_frames(std::move(frames));
+            content.set_sequences({run});
+            flipbook_res = flipbook_asset::create(std::move(content));
+        }
+    };
+
+    ecs::entity create_player(ecs::registry& owner, const flipbook_player& fp) {
+        ecs::entity e = owner.create_entity();
+        e.assign_component<flipbook_player>(fp);
+        e.assign_component<sprite_renderer>();
+        return e;
+    }
+
+    void update(ecs::registry& owner, f32 dt) {
+        owner.process_event(systems::update_event{dt, 0.f});
+    }
+}
+
+TEST_CASE("flipbook_system") {
+    safe_starter_initializer initializer;
+    const flipbook_fixture fixture;
+
+    ecs::registry owner;
+    ecs::registry_filler(owner)
+        .feature<struct flipbook_feature>(ecs::feature()
+            .add_system<flipbook_system>());
+
+    SECTION("frames") {
+        ecs::entity e = create_player(owner, flipbook_player(fixture.flipbook_res)
+            .play("run")
+            .looped(true));
+
+        update(owner, 0.06f);
+        REQUIRE(math::approximately(e.get_component<flipbook_player>().time(), 0.06f));
+        REQUIRE(e.get_component<sprite_renderer>().sprite() == fixture.sprites[0]);
+
+        update(owner, 0.06f);
+        REQUIRE(math::approximately(e.get_component<flipbook_player>().time(), 0.12f));
+        REQUIRE(e.get_component<sprite_renderer>().sprite() == fixture.sprites[1]);
+
+        // the sprite is not touched while the frame stays the same
+        e.get_component<sprite_renderer>().sprite(nullptr);
+        update(owner, 0.06f);
+        REQUIRE(math::approximately(e.get_component<flipbook_player>().time(), 0.18f));
+        REQUIRE_FALSE(e.get_component<sprite_renderer>().sprite());
+
+        update(owner, 0.1f);
+        REQUIRE(e.get_component<sprite_renderer>().sprite() == fixture.sprites[2]);
+
+        update(owner, 0.1f);
+        REQUIRE(e.get_component<flipbook_player>().playing());
+        REQUIRE(math::approximately(e.get_component<flipbook_player>().time(), 0.08f));
+        REQUIRE(e.get_component<sprite_renderer>().sprite() == fixture.sprites[0]);
+    }
+    SECTION("stop") {
+        ecs::entity e = create_player(owner, flipbook_player(fixture.flipbook_res)
+            .play("run"));
+
+        update(owner, 0.01f);
+        update(owner, 0.5f);
+        REQUIRE(e.get_component<flipbook_player>().stopped());
+        REQUIRE(math::approximately(e.get_component<flipbook_player>().time(), 0.3f));
+        REQUIRE(e.get_component<sprite_renderer>().sprite() == fixture.sprites[2]);
+
+        // stopped players keep their frame
+        e.get_component<sprite_renderer>().sprite(nullptr);
+        update(owner, 0.5f);
+        REQUIRE(math::approximately(e.get_component<flipbook_player>().time(), 0.3f));
+        REQUIRE_FALSE(e.get_component<sprite_renderer>().sprite());
+
+        e.get_component<flipbook_player>().play(0.15f);
+        update(owner, 0.01f);
+        REQUIRE(e.get_component<flipbook_player>().playing());
+        REQUIRE(e.get_component<sprite_renderer>().sprite() == fixture.sprites[1]);
+    }
+    SECTION("changes") {
+        ecs::entity e1 = create_player(owner, flipbook_player(fixture.flipbook_res)
+            .play("run")
+            .looped(true));
+        ecs::entity e2 = create_player(owner, flipbook_player(fixture.flipbook_res)
+            .play("run")
+            .looped(true));
+        update(owner, 0.01f);
+
+        // direct changes are picked up on the next update
+        e1.get_component<flipbook_player>().time(0.25f);
+        e2.destroy();
+        update(owner, 0.01f);
+        REQUIRE(e1.get_component<sprite_renderer>().sprite() == fixture.sprites[2]);
+
+        e1.get_component<flipbook_player>().sequence(make_hash("unknown"));
+        update(owner, 0.01f);
+        REQUIRE_FALSE(e1.get_component<sprite_renderer>().sprite());
+
+        e1.get_component<flipbook_player>().play("run");
+        update(owner, 0.01f);
+        REQUIRE(e1.get_component<sprite_renderer>().sprite() == fixture.sprites[0]);
+
+        // a replaced player starts over
+        e1.assign_component<flipbook_player>(flipbook_player(fixture.flipbook_res)
+            .play("run")
+            .time(0.1f));
+        update(owner, 0.01f);
+        REQUIRE(e1.get_component<sprite_renderer>().sprite() == fixture.sprites[1]);
+    }
+    SECTION("performance") {
+        std::printf("-= flipbook_system::performance tests =-\n");
+    #if defined(E2D_BUILD_MODE) && E2D_BUILD_MODE == E2D_BUILD_MODE_DEBUG
+        const std::size_t player_n = 5'000;
+        const std::size_t frame_n = 100;
+    #else
+        const std::size_t player_n = 50'000;
+        const std::size_t frame_n = 1'000;
+    #endif
+        for ( std::size_t i = 0; i < player_n; ++i ) {
+            create_player(owner, flipbook_player(fixture.flipbook_res)
+                .play("run")
+                .looped(true)
+                .time(0.3f * i / player_n));
+        }
+        {
+            std::size_t result = 0;
+            e2d_untests::verbose_profiler_ms p("animated sprites (60 fps)");
+            for ( std::size_t f = 0; f < frame_n; ++f ) {
+                update(owner, 1.f / 60.f);
+            }
+            owner.for_each_component<sprite_renderer>([&result](
+                const ecs::const_entity&,
+                const sprite_renderer& sr)
+            {
+                result += sr.sprite() ? 1u : 0u;
+            });
+            p.done(result);
+        }
+    }
+}
@@ -25,8 +25,10 @@ namespace
     class fake_asset final : public content_asset<fake_asset, int> {
     public:
         static const char* type_name() noexcept { return "fake_asset"; }
-        static load_async_result load_async(const library& library, str_view address) {
-            E2D_UNUSED(library, address);
+        static load_async_result load_async(
+            const library& library, str_view address, vfs::priority priority)
+        {
+            E2D_UNUSED(library, address, priority);
             return stdex::make_resolved_promise(fake_asset::create(42));
         }
     };
@@ -34,8 +36,10 @@ namespace
     class big_fake_asset final : public content_asset<big_fake_asset, int> {
     public:
         static const char* type_name() noexcept { return "big_fake_asset"; }
-        static load_async_result load_async(const library& library, str_view address) {
-            E2D_UNUSED(library, address);
+        static load_async_result load_async(
+            const library& library, str_view address, vfs::priority priority)
+        {
+            E2D_UNUSED(library, address, priority);
             return the<deferrer>().do_in_worker_thread([](){
                 std::this_thread::sleep_for(std::chrono::milliseconds(10));
                 return big_fake_asset::create(42);
@@ -135,6 +139,21 @@ TEST_CASE("library"){
         auto empty_res = l.load_asset<binary_asset>("empty_asset");
         REQUIRE_FALSE(empty_res);
     }
+    {
+        // captured sizes are the sizes read by the loaders
+        l.start_manifest_capture();
+        auto binary_res = l.load_asset<binary_asset>("binary_asset.bin");
+        REQUIRE(binary_res);
+        const asset_manifest m = l.stop_manifest_capture();
+        REQUIRE(m.size() == 1u);
+        REQUIRE(m.entries()[0].type == binary_asset::type_name());
+        REQUIRE(m.entries()[0].address == "binary_asset.bin");
+        REQUIRE(m.entries()[0].size == binary_res->content().size());
+
+        binary_res.reset();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        REQUIRE(1u == l.unload_unused_assets());
+    }
     {
         auto image_res = l.load_asset<image_asset>("image.png");
         REQUIRE(image_res);
@@ -409,3 +428,60 @@ TEST_CASE("asset_dependencies") {
         }
     }
 }
+
+TEST_CASE("asset_store") {
+    const std::size_t binary_size = sizeof(binary_asset) + 100u;
+    {
+        asset_store s;
+        s.store<binary_asset>(make_hash("a"), binary_asset::create(buffer(100u)));
+        s.store<binary_asset>(make_hash("b"), binary_asset::create(buffer(100u)));
+        s.store<text_asset>(make_hash("c"), text_asset::create("hello"));
+        REQUIRE(s.asset_count() == 3u);
+        REQUIRE(s.memory_usage() >= binary_size * 2u);
+
+        const asset_store::statistics stats = s.stats();
+        REQUIRE(stats.budget == 0u);
+        REQUIRE(stats.caches.size() == 2u);
+        REQUIRE(stats.caches[0].type_name == "binary_asset");
+        REQUIRE(stats.caches[0].assets == 2u);
+        REQUIRE(stats.caches[0].unused_assets == 2u);
+        REQUIRE(stats.caches[0].cpu_bytes == binary_size * 2u);
+        REQUIRE(stats.caches[1].type_name == "text_asset");
+
+        REQUIRE(s.unload_unused_assets() == 3u);
+        REQUIRE(s.memory_usage() == 0u);
+    }
+    {
+        asset_store s;
+        s.memory_budget(binary_size * 2u);
+
+        binary_asset::ptr a = binary_asset::create(buffer(100u));
+        s.store<binary_asset>(make_hash("a"), a);
+        s.store<binary_asset>(make_hash("b"), binary_asset::create(buffer(100u)));
+        s.store<binary_asset>(make_hash("c"), binary_asset::create(buffer(100u)));
+        REQUIRE(s.asset_count() == 3u);
+        REQUIRE(s.trim_to_memory_budget() == 1u);
+        REQUIRE(s.asset_count() == 2u);
+
+        // the referenced asset stays, the least recently used one goes
+        REQUIRE(s.find<binary_asset>(make_hash("a")) == a);
+        REQUIRE_FALSE(s.find<binary_asset>(make_hash("b")));
+        REQUIRE(s.find<binary_asset>(make_hash("c")));
+
+        s.store<binary_asset>(make_hash("d"), binary_asset::create(buffer(100u)));
+        REQUIRE(s.trim_to_memory_budget() == 1u);
+        REQUIRE_FALSE(s.find<binary_asset>(make_hash("c")));
+        REQUIRE(s.find<binary_asset>(make_hash("d")));
+        REQUIRE(s.memory_usage() <= s.memory_budget());
+
+        const asset_store::statistics stats = s.stats();
+        REQUIRE(stats.evictions == 2u);
+        REQUIRE(stats.caches[0].evictions == 2u);
+        REQUIRE(stats.caches[0].misses == 2u);
+
+        a.reset();
+        s.memory_budget(binary_size);
+        REQUIRE(s.asset_count() == 1u);
+        REQUIRE(s.find<binary_asset>(make_hash("d")));
+    }
+}
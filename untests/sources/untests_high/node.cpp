@@ -833,13 +833,13 @@ TEST_CASE("node") {
 
             auto n = node::create(p);
             n->transform(math::make_translation_trs2(v2f{20.f,0.f}));
-            REQUIRE(n->local_matrix() == math::make_translation_matrix4(20.f,0.f));
+            REQUIRE(n->local_matrix() == math::make_translation_matrix3x2(20.f,0.f));
 
             auto v = v4f(5.f,0.f,0.f,1.f);
             REQUIRE(v * n->local_matrix() == v4f{25.f,0.f,0.f,1.f});
 
             n->transform(math::make_scale_trs2(v2f(1.f,2.f)));
-            REQUIRE(n->local_matrix() == math::make_scale_matrix4(1.f,2.f));
+            REQUIRE(n->local_matrix() == math::make_scale_matrix3x2(1.f,2.f));
         }
     }
     SECTION("world_matrix") {
@@ -855,21 +855,21 @@ TEST_CASE("node") {
 
             n->transform(math::make_scale_trs2(v2f(1.f,2.f)));
             REQUIRE(n->world_matrix() ==
-                math::make_scale_matrix4(1.f,2.f) *
-                math::make_translation_matrix4(10.f,0.f));
+                math::make_scale_matrix3x2(1.f,2.f) *
+                math::make_translation_matrix3x2(10.f,0.f));
         }
         {
             auto n = node::create();
             n->translation({20.f,0.f});
             REQUIRE(n->world_matrix() ==
-                math::make_translation_matrix4(20.f,0.f));
+                math::make_translation_matrix3x2(20.f,0.f));
 
             auto p = node::create();
             p->transform(math::make_translation_trs2(v2f{10.f,0.f}));
 
             p->add_child(n);
             REQUIRE(n->world_matrix() ==
-                math::make_translation_matrix4(30.f,0.f));
+                math::make_translation_matrix3x2(30.f,0.f));
         }
         {
             auto p1 = node::create();
@@ -882,14 +882,64 @@ TEST_CASE("node") {
             n->transform(math::make_translation_trs2(v2f{30.f,0.f}));
 
             REQUIRE(n->world_matrix() ==
-                math::make_translation_matrix4(50.f,0.f));
+                math::make_translation_matrix3x2(50.f,0.f));
 
             p1->add_child(p2);
 
             REQUIRE(n->world_matrix() ==
-                math::make_translation_matrix4(60.f,0.f));
+                math::make_translation_matrix3x2(60.f,0.f));
         }
     }
+    SECTION("versions") {
+        auto p = node::create();
+        auto n = node::create(p);
+
+        const u32 w1 = n->world_version();
+        REQUIRE(n->world_version() == w1);
+        REQUIRE_FALSE(n->world_changed_since(w1));
+
+        const u32 l1 = n->local_version();
+        n->translation({10.f,0.f});
+        REQUIRE(n->local_changed_since(l1));
+        REQUIRE(n->world_changed_since(w1));
+
+        const u32 w2 = n->world_version();
+        REQUIRE(n->world_version() == w2);
+
+        const u32 l2 = n->local_version();
+        p->translation({20.f,0.f});
+        REQUIRE_FALSE(n->local_changed_since(l2));
+        REQUIRE(n->world_changed_since(w2));
+
+        const u32 w3 = n->world_version();
+        auto p2 = node::create();
+        p2->add_child(n);
+        REQUIRE(n->world_changed_since(w3));
+    }
+    SECTION("hierarchy_versions") {
+        auto r = node::create();
+        auto p = node::create(r);
+        auto n1 = node::create(p);
+
+        const u32 v1 = versions::current();
+        REQUIRE_FALSE(r->hierarchy_changed_since(v1));
+
+        auto n2 = node::create(p);
+        REQUIRE(p->hierarchy_changed_since(v1));
+        REQUIRE(r->hierarchy_changed_since(v1));
+        REQUIRE_FALSE(n1->hierarchy_changed_since(v1));
+
+        const u32 v2 = versions::current();
+        REQUIRE(p->swap_children(n1, n2));
+        REQUIRE(r->hierarchy_changed_since(v2));
+
+        const u32 v3 = versions::current();
+        n1->translation({1.f,0.f});
+        REQUIRE_FALSE(r->hierarchy_changed_since(v3));
+
+        REQUIRE(n1->remove_from_parent());
+        REQUIRE(r->hierarchy_changed_since(v3));
+    }
     SECTION("lifetime") {
         {
             fake_node::reset_counters();
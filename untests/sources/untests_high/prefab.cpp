@@ -21,6 +21,23 @@ namespace
             modules::shutdown<starter>();
         }
     };
+
+    prefab make_deep_prefab(std::size_t chain_count, std::size_t chain_depth) {
+        prefab root;
+        root.prototype().component<named>(named().name("root"));
+        for ( std::size_t i = 0; i < chain_count; ++i ) {
+            prefab chain;
+            chain.prototype().component<named>(named().name("leaf"));
+            for ( std::size_t j = 1; j < chain_depth; ++j ) {
+                prefab parent;
+                parent.prototype().component<named>(named().name("link"));
+                parent.set_children({std::move(chain)});
+                chain = std::move(parent);
+            }
+            root.children().push_back(std::move(chain));
+        }
+        return root;
+    }
 }
 
 TEST_CASE("prefab"){
@@ -192,3 +209,73 @@ TEST_CASE("prefab"){
         }
     }
 }
+
+TEST_CASE("prefab_plan"){
+    safe_starter_initializer initializer;
+    world& w = the<world>();
+    {
+        prefab p = make_deep_prefab(2u, 3u);
+        REQUIRE_FALSE(p.plan());
+
+        p.compile_plan();
+        REQUIRE(p.plan());
+        REQUIRE(p.plan()->size() == 7u);
+        REQUIRE(p.plan()->parent(0u) == prefab_plan::no_parent);
+        REQUIRE(p.plan()->parent(1u) == 0u);
+        REQUIRE(p.plan()->parent(2u) == 1u);
+        REQUIRE(p.plan()->parent(3u) == 2u);
+        REQUIRE(p.plan()->parent(4u) == 0u);
+
+        const prefab copy = p;
+        REQUIRE(copy.plan() == p.plan());
+
+        p.children();
+        REQUIRE_FALSE(p.plan());
+        p.compile_plan();
+
+        gobject go = w.instantiate(p);
+        DEFER([&w, go](){ w.destroy_instance(go); });
+
+        REQUIRE(go.component<named>()->name() == "root");
+        const node_iptr root_n = go.component<actor>()->node();
+        REQUIRE(root_n->child_count() == 2u);
+        REQUIRE(root_n->child_count_recursive() == 6u);
+
+        const node_iptr leaf_n = root_n->last_child()->first_child()->first_child();
+        REQUIRE(leaf_n->owner().component<named>()->name() == "leaf");
+        REQUIRE(leaf_n->root() == root_n);
+    }
+    SECTION("performance") {
+        std::printf("-= prefab_plan::performance tests =-\n");
+    #if defined(E2D_BUILD_MODE) && E2D_BUILD_MODE == E2D_BUILD_MODE_DEBUG
+        const std::size_t copy_n = 100;
+    #else
+        const std::size_t copy_n = 1'000;
+    #endif
+        const prefab recursive = make_deep_prefab(10u, 20u);
+        const prefab compiled = prefab(recursive).compile_plan();
+
+        const auto instantiate_copies = [&w, copy_n](const prefab& p){
+            vector<gobject> instances;
+            instances.reserve(copy_n);
+            for ( std::size_t i = 0; i < copy_n; ++i ) {
+                instances.push_back(w.instantiate(p));
+            }
+            std::size_t result = 0;
+            for ( gobject& inst : instances ) {
+                result += inst.component<actor>()->node()->child_count();
+                w.destroy_instance(inst);
+            }
+            w.finalize_instances();
+            return result;
+        };
+        {
+            e2d_untests::verbose_profiler_ms p("recursive instantiate (201 nodes)");
+            p.done(instantiate_copies(recursive));
+        }
+        {
+            e2d_untests::verbose_profiler_ms p("planned instantiate (201 nodes)");
+            p.done(instantiate_copies(compiled));
+        }
+    }
+}
@@ -0,0 +1,177 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_high.hpp"
+using namespace e2d;
+
+namespace
+{
+    struct bullet {
+        i32 damage{0};
+    };
+
+    struct burning {};
+
+    class safe_starter_initializer final : private noncopyable {
+    public:
+        safe_starter_initializer() {
+            modules::initialize<starter>(0, nullptr,
+                starter::parameters(
+                    engine::parameters("prefab_pool_untests", "enduro2d")));
+        }
+
+        ~safe_starter_initializer() noexcept {
+            modules::shutdown<starter>();
+        }
+    };
+
+    prefab make_bullet_prefab() {
+        prefab child;
+        child.prototype().component<named>(named().name("trail"));
+
+        prefab root;
+        root.prototype()
+            .component<named>(named().name("bullet"))
+            .component<bullet>(bullet{10});
+        root.set_children({child});
+        root.compile_plan();
+        return root;
+    }
+}
+
+TEST_CASE("prefab_pool") {
+    safe_starter_initializer initializer;
+    world& w = the<world>();
+
+    SECTION("warmup/acquire/release") {
+        const prefab bullet_prefab = make_bullet_prefab();
+        prefab_pool& pool = w.pool(bullet_prefab);
+        REQUIRE(&pool == &w.pool(prefab(bullet_prefab)));
+
+        pool.warmup(2u);
+        REQUIRE(pool.stats().idle == 2u);
+        REQUIRE(pool.stats().created == 2u);
+
+        gobject parent = w.instantiate();
+        DEFER([&w, parent](){ w.destroy_instance(parent); });
+        const node_iptr parent_n = parent.component<actor>()->node();
+
+        gobject go = pool.acquire(parent_n, math::make_translation_trs2(v2f(1.f, 2.f)));
+        REQUIRE(pool.owns(go));
+        REQUIRE(pool.stats().idle == 1u);
+        REQUIRE(pool.stats().active == 1u);
+        REQUIRE(pool.stats().misses == 0u);
+
+        const node_iptr go_n = go.component<actor>()->node();
+        REQUIRE(go_n->parent() == parent_n);
+        REQUIRE(go_n->translation() == v2f(1.f, 2.f));
+        REQUIRE_FALSE(go.component<disabled<actor>>().exists());
+        REQUIRE_FALSE(go_n->first_child()->owner().component<disabled<actor>>().exists());
+
+        go.component<bullet>()->damage = 42;
+        go.component<named>()->name("hit");
+
+        pool.release(go);
+        REQUIRE_FALSE(pool.owns(go));
+        REQUIRE(go.alive());
+        REQUIRE(pool.stats().idle == 2u);
+        REQUIRE(pool.stats().active == 0u);
+        REQUIRE_FALSE(parent_n->has_children());
+        REQUIRE(go.component<disabled<actor>>().exists());
+        REQUIRE(go.component<bullet>()->damage == 10);
+        REQUIRE(go.component<named>()->name() == "bullet");
+        REQUIRE(go_n->translation() == v2f::zero());
+
+        gobject go2 = pool.acquire();
+        REQUIRE(go2 == go);
+        REQUIRE(go2.component<actor>()->node() == go_n);
+        REQUIRE(pool.stats().created == 2u);
+        pool.release(go2);
+    }
+    SECTION("runtime_components") {
+        const prefab bullet_prefab = make_bullet_prefab();
+        prefab_pool& pool = w.pool(bullet_prefab);
+
+        gobject go = pool.acquire();
+        gobject trail = go.component<actor>()->node()->first_child()->owner();
+        go.component<burning>().assign();
+        trail.component<burning>().assign();
+        go.component<bullet>().remove();
+
+        pool.release(go);
+        REQUIRE(pool.stats().idle == 1u);
+
+        gobject go2 = pool.acquire();
+        REQUIRE(go2 == go);
+        REQUIRE_FALSE(go2.component<burning>().exists());
+        REQUIRE_FALSE(trail.component<burning>().exists());
+        REQUIRE(go2.component<bullet>()->damage == 10);
+        REQUIRE(trail.component<named>()->name() == "trail");
+        REQUIRE(go2.component<actor>()->node()->first_child()->owner() == trail);
+        pool.release(go2);
+    }
+    SECTION("changed_hierarchy") {
+        const prefab bullet_prefab = make_bullet_prefab();
+        prefab_pool& pool = w.pool(bullet_prefab);
+
+        gobject go = pool.acquire();
+        REQUIRE(pool.stats().misses == 1u);
+
+        go.component<actor>()->node()->first_child()->remove_from_parent();
+        pool.release(go);
+        REQUIRE(pool.stats().idle == 0u);
+        REQUIRE(pool.stats().discarded == 1u);
+        REQUIRE_FALSE(go.alive());
+    }
+    SECTION("bad_prefab") {
+        REQUIRE_THROWS_AS(w.pool(prefab()), bad_world_operation);
+    }
+    SECTION("performance") {
+        std::printf("-= prefab_pool::performance tests =-\n");
+    #if defined(E2D_BUILD_MODE) && E2D_BUILD_MODE == E2D_BUILD_MODE_DEBUG
+        const std::size_t frame_n = 100;
+    #else
+        const std::size_t frame_n = 1'000;
+    #endif
+        const std::size_t spawn_n = 100;
+        const prefab bullet_prefab = make_bullet_prefab();
+        vector<gobject> spawned;
+        spawned.reserve(spawn_n);
+        {
+            std::size_t result = 0;
+            e2d_untests::verbose_profiler_ms p("instantiate/destroy");
+            for ( std::size_t f = 0; f < frame_n; ++f ) {
+                for ( std::size_t i = 0; i < spawn_n; ++i ) {
+                    spawned.push_back(w.instantiate(bullet_prefab));
+                }
+                for ( gobject& go : spawned ) {
+                    result += go.component<actor>()->node()->child_count();
+                    w.destroy_instance(go);
+                }
+                spawned.clear();
+                w.finalize_instances();
+            }
+            p.done(result);
+        }
+        {
+            prefab_pool& pool = w.pool(bullet_prefab).warmup(spawn_n);
+            std::size_t result = 0;
+            e2d_untests::verbose_profiler_ms p("pool acquire/release");
+            for ( std::size_t f = 0; f < frame_n; ++f ) {
+                for ( std::size_t i = 0; i < spawn_n; ++i ) {
+                    spawned.push_back(pool.acquire());
+                }
+                for ( gobject& go : spawned ) {
+                    result += go.component<actor>()->node()->child_count();
+                    pool.release(go);
+                }
+                spawned.clear();
+                w.finalize_instances();
+            }
+            p.done(result);
+        }
+    }
+}
@@ -0,0 +1,199 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_high.hpp"
+using namespace e2d;
+
+namespace
+{
+    struct position {};
+    struct velocity {};
+    struct health {};
+
+    struct test_event {
+        vector<str>* log{nullptr};
+        std::atomic<u32>* counter{nullptr};
+    };
+
+    class logging_system final {
+    public:
+        logging_system(str name)
+        : name_(std::move(name)) {}
+
+        void process(ecs::registry& owner, const test_event& event) {
+            E2D_UNUSED(owner);
+            if ( event.log ) {
+                event.log->push_back(name_);
+            }
+            if ( event.counter ) {
+                ++*event.counter;
+            }
+        }
+    private:
+        str name_;
+    };
+
+    class thread_checking_system final {
+    public:
+        thread_checking_system(std::thread::id expected, std::atomic<u32>& misplaced)
+        : expected_(expected)
+        , misplaced_(misplaced) {}
+
+        void process(ecs::registry& owner, const test_event& event) {
+            E2D_UNUSED(owner);
+            if ( std::this_thread::get_id() != expected_ ) {
+                ++misplaced_;
+            }
+            if ( event.counter ) {
+                ++*event.counter;
+            }
+        }
+    private:
+        std::thread::id expected_;
+        std::atomic<u32>& misplaced_;
+    };
+
+    class velocity_writer_system final {
+    public:
+        velocity_writer_system(gobject go)
+        : go_(std::move(go)) {}
+
+        void process(ecs::registry& owner, const test_event& event) {
+            E2D_UNUSED(owner, event);
+            gcomponent<velocity>(go_).ensure();
+        }
+    private:
+        gobject go_;
+    };
+
+    class safe_starter_initializer final : private noncopyable {
+    public:
+        safe_starter_initializer() {
+            modules::initialize<starter>(0, nullptr,
+                starter::parameters(
+                    engine::parameters("system_scheduler_untests", "enduro2d")));
+        }
+
+        ~safe_starter_initializer() noexcept {
+            modules::shutdown<starter>();
+        }
+    };
+}
+
+TEST_CASE("system_scheduler") {
+    SECTION("system_access") {
+        const auto a = system_access().reads<position>().writes<velocity>();
+        REQUIRE(a.can_read(utils::type_family<position>::id()));
+        REQUIRE(a.can_read(utils::type_family<velocity>::id()));
+        REQUIRE(a.can_write(utils::type_family<velocity>::id()));
+        REQUIRE_FALSE(a.can_write(utils::type_family<position>::id()));
+        REQUIRE_FALSE(a.can_read(utils::type_family<health>::id()));
+
+        REQUIRE_FALSE(a.conflicts_with(system_access().reads<position>()));
+        REQUIRE(a.conflicts_with(system_access().reads<velocity>()));
+        REQUIRE(a.conflicts_with(system_access().writes<position>()));
+        REQUIRE_FALSE(a.conflicts_with(system_access().writes<health>()));
+        REQUIRE(a.conflicts_with(system_access().exclusive(true)));
+    }
+    SECTION("serial_order") {
+        ecs::registry owner;
+        system_scheduler s;
+        s.parallel(false)
+            .add_system<test_event, logging_system>("c", system_access().phase(1), "c")
+            .add_system<test_event, logging_system>("a", system_access().writes<position>(), "a")
+            .add_system<test_event, logging_system>("b", system_access().reads<position>(), "b");
+
+        vector<str> log;
+        s.process_event(owner, test_event{&log, nullptr});
+        REQUIRE(log == vector<str>{"a", "b", "c"});
+
+        const auto timings = s.timings();
+        REQUIRE(timings.size() == 3u);
+        REQUIRE(timings[0].name == "c");
+        REQUIRE(timings[0].runs == 1u);
+        REQUIRE_FALSE(s.timing_report().empty());
+    }
+    SECTION("parallel") {
+        safe_starter_initializer initializer;
+        world& w = the<world>();
+
+        system_scheduler s;
+        for ( std::size_t i = 0; i < 16; ++i ) {
+            s.add_system<test_event, logging_system>(
+                strings::rformat("s%0", i),
+                system_access().main_thread(i % 4 == 0),
+                "");
+        }
+
+        std::atomic<u32> counter{0u};
+        for ( std::size_t i = 0; i < 10; ++i ) {
+            s.process_event(w.registry(), test_event{nullptr, &counter});
+        }
+        REQUIRE(counter == 160u);
+    }
+    SECTION("main_thread") {
+        safe_starter_initializer initializer;
+        world& w = the<world>();
+
+        std::atomic<u32> misplaced{0u};
+        system_scheduler s;
+        for ( std::size_t i = 0; i < 8; ++i ) {
+            s.add_system<test_event, logging_system>(
+                strings::rformat("w%0", i),
+                system_access(),
+                "");
+            s.add_system<test_event, thread_checking_system>(
+                strings::rformat("m%0", i),
+                system_access().main_thread(true),
+                std::this_thread::get_id(),
+                misplaced);
+        }
+
+        std::atomic<u32> counter{0u};
+        for ( std::size_t i = 0; i < 10; ++i ) {
+            s.process_event(w.registry(), test_event{nullptr, &counter});
+        }
+        REQUIRE(counter == 160u);
+        REQUIRE(misplaced == 0u);
+    }
+    SECTION("worker_threads") {
+        ecs::registry owner;
+        std::atomic<u32> off_main{0u};
+        system_scheduler s;
+        s.worker_threads(2u);
+        REQUIRE(s.worker_threads() == 2u);
+        for ( std::size_t i = 0; i < 4; ++i ) {
+            s.add_system<test_event, thread_checking_system>(
+                strings::rformat("w%0", i),
+                system_access(),
+                std::this_thread::get_id(),
+                off_main);
+        }
+
+        // no deferrer is needed, the systems run on the scheduler threads
+        std::atomic<u32> counter{0u};
+        s.process_event(owner, test_event{nullptr, &counter});
+        REQUIRE(counter == 4u);
+        REQUIRE(off_main == 4u);
+    }
+    SECTION("check_access") {
+        safe_starter_initializer initializer;
+        world& w = the<world>();
+
+        gobject go = w.instantiate();
+        DEFER([&w, go](){ w.destroy_instance(go); });
+
+        system_scheduler s;
+        s.check_access(true)
+            .add_system<test_event, velocity_writer_system>("declared", system_access()
+                .writes<velocity>(), go)
+            .add_system<test_event, velocity_writer_system>("undeclared", system_access()
+                .reads<velocity>(), go);
+
+        s.process_event(w.registry(), test_event{});
+        REQUIRE(s.access_violations() == 1u);
+    }
+}
@@ -0,0 +1,178 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_high.hpp"
+using namespace e2d;
+
+namespace
+{
+    vector<node_iptr> make_animated_nodes(
+        const std::shared_ptr<transform_hierarchy>& transforms,
+        std::size_t root_n,
+        std::size_t child_n)
+    {
+        const auto allocator = node::create_allocator(1024u);
+        vector<node_iptr> nodes;
+        nodes.reserve(root_n * (child_n + 1u));
+        for ( std::size_t i = 0; i < root_n; ++i ) {
+            node_iptr root = node::create(allocator, transforms, gobject());
+            nodes.push_back(root);
+            for ( std::size_t j = 0; j < child_n; ++j ) {
+                node_iptr child = node::create(allocator, transforms, gobject());
+                root->add_child(child);
+                nodes.push_back(child);
+            }
+        }
+        return nodes;
+    }
+
+    f32 animate_nodes(const vector<node_iptr>& nodes, std::size_t frame) {
+        for ( const node_iptr& n : nodes ) {
+            n->rotation(math::numeric_cast<f32>(frame));
+        }
+        f32 result = 0.f;
+        for ( const node_iptr& n : nodes ) {
+            result += n->world_matrix()[2][0];
+        }
+        return result;
+    }
+}
+
+TEST_CASE("transform_hierarchy") {
+    SECTION("create/destroy") {
+        transform_hierarchy th;
+        REQUIRE(th.empty());
+
+        const auto p = th.create();
+        const auto n = th.create(p);
+        REQUIRE(th.size() == 2u);
+        REQUIRE(th.valid(p));
+        REQUIRE(th.valid(n));
+        REQUIRE(th.parent(n) == p);
+        REQUIRE(th.parent(p) == transform_hierarchy::invalid_handle);
+
+        th.destroy(p);
+        REQUIRE_FALSE(th.valid(p));
+        REQUIRE(th.size() == 1u);
+
+        th.update();
+        REQUIRE(th.valid(n));
+        REQUIRE(th.parent(n) == transform_hierarchy::invalid_handle);
+    }
+    SECTION("world_matrix") {
+        transform_hierarchy th;
+
+        const auto p1 = th.create(math::make_translation_trs2(v2f{10.f,0.f}));
+        const auto p2 = th.create(math::make_translation_trs2(v2f{20.f,0.f}));
+        const auto n = th.create(p2, math::make_translation_trs2(v2f{30.f,0.f}));
+
+        REQUIRE(th.world_matrix(n) == math::make_translation_matrix3x2(50.f,0.f));
+        const u32 version = th.world_version(n);
+
+        th.transform(p1, math::make_translation_trs2(v2f{15.f,0.f}));
+        REQUIRE(th.world_version(n) == version);
+
+        th.parent(p2, p1);
+        REQUIRE(th.world_matrix(n) == math::make_translation_matrix3x2(65.f,0.f));
+        REQUIRE(th.world_version(n) != version);
+
+        th.parent(p1, n);
+        REQUIRE(th.parent(p1) == transform_hierarchy::invalid_handle);
+
+        th.parent(n, transform_hierarchy::invalid_handle);
+        REQUIRE(th.world_matrix(n) == math::make_translation_matrix3x2(30.f,0.f));
+    }
+    SECTION("nodes") {
+        const auto transforms = std::make_shared<transform_hierarchy>();
+        const auto allocator = node::create_allocator(16u);
+
+        node_iptr p = node::create(allocator, transforms, gobject());
+        node_iptr n = node::create(allocator, transforms, gobject());
+        REQUIRE(transforms->size() == 2u);
+
+        p->translation(v2f{10.f,0.f});
+        n->translation(v2f{20.f,0.f});
+        p->add_child(n);
+        REQUIRE(n->world_matrix() == math::make_translation_matrix3x2(30.f,0.f));
+
+        const u32 version = n->world_version();
+        p->translation(v2f{15.f,0.f});
+        REQUIRE(n->world_changed_since(version));
+        REQUIRE(n->world_matrix() == math::make_translation_matrix3x2(35.f,0.f));
+        REQUIRE(n->local_matrix() == math::make_translation_matrix3x2(20.f,0.f));
+
+        // children follow the storage of their parent
+        node_iptr lazy_p = node::create(math::make_translation_trs2(v2f{5.f,0.f}));
+        lazy_p->add_child(p);
+        REQUIRE_FALSE(p->transforms());
+        REQUIRE_FALSE(n->transforms());
+        REQUIRE(transforms->size() == 0u);
+        REQUIRE(n->world_matrix() == math::make_translation_matrix3x2(40.f,0.f));
+
+        node_iptr flat_p = node::create(allocator, transforms, gobject());
+        flat_p->translation(v2f{1.f,0.f});
+        flat_p->add_child(p);
+        REQUIRE(p->transforms() == transforms);
+        REQUIRE(n->transforms() == transforms);
+        REQUIRE(transforms->size() == 3u);
+        REQUIRE(n->world_matrix() == math::make_translation_matrix3x2(36.f,0.f));
+
+        p->remove_from_parent();
+        REQUIRE(p->transforms() == transforms);
+        REQUIRE(n->world_matrix() == math::make_translation_matrix3x2(35.f,0.f));
+
+        p->remove_all_children();
+        n.reset();
+        REQUIRE(transforms->size() == 2u);
+    }
+    SECTION("performance") {
+        std::printf("-= transform_hierarchy::performance tests =-\n");
+    #if defined(E2D_BUILD_MODE) && E2D_BUILD_MODE == E2D_BUILD_MODE_DEBUG
+        const std::size_t root_n = 100;
+        const std::size_t frame_n = 10;
+    #else
+        const std::size_t root_n = 1'000;
+        const std::size_t frame_n = 100;
+    #endif
+        const std::size_t child_n = 99;
+        {
+            const vector<node_iptr> nodes = make_animated_nodes(nullptr, root_n, child_n);
+            f32 result = 0.f;
+            e2d_untests::verbose_profiler_ms p("lazy nodes (pointer chasing)");
+            for ( std::size_t f = 0; f < frame_n; ++f ) {
+                result += animate_nodes(nodes, f);
+            }
+            p.done(result);
+        }
+        {
+            const auto transforms = std::make_shared<transform_hierarchy>();
+            const vector<node_iptr> nodes = make_animated_nodes(transforms, root_n, child_n);
+            f32 result = 0.f;
+            e2d_untests::verbose_profiler_ms p("flat nodes (linear pass)");
+            for ( std::size_t f = 0; f < frame_n; ++f ) {
+                result += animate_nodes(nodes, f);
+            }
+            p.done(result);
+        }
+        {
+            stdex::jobber worker(math::max(2u, std::thread::hardware_concurrency()) - 1u);
+            const auto transforms = std::make_shared<transform_hierarchy>();
+            const vector<node_iptr> nodes = make_animated_nodes(transforms, root_n, child_n);
+            f32 result = 0.f;
+            e2d_untests::verbose_profiler_ms p("flat nodes (jobber pass)");
+            for ( std::size_t f = 0; f < frame_n; ++f ) {
+                for ( const node_iptr& n : nodes ) {
+                    n->rotation(math::numeric_cast<f32>(f));
+                }
+                transforms->update(worker);
+                for ( const node_iptr& n : nodes ) {
+                    result += n->world_matrix()[2][0];
+                }
+            }
+            p.done(result);
+        }
+    }
+}
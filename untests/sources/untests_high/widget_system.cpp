@@ -0,0 +1,113 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_high.hpp"
+using namespace e2d;
+
+namespace
+{
+    class safe_starter_initializer final : private noncopyable {
+    public:
+        safe_starter_initializer() {
+            modules::initialize<starter>(0, nullptr,
+                starter::parameters(
+                    engine::parameters("widget_system_untests", "enduro2d")));
+        }
+
+        ~safe_starter_initializer() noexcept {
+            modules::shutdown<starter>();
+        }
+    };
+
+    prefab make_widget_prefab() {
+        prefab p;
+        p.prototype()
+            .component<widget>(widget().size(v2f(10.f, 20.f)))
+            .component<layout>(layout());
+        return p;
+    }
+
+    void update(ecs::registry& owner) {
+        owner.process_event(systems::update_event{0.f, 0.f});
+    }
+}
+
+TEST_CASE("widget_system") {
+    safe_starter_initializer initializer;
+    world& w = the<world>();
+
+    ecs::registry_filler(w.registry())
+        .feature<struct widget_feature>(ecs::feature()
+            .add_system<widget_system>());
+
+    SECTION("changes") {
+        gobject go = w.instantiate(make_widget_prefab());
+        DEFER([&w, go](){ w.destroy_instance(go); });
+
+        gcomponent<widget> go_w{go};
+        gcomponent<layout> go_l{go};
+
+        // new instances are built without a prefab tag
+        REQUIRE(widgets::is_dirty(go_w));
+        REQUIRE_FALSE(go.component<widget::dirty>().exists());
+
+        update(w.registry());
+        REQUIRE_FALSE(widgets::is_dirty(go_w));
+        REQUIRE(layouts::is_dirty(go_l));
+        w.changes<layout::dirty>().clear();
+
+        // the helpers mark the change set, no tag component is added
+        widgets::change_size(go_w, v2f(30.f, 40.f));
+        REQUIRE(widgets::is_dirty(go_w));
+        REQUIRE_FALSE(go.component<widget::dirty>().exists());
+
+        widgets::unmark_dirty(go_w);
+        REQUIRE_FALSE(widgets::is_dirty(go_w));
+        update(w.registry());
+        REQUIRE_FALSE(layouts::is_dirty(go_l));
+
+        widgets::mark_dirty(go_w);
+        update(w.registry());
+        REQUIRE_FALSE(widgets::is_dirty(go_w));
+        REQUIRE(layouts::is_dirty(go_l));
+    }
+    SECTION("performance") {
+        std::printf("-= widget_system::performance tests =-\n");
+    #if defined(E2D_BUILD_MODE) && E2D_BUILD_MODE == E2D_BUILD_MODE_DEBUG
+        const std::size_t widget_n = 5'000;
+        const std::size_t frame_n = 100;
+    #else
+        const std::size_t widget_n = 50'000;
+        const std::size_t frame_n = 1'000;
+    #endif
+        const prefab widget_prefab = make_widget_prefab();
+
+        vector<gcomponent<widget>> instances;
+        instances.reserve(widget_n);
+        for ( std::size_t i = 0; i < widget_n; ++i ) {
+            instances.emplace_back(w.instantiate(widget_prefab));
+        }
+        DEFER([&w, &instances](){
+            for ( const gcomponent<widget>& go_w : instances ) {
+                w.destroy_instance(go_w.owner());
+            }
+        });
+        update(w.registry());
+        {
+            std::size_t result = 0;
+            e2d_untests::verbose_profiler_ms p("change helpers (1% dirty)");
+            for ( std::size_t f = 0; f < frame_n; ++f ) {
+                for ( std::size_t i = f % 100; i < widget_n; i += 100 ) {
+                    widgets::change_size(instances[i], v2f(math::numeric_cast<f32>(f), math::numeric_cast<f32>(i)));
+                }
+                update(w.registry());
+                result += w.changes<layout::dirty>().size();
+                w.changes<layout::dirty>().clear();
+            }
+            p.done(result);
+        }
+    }
+}
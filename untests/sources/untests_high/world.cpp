@@ -9,6 +9,10 @@ using namespace e2d;
 
 namespace
 {
+    struct versioned_component {
+        i32 value{0};
+    };
+
     class safe_starter_initializer final : private noncopyable {
     public:
         safe_starter_initializer() {
@@ -34,4 +38,195 @@ TEST_CASE("world") {
         w.registry().destroy_entity(e);
         REQUIRE_FALSE(cw.registry().valid_entity(e));
     }
+    SECTION("gcomponent_versions") {
+        gobject go = w.instantiate();
+        DEFER([&w, go](){ w.destroy_instance(go); });
+
+        const u32 v1 = versions::current();
+        REQUIRE_FALSE(gcomponent<versioned_component>::changed_since(v1));
+
+        gcomponent<versioned_component> c(go);
+        c.assign();
+        REQUIRE(gcomponent<versioned_component>::changed_since(v1));
+
+        const u32 v2 = versions::current();
+        const_gcomponent<versioned_component> cc(c);
+        REQUIRE(cc->value == 0);
+        REQUIRE_FALSE(const_gcomponent<versioned_component>::changed_since(v2));
+
+        c->value = 42;
+        REQUIRE(c.get().value == 42);
+        REQUIRE_FALSE(const_gcomponent<versioned_component>::changed_since(v2));
+
+        gcomponent<versioned_component>::mark_changed();
+        REQUIRE(const_gcomponent<versioned_component>::changed_since(v2));
+
+        const u32 v3 = versions::current();
+        REQUIRE(c.remove());
+        REQUIRE(gcomponent<versioned_component>::changed_since(v3));
+    }
+    SECTION("allocation_stats") {
+        const std::size_t live_states = cw.state_allocator()->stats().live_blocks;
+        const std::size_t live_nodes = cw.node_allocator()->stats().live_blocks;
+        {
+            gobject go = w.instantiate();
+            REQUIRE(cw.state_allocator()->stats().live_blocks == live_states + 1u);
+            REQUIRE(cw.node_allocator()->stats().live_blocks == live_nodes + 1u);
+            w.destroy_instance(go);
+            w.finalize_instances();
+        }
+        REQUIRE(cw.state_allocator()->stats().live_blocks == live_states);
+        REQUIRE(cw.node_allocator()->stats().live_blocks == live_nodes);
+    }
+    SECTION("flat_transforms") {
+        REQUIRE_FALSE(cw.flat_transforms());
+        w.flat_transforms(true);
+        DEFER([&w](){ w.flat_transforms(false); });
+
+        gobject p = w.instantiate(math::make_translation_trs2(v2f{10.f,0.f}));
+        DEFER([&w, p](){ w.destroy_instance(p); });
+
+        const node_iptr p_n = p.component<actor>()->node();
+        gobject c = w.instantiate(p_n, math::make_translation_trs2(v2f{20.f,0.f}));
+        const node_iptr c_n = c.component<actor>()->node();
+
+        REQUIRE(p_n->transforms() == cw.transforms());
+        REQUIRE(c_n->transforms() == cw.transforms());
+        REQUIRE(c_n->world_matrix() == math::make_translation_matrix3x2(30.f,0.f));
+
+        p_n->translation(v2f{15.f,0.f});
+        REQUIRE(c_n->world_matrix() == math::make_translation_matrix3x2(35.f,0.f));
+    }
+    SECTION("instantiate_async") {
+        prefab child;
+        child.prototype().component<named>(named().name("child"));
+        prefab root;
+        root.prototype().component<named>(named().name("root"));
+        root.set_children({child, child});
+
+        gobject parent = w.instantiate();
+        DEFER([&w, parent](){ w.destroy_instance(parent); });
+        const node_iptr parent_n = parent.component<actor>()->node();
+
+        // zero budget, one node per step
+        auto p = w.instantiate_async(root, parent_n, 0u);
+        REQUIRE(w.async_stats().pending_instances == 1u);
+        REQUIRE(w.async_stats().pending_nodes == 3u);
+
+        const auto zero_us = time::to_chrono(make_microseconds(0));
+
+        w.process_async_instances();
+        REQUIRE(w.async_stats().last_step_nodes == 1u);
+        REQUIRE(w.async_stats().pending_nodes == 2u);
+        REQUIRE(p.wait_for(zero_us) == stdex::promise_wait_status::timeout);
+        REQUIRE_FALSE(parent_n->has_children());
+
+        w.process_async_instances();
+        w.process_async_instances();
+        REQUIRE(w.async_stats().pending_instances == 0u);
+        REQUIRE(w.async_stats().pending_nodes == 0u);
+        REQUIRE(p.wait_for(zero_us) == stdex::promise_wait_status::no_timeout);
+
+        gobject go = p.get();
+        REQUIRE(go.component<named>()->name() == "root");
+        REQUIRE_FALSE(go.component<disabled<actor>>().exists());
+
+        const node_iptr go_n = go.component<actor>()->node();
+        REQUIRE(go_n->parent() == parent_n);
+        REQUIRE(go_n->child_count() == 2u);
+        REQUIRE_FALSE(go_n->first_child()->owner().component<disabled<actor>>().exists());
+    }
+    SECTION("instantiate_async_chain") {
+        prefab root;
+        root.prototype().component<named>(named().name("root"));
+
+        // handlers run after the step and can start new instances
+        stdex::promise<gobject> p2;
+        auto p1 = w.instantiate_async(root, nullptr, 0u)
+        .then([&w, &root, &p2](const gobject& go){
+            p2 = w.instantiate_async(root, nullptr, 0u);
+            return go;
+        });
+
+        w.process_async_instances();
+        REQUIRE(p1.get());
+        REQUIRE(w.async_stats().pending_instances == 1u);
+
+        w.process_async_instances();
+        REQUIRE(p2.get());
+        REQUIRE(w.async_stats().pending_instances == 0u);
+
+        w.destroy_instance(p1.get());
+        w.destroy_instance(p2.get());
+    }
+    SECTION("instantiate_async_budget") {
+        prefab root;
+        for ( std::size_t i = 0; i < 10u; ++i ) {
+            root.children().emplace_back();
+        }
+
+        w.async_budget_us(time::second_us<u64>().value);
+        REQUIRE(w.async_budget_us() == time::second_us<u64>().value);
+
+        auto p = w.instantiate_async(root);
+        w.process_async_instances();
+        REQUIRE(w.async_stats().last_step_nodes == 11u);
+        REQUIRE(w.async_stats().pending_instances == 0u);
+
+        gobject go = p.get();
+        DEFER([&w, go](){ w.destroy_instance(go); });
+        REQUIRE(go.component<actor>()->node()->child_count() == 10u);
+    }
+    SECTION("performance") {
+        std::printf("-= world::performance tests =-\n");
+    #if defined(E2D_BUILD_MODE) && E2D_BUILD_MODE == E2D_BUILD_MODE_DEBUG
+        const std::size_t frame_n = 10;
+    #else
+        const std::size_t frame_n = 100;
+    #endif
+        const std::size_t instance_n = 1'000;
+        {
+            vector<gobject> instances;
+            instances.reserve(instance_n);
+            std::size_t result = 0;
+            e2d_untests::verbose_profiler_ms p("instantiate/destroy churn");
+            for ( std::size_t f = 0; f < frame_n; ++f ) {
+                for ( std::size_t i = 0; i < instance_n; ++i ) {
+                    instances.push_back(w.instantiate());
+                }
+                for ( gobject& inst : instances ) {
+                    w.destroy_instance(inst);
+                }
+                instances.clear();
+                w.finalize_instances();
+                result += cw.state_allocator()->stats().peak_blocks;
+            }
+            p.done(result);
+        }
+        const pool_allocator::statistics state_stats = cw.state_allocator()->stats();
+        const pool_allocator::statistics node_stats = cw.node_allocator()->stats();
+        std::printf(
+            "gobject states: allocations %zu, peak %zu, chunks %zu\n"
+            "nodes: allocations %zu, peak %zu, chunks %zu\n",
+            state_stats.allocations, state_stats.peak_blocks, state_stats.chunks,
+            node_stats.allocations, node_stats.peak_blocks, node_stats.chunks);
+    }
+}
+
+TEST_CASE("world_state_lifetime") {
+    gobject go;
+    std::weak_ptr<pool_allocator> allocator;
+    std::weak_ptr<pool_allocator> node_allocator;
+    {
+        safe_starter_initializer initializer;
+        go = the<world>().instantiate();
+        allocator = the<world>().state_allocator();
+        node_allocator = the<world>().node_allocator();
+    }
+    // instance nodes are released with the world components
+    REQUIRE(node_allocator.expired());
+    // the held state keeps the pool alive past the world
+    REQUIRE_FALSE(allocator.expired());
+    go = gobject();
+    REQUIRE(allocator.expired());
 }
@@ -0,0 +1,67 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_math.hpp"
+using namespace e2d;
+
+TEST_CASE("mat3x2") {
+    {
+        auto m = m3x2i::identity();
+        REQUIRE(m.rows[0] == v2i(1,0));
+        REQUIRE(m.rows[1] == v2i(0,1));
+        REQUIRE(m.rows[2] == v2i(0,0));
+        REQUIRE((m.data()[0] == 1 && m.data()[3] == 1));
+        m[2] = v2i(3,4);
+        REQUIRE((m.data()[4] == 3 && m.data()[5] == 4));
+        REQUIRE(m3x2i::zero() == m3x2i(0,0,0,0,0,0));
+        REQUIRE(m3x2f(m3x2f::identity()) == m3x2f::identity());
+    }
+    {
+        const auto t = math::make_translation_matrix3x2(10.f, 20.f);
+        const auto s = math::make_scale_matrix3x2(2.f, 3.f);
+        REQUIRE(v2f(1.f,1.f) * t == v2f(11.f,21.f));
+        REQUIRE(v2f(1.f,1.f) * s == v2f(2.f,3.f));
+        REQUIRE(v2f(1.f,1.f) * (s * t) == v2f(12.f,23.f));
+        REQUIRE(v2f(1.f,1.f) * (t * s) == v2f(22.f,63.f));
+        REQUIRE(math::transform_vector(s * t, v2f(1.f,1.f)) == v2f(2.f,3.f));
+        REQUIRE(math::transform_point(s * t, v2f(1.f,1.f)) == v2f(12.f,23.f));
+        REQUIRE(v4f(1.f,1.f,5.f,1.f) * t == v4f(11.f,21.f,5.f,1.f));
+    }
+    {
+        const t2f trs{v2f(10.f,20.f), 0.7f, v2f(2.f,3.f)};
+        REQUIRE(math::approximately(
+            math::make_matrix4(math::make_trs_matrix3x2(trs)),
+            math::make_trs_matrix4(trs),
+            0.001f));
+        REQUIRE(math::approximately(
+            math::make_matrix4(math::make_rotation_matrix3x2(make_rad(0.7f))),
+            math::make_rotation_matrix4(make_rad(0.7f), v3f::unit_z())));
+
+        const auto m1 = math::make_trs_matrix3x2(trs);
+        const auto m2 = math::make_trs_matrix3x2(t2f{v2f(-5.f,1.f), -1.3f, v2f(0.5f,4.f)});
+        REQUIRE(math::approximately(
+            math::make_matrix4(m1 * m2),
+            math::make_matrix4(m1) * math::make_matrix4(m2),
+            0.001f));
+    }
+    {
+        const auto m = math::make_trs_matrix3x2(t2f{v2f(10.f,20.f), 0.7f, v2f(2.f,3.f)});
+        const auto inv = math::inversed(m);
+        REQUIRE(inv.second);
+        REQUIRE(math::approximately(m * inv.first, m3x2f::identity(), 0.001f));
+        REQUIRE(math::approximately(inv.first * m, m3x2f::identity(), 0.001f));
+        REQUIRE_FALSE(math::inversed(math::make_scale_matrix3x2(0.f, 1.f)).second);
+    }
+    {
+        const auto m = math::make_trs_matrix3x2(t2f{v2f(10.f,20.f), 0.7f, v2f(2.f,3.f)});
+        const v2f src[3] = {{1.f,2.f}, {-3.f,4.f}, {0.f,0.f}};
+        v2f dst[3];
+        math::transform_points(m, src, dst, 3);
+        for ( std::size_t i = 0; i < 3; ++i ) {
+            REQUIRE(math::approximately(dst[i], src[i] * m, 0.001f));
+        }
+    }
+}
@@ -0,0 +1,100 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_utils.hpp"
+using namespace e2d;
+
+TEST_CASE("linear_arena") {
+    {
+        linear_arena a(64u);
+        REQUIRE(a.stats().capacity == 0u);
+
+        void* p1 = a.allocate(3u, 1u);
+        void* p2 = a.allocate(8u, 8u);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(p2) % 8u == 0u);
+        REQUIRE(static_cast<u8*>(p2) >= static_cast<u8*>(p1) + 3u);
+        REQUIRE(a.stats().chunks == 1u);
+
+        a.deallocate(p2, 8u);
+        REQUIRE(a.allocate(8u, 8u) == p2);
+
+        const linear_arena::marker m = a.mark();
+        a.allocate(100u, 4u);
+        REQUIRE(a.stats().chunks == 2u);
+        REQUIRE(a.stats().used > 100u);
+
+        a.rewind(m);
+        REQUIRE(a.stats().used == m.used);
+        REQUIRE(a.stats().high_water > 100u);
+
+        a.rewind(linear_arena::marker());
+        REQUIRE(a.stats().used == 0u);
+
+        const std::size_t high_water = a.stats().high_water;
+        a.reset();
+        REQUIRE(a.stats().chunks == 1u);
+        REQUIRE(a.stats().capacity >= high_water);
+        REQUIRE(a.stats().high_water == 0u);
+        REQUIRE(a.stats().peak_high_water == high_water);
+    }
+    {
+        linear_arena a(16u);
+        {
+            linear_vector<u32> v{linear_allocator<u32>(a)};
+            for ( u32 i = 0; i < 100u; ++i ) {
+                v.push_back(i);
+            }
+            REQUIRE(v.size() == 100u);
+            REQUIRE(v[42] == 42u);
+            REQUIRE(a.stats().used >= sizeof(u32) * 100u);
+            v.clear();
+            v.shrink_to_fit();
+        }
+        a.rewind(linear_arena::marker());
+        REQUIRE(a.stats().used == 0u);
+    }
+}
+
+TEST_CASE("frame_allocator") {
+    {
+        linear_arena* outer_arena = nullptr;
+        std::size_t outer_used = 0u;
+        {
+            frame_allocator::scope outer;
+            outer_arena = &outer.arena();
+            outer_used = outer_arena->stats().used;
+
+            linear_vector<u64> v1(outer.allocator<u64>());
+            v1.resize(10u, 1u);
+            {
+                frame_allocator::scope inner;
+                REQUIRE(&inner.arena() == outer_arena);
+                linear_vector<u64> v2(inner.allocator<u64>());
+                v2.resize(10u, 2u);
+            }
+            REQUIRE(v1[9] == 1u);
+        }
+        REQUIRE(outer_arena->stats().used == outer_used);
+        REQUIRE(&frame_allocator::thread_arena() == outer_arena);
+    }
+    {
+        const u32 frame = frame_allocator::stats().frame;
+        frame_allocator::next_frame();
+        REQUIRE(frame_allocator::stats().frame == frame + 1u);
+        REQUIRE(frame_allocator::stats().arenas > 0u);
+
+        frame_allocator::thread_arena();
+        REQUIRE(frame_allocator::thread_arena().stats().high_water == 0u);
+        {
+            frame_allocator::scope s;
+            linear_vector<u8> v(s.allocator<u8>());
+            v.resize(1000u);
+        }
+        REQUIRE(frame_allocator::stats().peak_high_water >= 1000u);
+        frame_allocator::next_frame();
+        REQUIRE(frame_allocator::stats().frame_high_water >= 1000u);
+    }
+}
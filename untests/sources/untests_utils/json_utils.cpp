@@ -442,4 +442,41 @@ TEST_CASE("json_utils") {
         REQUIRE(json_utils::try_parse_value(doc["e1"], e1));
         REQUIRE(e1 == image_data_format::rgb_etc1);
     }
+    {
+        buffer data;
+        REQUIRE(json_utils::try_save_binary_json(doc, data));
+        REQUIRE(json_utils::is_binary_json(data));
+
+        rapidjson::Document doc2;
+        REQUIRE(json_utils::try_load_binary_json(doc2, data));
+        REQUIRE(doc2 == doc);
+
+        int i = 0;
+        REQUIRE(json_utils::try_parse_value(doc2["i"], i));
+        REQUIRE(i == 42);
+
+        const str_view text = R"json({ "hello" : "world" })json";
+        REQUIRE_FALSE(json_utils::is_binary_json(buffer(text.data(), text.size())));
+        REQUIRE_FALSE(json_utils::try_load_binary_json(doc2, buffer(text.data(), text.size())));
+
+        // truncated data is rejected and keeps the previous document
+        REQUIRE_FALSE(json_utils::try_load_binary_json(doc2, buffer(data.data(), data.size() - 1u)));
+        REQUIRE(doc2 == doc);
+    }
+    {
+        buffer data;
+        REQUIRE(json_utils::try_save_binary_json(doc, "sprite_asset", data));
+
+        str schema_tag = "none";
+        rapidjson::Document doc2;
+        REQUIRE(json_utils::try_load_binary_json(doc2, schema_tag, data));
+        REQUIRE(doc2 == doc);
+        REQUIRE(schema_tag == "sprite_asset");
+
+        REQUIRE(json_utils::try_save_binary_json(doc, data));
+        REQUIRE(json_utils::try_load_binary_json(doc2, schema_tag, data));
+        REQUIRE(schema_tag.empty());
+
+        REQUIRE_FALSE(json_utils::try_save_binary_json(doc, str(256u, 'a'), data));
+    }
 }
@@ -0,0 +1,45 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_utils.hpp"
+using namespace e2d;
+
+TEST_CASE("pool_allocator") {
+    {
+        pool_allocator a(3u, 2u);
+        REQUIRE(a.block_size() >= sizeof(void*));
+        REQUIRE(a.block_size() % alignof(std::max_align_t) == 0u);
+        REQUIRE(a.stats().chunks == 0u);
+    }
+    {
+        pool_allocator a(16u, 2u);
+
+        void* b1 = a.allocate();
+        void* b2 = a.allocate();
+        REQUIRE(b1 != b2);
+        REQUIRE(a.stats().chunks == 1u);
+        REQUIRE(a.stats().live_blocks == 2u);
+
+        void* b3 = a.allocate();
+        REQUIRE(a.stats().chunks == 2u);
+        REQUIRE(a.stats().peak_blocks == 3u);
+
+        a.deallocate(b2);
+        REQUIRE(a.stats().live_blocks == 2u);
+        REQUIRE(a.allocate() == b2);
+
+        a.deallocate(b1);
+        a.deallocate(b2);
+        a.deallocate(b3);
+        a.deallocate(nullptr);
+
+        const pool_allocator::statistics stats = a.stats();
+        REQUIRE(stats.allocations == 4u);
+        REQUIRE(stats.deallocations == 4u);
+        REQUIRE(stats.live_blocks == 0u);
+        REQUIRE(stats.chunks == 2u);
+    }
+}